@@ -0,0 +1,63 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/atomic/utl_atomic_wait.h"
+
+UTL_NAMESPACE_BEGIN
+namespace atomics {
+namespace parking {
+namespace {
+
+constexpr size_t cache_line = 64;
+constexpr size_t slot_count = 256;
+
+struct alignas(cache_line) slot {
+    uint32_t epoch;
+    uint32_t waiters;
+};
+
+slot table[slot_count] = {};
+
+/**
+ * Fibonacci hashing of the address, the low bits are dropped first since waited values are at
+ * least 4-byte aligned and often share a cache line
+ */
+slot& slot_of(void const* address) noexcept {
+    auto const key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address) >> 2);
+    return table[(key * 0x9E3779B97F4A7C15ull) >> 56];
+}
+
+static_assert(slot_count == 256, "Hash extracts the top 8 bits");
+
+} // namespace
+
+void enter(void const* address) noexcept {
+    atomic_relaxed::fetch_add(&slot_of(address).waiters, 1u);
+    atomic_seq_cst::thread_fence();
+}
+
+void leave(void const* address) noexcept {
+    atomic_release::fetch_sub(&slot_of(address).waiters, 1u);
+}
+
+uint32_t epoch(void const* address) noexcept {
+    return atomic_seq_cst::load(&slot_of(address).epoch);
+}
+
+void park(void const* address, uint32_t epoch) noexcept {
+    (void)__UTL futex::wait(&slot_of(address).epoch, epoch, __UTL tempus::duration::invalid());
+}
+
+bool has_waiters(void const* address) noexcept {
+    atomic_seq_cst::thread_fence();
+    return atomic_relaxed::load(&slot_of(address).waiters) != 0;
+}
+
+void unpark_all(void const* address) noexcept {
+    slot& target = slot_of(address);
+    atomic_seq_cst::fetch_add(&target.epoch, 1u);
+    __UTL futex::notify_all(&target.epoch);
+}
+
+} // namespace parking
+} // namespace atomics
+UTL_NAMESPACE_END
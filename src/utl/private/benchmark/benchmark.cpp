@@ -0,0 +1,298 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/tempus/utl_calibrated_clock.h"
+
+#include <math.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace benchmark {
+namespace {
+
+/**
+ * Registered benchmarks, constant initialized so that registrations from any translation unit
+ * may run first
+ */
+registration* registered = nullptr;
+registration** registered_tail = &registered;
+
+/**
+ * Stop scaling the iteration count past this many iterations per sample
+ */
+constexpr uint64_t max_iterations = uint64_t(1) << 40;
+
+double calibrate() noexcept {
+#if UTL_ARCH_x86_64 || UTL_ARCH_AARCH64
+    // The hardware clock counts at the rate of the calibrated clock's counter
+    return 1e9 / static_cast<double>(tempus::calibrated_clock::frequency());
+#else
+    return 1.0;
+#endif
+}
+
+double sample(function_type function, uint64_t iterations, uint64_t& items) noexcept {
+    state current(iterations);
+    function(current);
+    items = current.items_per_iteration();
+    return static_cast<double>(current.elapsed_ticks()) * details::nanoseconds_per_tick();
+}
+
+void sort(double* first, size_t count) noexcept {
+    for (size_t idx = 1; idx < count; ++idx) {
+        double const value = first[idx];
+        size_t pos = idx;
+        for (; pos != 0 && first[pos - 1] > value; --pos) {
+            first[pos] = first[pos - 1];
+        }
+        first[pos] = value;
+    }
+}
+
+/**
+ * @return the `p` quantile of a sorted, non-empty range, interpolating between closest ranks
+ */
+double quantile(double const* sorted, size_t count, double p) noexcept {
+    double const rank = p * static_cast<double>(count - 1);
+    size_t const lower = static_cast<size_t>(rank);
+    size_t const upper = __UTL numeric::min(lower + 1, count - 1);
+    double const fraction = rank - static_cast<double>(lower);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+void print_header(format style) noexcept {
+    switch (style) {
+    case format::console:
+        printf("%-40s %14s %12s %12s %12s %12s %14s %8s\n", "benchmark", "iterations", "median ns",
+            "mean ns", "p99 ns", "stddev ns", "items/s", "outliers");
+        break;
+    case format::csv:
+        printf("name,iterations,samples,outliers,min_ns,median_ns,mean_ns,stddev_ns,p90_ns,p99_ns,"
+               "max_ns,items_per_second\n");
+        break;
+    case format::json:
+        printf("{\n  \"context\": {\"ns_per_tick\": %.6f},\n  \"benchmarks\": [",
+            details::nanoseconds_per_tick());
+        break;
+    }
+}
+
+void print_result(format style, result const& value, bool first) noexcept {
+    switch (style) {
+    case format::console:
+        printf("%-40s %14llu %12.2f %12.2f %12.2f %12.2f %14.4g %8u\n", value.name,
+            static_cast<unsigned long long>(value.iterations), value.median, value.mean, value.p99,
+            value.stddev, value.items_per_second, value.outliers);
+        break;
+    case format::csv:
+        printf("%s,%llu,%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.6g\n", value.name,
+            static_cast<unsigned long long>(value.iterations), value.samples, value.outliers,
+            value.min, value.median, value.mean, value.stddev, value.p90, value.p99, value.max,
+            value.items_per_second);
+        break;
+    case format::json:
+        printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"samples\": %u, \"outliers\": %u, "
+               "\"min_ns\": %.3f, \"median_ns\": %.3f, \"mean_ns\": %.3f, \"stddev_ns\": %.3f, "
+               "\"p90_ns\": %.3f, \"p99_ns\": %.3f, \"max_ns\": %.3f, \"items_per_second\": %.6g}",
+            first ? "" : ",", value.name, static_cast<unsigned long long>(value.iterations),
+            value.samples, value.outliers, value.min, value.median, value.mean, value.stddev,
+            value.p90, value.p99, value.max, value.items_per_second);
+        break;
+    }
+}
+
+void print_footer(format style) noexcept {
+    if (style == format::json) {
+        printf("\n  ]\n}\n");
+    }
+
+    fflush(stdout);
+}
+
+/**
+ * @return the value of `--key=value` if `argument` is that option, otherwise null
+ */
+char const* option_value(char const* argument, char const* key) noexcept {
+    size_t const length = strlen(key);
+    if (strncmp(argument, key, length) != 0 || argument[length] != '=') {
+        return nullptr;
+    }
+
+    return argument + length + 1;
+}
+
+int usage(char const* program) noexcept {
+    fprintf(stderr,
+        "Usage: %s [--format=console|csv|json] [--filter=<text>] [--repetitions=<n>] "
+        "[--warmup-ms=<n>] [--min-time-ms=<n>] [--outlier-fence=<x>]\n",
+        program);
+    return 1;
+}
+
+} // namespace
+
+namespace details {
+double nanoseconds_per_tick() noexcept {
+    static double const value = calibrate();
+    return value;
+}
+
+#if !UTL_SUPPORTS_GNU_ASM
+void escape(void const volatile*) noexcept {}
+#endif
+} // namespace details
+
+registration::registration(char const* name, function_type function) noexcept
+    : name_(name)
+    , function_(function)
+    , next_(nullptr) {
+    *registered_tail = this;
+    registered_tail = &next_;
+}
+
+registration const* registration::first() noexcept {
+    return registered;
+}
+
+result run(char const* name, function_type function, options const& config) noexcept {
+    result output = {};
+    output.name = name;
+
+    // Warm up while scaling the iteration count, so that caches, branch predictors and the
+    // frequency governor settle on the final configuration
+    uint64_t iterations = 1;
+    uint64_t items = 1;
+    double const target = static_cast<double>(config.min_sample_ns);
+    double warmed = 0;
+    while (true) {
+        double const elapsed = sample(function, iterations, items);
+        warmed += elapsed;
+        if (iterations >= max_iterations) {
+            break;
+        }
+
+        if (elapsed < target) {
+            double const scale = elapsed > 0 ? 1.2 * target / elapsed : 10.0;
+            iterations = __UTL numeric::max(iterations + 1,
+                static_cast<uint64_t>(static_cast<double>(iterations) *
+                    __UTL numeric::min(scale, 10.0)));
+            continue;
+        }
+
+        if (warmed >= static_cast<double>(config.warmup_ns)) {
+            break;
+        }
+    }
+
+    size_t const count = __UTL numeric::max(config.repetitions, uint32_t(1));
+    double* const samples = new (::std::nothrow) double[count];
+    if (samples == nullptr) {
+        return output;
+    }
+
+    for (size_t idx = 0; idx != count; ++idx) {
+        samples[idx] = sample(function, iterations, items) / static_cast<double>(iterations);
+    }
+
+    sort(samples, count);
+    size_t first = 0;
+    size_t last = count;
+    if (config.outlier_fence > 0 && count >= 4) {
+        double const q1 = quantile(samples, count, 0.25);
+        double const q3 = quantile(samples, count, 0.75);
+        double const spread = config.outlier_fence * (q3 - q1);
+        while (first != last && samples[first] < q1 - spread) {
+            ++first;
+        }
+        while (last != first && samples[last - 1] > q3 + spread) {
+            --last;
+        }
+    }
+
+    double const* const kept = samples + first;
+    size_t const retained = last - first;
+    double sum = 0;
+    for (size_t idx = 0; idx != retained; ++idx) {
+        sum += kept[idx];
+    }
+
+    double const mean = sum / static_cast<double>(retained);
+    double squares = 0;
+    for (size_t idx = 0; idx != retained; ++idx) {
+        squares += (kept[idx] - mean) * (kept[idx] - mean);
+    }
+
+    output.iterations = iterations;
+    output.samples = static_cast<uint32_t>(retained);
+    output.outliers = static_cast<uint32_t>(count - retained);
+    output.min = kept[0];
+    output.median = quantile(kept, retained, 0.5);
+    output.mean = mean;
+    output.stddev = retained > 1 ? sqrt(squares / static_cast<double>(retained - 1)) : 0;
+    output.p90 = quantile(kept, retained, 0.9);
+    output.p99 = quantile(kept, retained, 0.99);
+    output.max = kept[retained - 1];
+    output.items_per_second = mean > 0 ? 1e9 * static_cast<double>(items) / mean : 0;
+    delete[] samples;
+    return output;
+}
+
+int run_all(int argc, char** argv) noexcept {
+    options config;
+    format style = format::console;
+    char const* filter = nullptr;
+    for (int idx = 1; idx < argc; ++idx) {
+        char const* const argument = argv[idx];
+        char const* value;
+        if ((value = option_value(argument, "--format")) != nullptr) {
+            if (strcmp(value, "console") == 0) {
+                style = format::console;
+            } else if (strcmp(value, "csv") == 0) {
+                style = format::csv;
+            } else if (strcmp(value, "json") == 0) {
+                style = format::json;
+            } else {
+                return usage(argv[0]);
+            }
+        } else if ((value = option_value(argument, "--filter")) != nullptr) {
+            filter = value;
+        } else if ((value = option_value(argument, "--repetitions")) != nullptr) {
+            config.repetitions = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if ((value = option_value(argument, "--warmup-ms")) != nullptr) {
+            config.warmup_ns = strtoull(value, nullptr, 10) * 1000000;
+        } else if ((value = option_value(argument, "--min-time-ms")) != nullptr) {
+            config.min_sample_ns = strtoull(value, nullptr, 10) * 1000000;
+        } else if ((value = option_value(argument, "--outlier-fence")) != nullptr) {
+            config.outlier_fence = strtod(value, nullptr);
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    print_header(style);
+    bool first = true;
+    for (registration const* current = registration::first(); current != nullptr;
+         current = current->next()) {
+        if (filter != nullptr && strstr(current->name(), filter) == nullptr) {
+            continue;
+        }
+
+        print_result(style, run(current->name(), current->function(), config), first);
+        first = false;
+        fflush(stdout);
+    }
+
+    print_footer(style);
+    return 0;
+}
+
+} // namespace benchmark
+
+UTL_NAMESPACE_END
@@ -0,0 +1,86 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/atomic.h"
+#include "utl/benchmark/utl_benchmark.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t contenders = 4;
+constexpr size_t increments = 1 << 14;
+
+void utl_fetch_add_relaxed(utl::benchmark::state& state) {
+    utl::atomic<uint64_t> counter(0);
+    for (auto _ : state) {
+        counter.fetch_add(1, utl::memory_order_relaxed);
+    }
+    utl::benchmark::do_not_optimize(counter.load());
+}
+
+void utl_fetch_add_seq_cst(utl::benchmark::state& state) {
+    utl::atomic<uint64_t> counter(0);
+    for (auto _ : state) {
+        counter.fetch_add(1);
+    }
+    utl::benchmark::do_not_optimize(counter.load());
+}
+
+void std_fetch_add_seq_cst(utl::benchmark::state& state) {
+    std::atomic<uint64_t> counter(0);
+    for (auto _ : state) {
+        counter.fetch_add(1);
+    }
+    utl::benchmark::do_not_optimize(counter.load());
+}
+
+void utl_compare_exchange_loop(utl::benchmark::state& state) {
+    utl::atomic<uint64_t> counter(0);
+    for (auto _ : state) {
+        uint64_t expected = counter.load(utl::memory_order_relaxed);
+        while (!counter.compare_exchange_weak(expected, expected + 1)) {}
+    }
+    utl::benchmark::do_not_optimize(counter.load());
+}
+
+void utl_load_acquire(utl::benchmark::state& state) {
+    utl::atomic<uint64_t> counter(1);
+    for (auto _ : state) {
+        utl::benchmark::do_not_optimize(counter.load(utl::memory_order_acquire));
+    }
+}
+
+/**
+ * One iteration: every contender performs `increments` increments of a shared counter
+ */
+void utl_fetch_add_contended(utl::benchmark::state& state) {
+    state.set_items_per_iteration(contenders * increments);
+    utl::atomic<uint64_t> counter(0);
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (size_t idx = 0; idx != contenders; ++idx) {
+            threads.emplace_back([&]() {
+                for (size_t count = 0; count != increments; ++count) {
+                    counter.fetch_add(1, utl::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    utl::benchmark::do_not_optimize(counter.load());
+}
+
+} // namespace
+
+UTL_BENCHMARK(utl_fetch_add_relaxed);
+UTL_BENCHMARK(utl_fetch_add_seq_cst);
+UTL_BENCHMARK(std_fetch_add_seq_cst);
+UTL_BENCHMARK(utl_compare_exchange_loop);
+UTL_BENCHMARK(utl_load_acquire);
+UTL_BENCHMARK(utl_fetch_add_contended);
+
+UTL_BENCHMARK_MAIN()
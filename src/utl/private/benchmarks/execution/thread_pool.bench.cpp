@@ -0,0 +1,67 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/execution/utl_thread_pool.h"
+#include "utl/execution/utl_wait_group.h"
+
+#include <vector>
+
+namespace {
+
+constexpr size_t elements = 1 << 20;
+constexpr size_t tasks = 1 << 12;
+
+utl::thread_pool& pool() {
+    static utl::thread_pool instance;
+    return instance;
+}
+
+float kernel(float value) {
+    return value * 1.0001f + 0.5f;
+}
+
+void sequential_for(utl::benchmark::state& state) {
+    std::vector<float> values(elements, 1.0f);
+    state.set_items_per_iteration(elements);
+    for (auto _ : state) {
+        for (auto& value : values) {
+            value = kernel(value);
+        }
+        utl::benchmark::do_not_optimize(values.data());
+    }
+}
+
+void parallel_for(utl::benchmark::state& state) {
+    std::vector<float> values(elements, 1.0f);
+    state.set_items_per_iteration(elements);
+    for (auto _ : state) {
+        pool().parallel_for(0, elements, 4096, [&](size_t first, size_t last) {
+            for (size_t idx = first; idx != last; ++idx) {
+                values[idx] = kernel(values[idx]);
+            }
+        });
+        utl::benchmark::do_not_optimize(values.data());
+    }
+}
+
+/**
+ * One iteration: `tasks` empty tasks submitted from outside the pool and waited for
+ */
+void submit_wait(utl::benchmark::state& state) {
+    state.set_items_per_iteration(tasks);
+    for (auto _ : state) {
+        utl::wait_group group;
+        for (size_t idx = 0; idx != tasks; ++idx) {
+            pool().submit(group, []() {});
+        }
+        pool().wait(group);
+    }
+}
+
+} // namespace
+
+UTL_BENCHMARK(sequential_for);
+UTL_BENCHMARK(parallel_for);
+UTL_BENCHMARK(submit_wait);
+
+UTL_BENCHMARK_MAIN()
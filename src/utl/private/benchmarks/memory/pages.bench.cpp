@@ -0,0 +1,64 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/memory/utl_page_allocator.h"
+
+#include <stdint.h>
+
+namespace {
+
+namespace pages = utl::memory::pages;
+
+/**
+ * Far beyond the reach of the TLB with base pages, within it with 2 MiB pages on most hardware
+ */
+constexpr size_t mapping_bytes = size_t(256) << 20;
+constexpr size_t accesses = 1 << 16;
+
+/**
+ * One iteration: `accesses` dependent loads at pseudo-random cache lines of the mapping, so every
+ * load is likely to miss the TLB unless the mapping uses huge pages
+ */
+void random_access(utl::benchmark::state& state, pages::huge_pages huge) {
+    size_t const granularity = pages::granularity(huge);
+    size_t const bytes = (mapping_bytes + granularity - 1) / granularity * granularity;
+    auto const base = static_cast<uint64_t*>(pages::allocate(bytes, pages::options{huge, -1}));
+    size_t const words = bytes / sizeof(uint64_t);
+    // Fault every base page in before timing
+    for (size_t idx = 0; idx < words; idx += 4096 / sizeof(uint64_t)) {
+        base[idx] = idx;
+    }
+
+    state.set_items_per_iteration(accesses);
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (size_t idx = 0; idx != accesses; ++idx) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull + sum;
+            sum += base[(seed >> 20) % words & ~uint64_t(7)] & 1;
+        }
+        utl::benchmark::do_not_optimize(sum);
+    }
+
+    pages::deallocate(base, bytes);
+}
+
+void base_pages_random_access(utl::benchmark::state& state) {
+    random_access(state, pages::huge_pages::none);
+}
+
+void transparent_huge_pages_random_access(utl::benchmark::state& state) {
+    random_access(state, pages::huge_pages::transparent);
+}
+
+void reserved_huge_pages_random_access(utl::benchmark::state& state) {
+    random_access(state, pages::huge_pages::reserved);
+}
+
+} // namespace
+
+UTL_BENCHMARK(base_pages_random_access);
+UTL_BENCHMARK(transparent_huge_pages_random_access);
+UTL_BENCHMARK(reserved_huge_pages_random_access);
+
+UTL_BENCHMARK_MAIN()
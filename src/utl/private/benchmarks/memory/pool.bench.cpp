@@ -0,0 +1,84 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/memory/utl_pool_allocator.h"
+
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct block {
+    unsigned char bytes[64];
+};
+
+constexpr size_t threads = 4;
+constexpr size_t batch = 256;
+
+void pool_allocate_deallocate(utl::benchmark::state& state) {
+    utl::pool_allocator<block> alloc;
+    for (auto _ : state) {
+        block* const ptr = alloc.allocate(1);
+        utl::benchmark::do_not_optimize(ptr);
+        alloc.deallocate(ptr, 1);
+    }
+}
+
+void new_delete(utl::benchmark::state& state) {
+    for (auto _ : state) {
+        block* const ptr = new block;
+        utl::benchmark::do_not_optimize(ptr);
+        delete ptr;
+    }
+}
+
+/**
+ * One iteration: every thread allocates a batch, frees it in reverse and repeats, so that blocks
+ * cycle through the thread caches and the central lists
+ */
+template <typename Allocate, typename Deallocate>
+void churn(utl::benchmark::state& state, Allocate allocate, Deallocate deallocate) {
+    constexpr size_t rounds = 64;
+    state.set_items_per_iteration(threads * rounds * batch);
+    for (auto _ : state) {
+        std::vector<std::thread> workers;
+        for (size_t idx = 0; idx != threads; ++idx) {
+            workers.emplace_back([&]() {
+                block* blocks[batch];
+                for (size_t round = 0; round != rounds; ++round) {
+                    for (auto& ptr : blocks) {
+                        ptr = allocate();
+                    }
+                    utl::benchmark::clobber_memory();
+                    for (size_t pos = batch; pos != 0; --pos) {
+                        deallocate(blocks[pos - 1]);
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+}
+
+void pool_multithreaded(utl::benchmark::state& state) {
+    churn(
+        state, []() { return utl::pool_allocator<block>().allocate(1); },
+        [](block* ptr) { utl::pool_allocator<block>().deallocate(ptr, 1); });
+}
+
+void new_delete_multithreaded(utl::benchmark::state& state) {
+    churn(
+        state, []() { return new block; }, [](block* ptr) { delete ptr; });
+}
+
+} // namespace
+
+UTL_BENCHMARK(pool_allocate_deallocate);
+UTL_BENCHMARK(new_delete);
+UTL_BENCHMARK(pool_multithreaded);
+UTL_BENCHMARK(new_delete_multithreaded);
+
+UTL_BENCHMARK_MAIN()
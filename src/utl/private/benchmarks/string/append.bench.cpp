@@ -0,0 +1,82 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/memory/utl_allocator.h"
+#include "utl/string/utl_basic_short_string.h"
+#include "utl/string/utl_char_traits.h"
+#include "utl/string/utl_string_growth.h"
+
+#include <string>
+
+namespace {
+
+template <typename Growth>
+using string_with = utl::basic_short_string<char, 23, utl::char_traits<char>, utl::allocator<char>,
+    Growth>;
+
+constexpr size_t appended = 4096;
+constexpr char chunk[] = "0123456789abcdef";
+
+template <typename String>
+void append_char(utl::benchmark::state& state) {
+    state.set_items_per_iteration(appended);
+    for (auto _ : state) {
+        String value;
+        for (size_t idx = 0; idx != appended; ++idx) {
+            value.push_back(static_cast<char>('a' + (idx & 15)));
+        }
+        utl::benchmark::do_not_optimize(value.data());
+    }
+}
+
+template <typename String>
+void append_chunk(utl::benchmark::state& state) {
+    state.set_items_per_iteration(appended / 16);
+    for (auto _ : state) {
+        String value;
+        for (size_t idx = 0; idx != appended / 16; ++idx) {
+            value.append(chunk, 16);
+        }
+        utl::benchmark::do_not_optimize(value.data());
+    }
+}
+
+void utl_string_push_back(utl::benchmark::state& state) {
+    append_char<utl::string>(state);
+}
+
+void utl_string_push_back_exact(utl::benchmark::state& state) {
+    append_char<string_with<utl::string_growth::exact>>(state);
+}
+
+void utl_string_push_back_one_and_a_half(utl::benchmark::state& state) {
+    append_char<string_with<utl::string_growth::one_and_a_half>>(state);
+}
+
+void utl_string_push_back_size_class(utl::benchmark::state& state) {
+    append_char<string_with<utl::string_growth::size_class<>>>(state);
+}
+
+void std_string_push_back(utl::benchmark::state& state) {
+    append_char<std::string>(state);
+}
+
+void utl_string_append(utl::benchmark::state& state) {
+    append_chunk<utl::string>(state);
+}
+
+void std_string_append(utl::benchmark::state& state) {
+    append_chunk<std::string>(state);
+}
+
+} // namespace
+
+UTL_BENCHMARK(utl_string_push_back);
+UTL_BENCHMARK(utl_string_push_back_exact);
+UTL_BENCHMARK(utl_string_push_back_one_and_a_half);
+UTL_BENCHMARK(utl_string_push_back_size_class);
+UTL_BENCHMARK(std_string_push_back);
+UTL_BENCHMARK(utl_string_append);
+UTL_BENCHMARK(std_string_append);
+
+UTL_BENCHMARK_MAIN()
@@ -0,0 +1,77 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/sync/utl_mutex.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t contenders = 4;
+constexpr size_t acquisitions = 1 << 12;
+
+template <typename Mutex>
+void uncontended(utl::benchmark::state& state) {
+    Mutex lock;
+    uint64_t counter = 0;
+    for (auto _ : state) {
+        lock.lock();
+        ++counter;
+        lock.unlock();
+    }
+    utl::benchmark::do_not_optimize(counter);
+}
+
+/**
+ * One iteration: every contender locks the mutex `acquisitions` times around a short critical
+ * section
+ */
+template <typename Mutex>
+void contended(utl::benchmark::state& state) {
+    state.set_items_per_iteration(contenders * acquisitions);
+    Mutex lock;
+    uint64_t counter = 0;
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (size_t idx = 0; idx != contenders; ++idx) {
+            threads.emplace_back([&]() {
+                for (size_t count = 0; count != acquisitions; ++count) {
+                    lock.lock();
+                    ++counter;
+                    lock.unlock();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    utl::benchmark::do_not_optimize(counter);
+}
+
+void utl_mutex_uncontended(utl::benchmark::state& state) {
+    uncontended<utl::mutex>(state);
+}
+
+void std_mutex_uncontended(utl::benchmark::state& state) {
+    uncontended<std::mutex>(state);
+}
+
+void utl_mutex_contended(utl::benchmark::state& state) {
+    contended<utl::mutex>(state);
+}
+
+void std_mutex_contended(utl::benchmark::state& state) {
+    contended<std::mutex>(state);
+}
+
+} // namespace
+
+UTL_BENCHMARK(utl_mutex_uncontended);
+UTL_BENCHMARK(std_mutex_uncontended);
+UTL_BENCHMARK(utl_mutex_contended);
+UTL_BENCHMARK(std_mutex_contended);
+
+UTL_BENCHMARK_MAIN()
@@ -0,0 +1,108 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/sync/utl_mpmc_ring.h"
+#include "utl/sync/utl_spsc_ring.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t transfers = 1 << 16;
+constexpr size_t batch = 32;
+
+/**
+ * One iteration: a producer thread moves `transfers` values to the calling thread
+ */
+void spsc_single(utl::benchmark::state& state) {
+    state.set_items_per_iteration(transfers);
+    auto const ring = new utl::spsc_ring<size_t, 1024>;
+    for (auto _ : state) {
+        std::thread producer([&]() {
+            for (size_t idx = 0; idx != transfers;) {
+                idx += ring->try_push(idx);
+            }
+        });
+        size_t sum = 0;
+        for (size_t idx = 0; idx != transfers;) {
+            size_t value;
+            if (ring->try_pop(value)) {
+                sum += value;
+                ++idx;
+            }
+        }
+        producer.join();
+        utl::benchmark::do_not_optimize(sum);
+    }
+    delete ring;
+}
+
+void spsc_batch(utl::benchmark::state& state) {
+    state.set_items_per_iteration(transfers);
+    auto const ring = new utl::spsc_ring<size_t, 1024>;
+    for (auto _ : state) {
+        std::thread producer([&]() {
+            size_t values[batch];
+            for (size_t idx = 0; idx != transfers;) {
+                for (size_t pos = 0; pos != batch; ++pos) {
+                    values[pos] = idx + pos;
+                }
+                idx += ring->try_push_n(values, batch);
+            }
+        });
+        size_t sum = 0;
+        size_t values[batch];
+        for (size_t idx = 0; idx != transfers;) {
+            size_t const popped = ring->try_pop_n(values, batch);
+            for (size_t pos = 0; pos != popped; ++pos) {
+                sum += values[pos];
+            }
+            idx += popped;
+        }
+        producer.join();
+        utl::benchmark::do_not_optimize(sum);
+    }
+    delete ring;
+}
+
+/**
+ * One iteration: two producers and two consumers move `transfers` values through the ring
+ */
+void mpmc_two_by_two(utl::benchmark::state& state) {
+    constexpr size_t sides = 2;
+    state.set_items_per_iteration(transfers);
+    utl::mpmc_ring<size_t> ring(1024);
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (size_t side = 0; side != sides; ++side) {
+            threads.emplace_back([&]() {
+                for (size_t idx = 0; idx != transfers / sides;) {
+                    idx += ring.try_push(idx);
+                }
+            });
+            threads.emplace_back([&]() {
+                size_t sum = 0;
+                for (size_t idx = 0; idx != transfers / sides;) {
+                    size_t value;
+                    if (ring.try_pop(value)) {
+                        sum += value;
+                        ++idx;
+                    }
+                }
+                utl::benchmark::do_not_optimize(sum);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+} // namespace
+
+UTL_BENCHMARK(spsc_single);
+UTL_BENCHMARK(spsc_batch);
+UTL_BENCHMARK(mpmc_two_by_two);
+
+UTL_BENCHMARK_MAIN()
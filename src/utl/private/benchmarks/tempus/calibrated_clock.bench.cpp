@@ -0,0 +1,27 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/tempus/utl_calibrated_clock.h"
+#include "utl/tempus/utl_clock.h"
+
+namespace {
+
+void calibrated_now(utl::benchmark::state& state) {
+    utl::tempus::calibrated_clock::calibrate();
+    for (auto _ : state) {
+        utl::benchmark::do_not_optimize(utl::tempus::calibrated_clock::now_ns());
+    }
+}
+
+void steady_now(utl::benchmark::state& state) {
+    for (auto _ : state) {
+        utl::benchmark::do_not_optimize(get_time(utl::tempus::steady_clock));
+    }
+}
+
+} // namespace
+
+UTL_BENCHMARK(calibrated_now);
+UTL_BENCHMARK(steady_now);
+
+UTL_BENCHMARK_MAIN()
@@ -0,0 +1,28 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/tempus/utl_coarse_clock.h"
+
+namespace {
+
+void coarse_now(utl::benchmark::state& state) {
+    (void)utl::tempus::coarse_clock_t::start();
+    for (auto _ : state) {
+        utl::benchmark::do_not_optimize(get_time(utl::tempus::coarse_clock));
+    }
+
+    utl::tempus::coarse_clock_t::stop();
+}
+
+void coarse_now_stopped(utl::benchmark::state& state) {
+    for (auto _ : state) {
+        utl::benchmark::do_not_optimize(get_time(utl::tempus::coarse_clock));
+    }
+}
+
+} // namespace
+
+UTL_BENCHMARK(coarse_now);
+UTL_BENCHMARK(coarse_now_stopped);
+
+UTL_BENCHMARK_MAIN()
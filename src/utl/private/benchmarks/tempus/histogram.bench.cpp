@@ -0,0 +1,39 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/tempus/utl_histogram.h"
+
+namespace {
+
+void histogram_record(utl::benchmark::state& state) {
+    utl::tempus::histogram latencies;
+    utl::tempus::histogram::recorder recorder(latencies);
+    uint64_t value = 0x9E3779B97F4A7C15ull;
+    for (auto _ : state) {
+        // Spread the values over the buckets
+        value ^= value << 13;
+        value ^= value >> 7;
+        value ^= value << 17;
+        recorder.record(value >> 40);
+    }
+    utl::benchmark::do_not_optimize(latencies.read().count());
+}
+
+void histogram_read(utl::benchmark::state& state) {
+    utl::tempus::histogram latencies;
+    utl::tempus::histogram::recorder recorder(latencies);
+    for (uint64_t value = 1; value < (uint64_t(1) << 40); value *= 3) {
+        recorder.record(value);
+    }
+
+    for (auto _ : state) {
+        utl::benchmark::do_not_optimize(latencies.read().p99());
+    }
+}
+
+} // namespace
+
+UTL_BENCHMARK(histogram_record);
+UTL_BENCHMARK(histogram_read);
+
+UTL_BENCHMARK_MAIN()
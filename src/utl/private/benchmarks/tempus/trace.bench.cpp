@@ -0,0 +1,52 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/tempus/utl_trace.h"
+
+namespace {
+
+/**
+ * Probes per iteration, fewer than a thread buffer holds so that every probe is recorded
+ */
+constexpr size_t probes = 1024;
+
+void probes_stopped(utl::benchmark::state& state) {
+    state.set_items_per_iteration(probes);
+    for (auto _ : state) {
+        for (size_t idx = 0; idx != probes; ++idx) {
+            UTL_TRACE_SCOPE("probe");
+            utl::benchmark::clobber_memory();
+        }
+    }
+}
+
+/**
+ * One iteration records `probes` events, the buffer is drained outside of the timed region
+ */
+void probes_started(utl::benchmark::state& state) {
+    state.set_items_per_iteration(probes);
+    utl::tempus::trace::options config;
+    config.drain_interval_ns = 0;
+    config.max_events = 1 << 12;
+    (void)utl::tempus::trace::start(config);
+    for (auto _ : state) {
+        for (size_t idx = 0; idx != probes; ++idx) {
+            UTL_TRACE_SCOPE("probe");
+            utl::benchmark::clobber_memory();
+        }
+
+        state.pause_timing();
+        utl::tempus::trace::drain();
+        state.resume_timing();
+    }
+
+    utl::tempus::trace::stop();
+    utl::tempus::trace::clear();
+}
+
+} // namespace
+
+UTL_BENCHMARK(probes_stopped);
+UTL_BENCHMARK(probes_started);
+
+UTL_BENCHMARK_MAIN()
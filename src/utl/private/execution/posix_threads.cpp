@@ -0,0 +1,53 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "execution/threads.h"
+
+#if !UTL_TARGET_MICROSOFT
+
+#  include <pthread.h>
+#  include <string.h>
+#  include <unistd.h>
+
+UTL_NAMESPACE_BEGIN
+namespace execution {
+namespace threads {
+namespace {
+
+static_assert(sizeof(pthread_t) <= sizeof(handle), "Handle cannot hold a pthread_t");
+
+void* trampoline(void* argument) noexcept {
+    launch const& info = *static_cast<launch const*>(argument);
+    info.entry(info.argument);
+    return nullptr;
+}
+
+} // namespace
+
+int start(handle& result, launch const& info) noexcept {
+    pthread_t thread;
+    int const error =
+        ::pthread_create(&thread, nullptr, &trampoline, const_cast<launch*>(&info));
+    if (error == 0) {
+        result = 0;
+        ::memcpy(&result, &thread, sizeof(thread));
+    }
+
+    return error;
+}
+
+void join(handle thread) noexcept {
+    pthread_t native;
+    ::memcpy(&native, &thread, sizeof(native));
+    (void)::pthread_join(native, nullptr);
+}
+
+size_t hardware_concurrency() noexcept {
+    long const count = ::sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? static_cast<size_t>(count) : 1;
+}
+
+} // namespace threads
+} // namespace execution
+UTL_NAMESPACE_END
+
+#endif // !UTL_TARGET_MICROSOFT
@@ -0,0 +1,285 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/execution/utl_thread_pool.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/exception.h"
+#include "utl/sync/utl_backoff.h"
+#include "utl/sync/utl_event_count.h"
+#include "utl/sync/utl_mutex.h"
+
+#include "execution/threads.h"
+#include "execution/work_deque.h"
+
+#include <new>
+
+UTL_NAMESPACE_BEGIN
+namespace execution {
+namespace details {
+
+struct pool_state {
+    struct worker {
+        work_deque tasks;
+        pool_state* pool;
+        uint64_t seed;
+        execution::threads::launch launch;
+        execution::threads::handle thread;
+    };
+
+    explicit pool_state(size_t size) UTL_THROWS;
+    ~pool_state() noexcept;
+
+    task* find(worker* self) noexcept;
+    task* steal(uint64_t& seed, worker const* self) noexcept;
+    task* dequeue() noexcept;
+    void enqueue(task* item) noexcept;
+    bool has_work() const noexcept;
+    void run(worker& self) noexcept;
+    void shutdown() noexcept;
+
+    worker* workers;
+    size_t count;
+    /**
+     * Number of workers whose thread is running
+     */
+    size_t started;
+    /**
+     * Tasks submitted from outside the pool, first-in first-out
+     */
+    mutex lock;
+    task* head;
+    task* tail;
+    size_t injected;
+    /**
+     * Idle workers park here
+     */
+    event_count idle;
+    uint32_t stopping;
+};
+
+namespace {
+
+thread_local pool_state::worker* current_worker = nullptr;
+thread_local uint64_t external_seed = 0x9E3779B97F4A7C15ull;
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t next_random(uint64_t& seed) noexcept {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+} // namespace
+
+pool_state::pool_state(size_t size) UTL_THROWS
+    : workers(static_cast<worker*>(
+          ::operator new(size * sizeof(worker), std::align_val_t(alignof(worker)))))
+    , count(0)
+    , started(0)
+    , head(nullptr)
+    , tail(nullptr)
+    , injected(0)
+    , stopping(0) {
+    UTL_TRY {
+        // Every worker exists before the first thread starts looking for deques to steal from
+        for (; count != size; ++count) {
+            worker* const self = ::new (static_cast<void*>(workers + count)) worker{};
+            self->pool = this;
+            self->seed = 0x9E3779B97F4A7C15ull * (count + 1);
+            self->launch = {[](void* argument) noexcept {
+                                auto const self = static_cast<worker*>(argument);
+                                self->pool->run(*self);
+                            },
+                self};
+        }
+
+        for (; started != count; ++started) {
+            worker& self = workers[started];
+            int const error = execution::threads::start(self.thread, self.launch);
+            UTL_THROW_IF(error != 0,
+                program_exception(
+                    UTL_MESSAGE_FORMAT("[UTL] thread_pool::thread_pool operation failed, "
+                                       "Reason=[thread creation failed], error=[%d]"),
+                    error));
+        }
+    } UTL_CATCH(...) {
+        shutdown();
+        UTL_RETHROW();
+    }
+}
+
+pool_state::~pool_state() noexcept {
+    shutdown();
+}
+
+void pool_state::shutdown() noexcept {
+    atomic_release::store(&stopping, uint32_t(1));
+    idle.notify_all();
+    for (size_t idx = 0; idx != started; ++idx) {
+        execution::threads::join(workers[idx].thread);
+    }
+
+    for (size_t idx = 0; idx != count; ++idx) {
+        workers[idx].~worker();
+    }
+
+    ::operator delete(workers, std::align_val_t(alignof(worker)));
+}
+
+task* pool_state::dequeue() noexcept {
+    if (atomic_relaxed::load(&injected) == 0) {
+        return nullptr;
+    }
+
+    lock.lock();
+    task* const item = head;
+    if (item != nullptr) {
+        head = item->next;
+        if (head == nullptr) {
+            tail = nullptr;
+        }
+        atomic_relaxed::store(&injected, injected - 1);
+    }
+    lock.unlock();
+    return item;
+}
+
+void pool_state::enqueue(task* item) noexcept {
+    item->next = nullptr;
+    lock.lock();
+    if (tail != nullptr) {
+        tail->next = item;
+    } else {
+        head = item;
+    }
+    tail = item;
+    atomic_relaxed::store(&injected, injected + 1);
+    lock.unlock();
+}
+
+task* pool_state::steal(uint64_t& seed, worker const* self) noexcept {
+    // Two passes starting at a random victim, so every deque is tried even if a steal loses a race
+    size_t const start = static_cast<size_t>(next_random(seed) % count);
+    for (size_t attempt = 0; attempt != 2 * count; ++attempt) {
+        worker& victim = workers[(start + attempt) % count];
+        if (&victim == self) {
+            continue;
+        }
+
+        task* const item = victim.tasks.steal();
+        if (item != nullptr) {
+            return item;
+        }
+    }
+
+    return nullptr;
+}
+
+task* pool_state::find(worker* self) noexcept {
+    if (self != nullptr) {
+        if (task* const item = self->tasks.pop()) {
+            return item;
+        }
+    }
+
+    if (task* const item = dequeue()) {
+        return item;
+    }
+
+    return steal(self != nullptr ? self->seed : external_seed, self);
+}
+
+bool pool_state::has_work() const noexcept {
+    if (atomic_relaxed::load(&injected) != 0) {
+        return true;
+    }
+
+    for (size_t idx = 0; idx != count; ++idx) {
+        if (!workers[idx].tasks.empty()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void pool_state::run(worker& self) noexcept {
+    current_worker = &self;
+    task* item = nullptr;
+    auto const found = [&]() { return (item = find(&self)) != nullptr; };
+    while (true) {
+        if (found() || sync::details::spin_until(found)) {
+            item->run(item);
+            continue;
+        }
+
+        uint32_t const key = idle.prepare_wait();
+        if (has_work()) {
+            idle.cancel_wait();
+            continue;
+        }
+
+        if (atomic_acquire::load(&stopping) != 0) {
+            idle.cancel_wait();
+            break;
+        }
+
+        idle.wait(key);
+    }
+
+    current_worker = nullptr;
+}
+
+} // namespace details
+} // namespace execution
+
+using execution::details::current_worker;
+using execution::details::pool_state;
+using execution::details::task;
+
+thread_pool::thread_pool(size_t workers) UTL_THROWS
+    : state_(new pool_state(
+          workers != 0 ? workers : execution::threads::hardware_concurrency())) {}
+
+thread_pool::~thread_pool() noexcept {
+    delete state_;
+}
+
+size_t thread_pool::size() const noexcept {
+    return state_->count;
+}
+
+void thread_pool::schedule(task* item) noexcept {
+    pool_state::worker* const self = current_worker;
+    // The shared queue is intrusive and never allocates, it takes the task if the deque cannot grow
+    if (self == nullptr || self->pool != state_ || !self->tasks.push(item)) {
+        state_->enqueue(item);
+    }
+
+    state_->idle.notify_one();
+}
+
+void thread_pool::wait(wait_group& group) noexcept {
+    pool_state::worker* self = current_worker;
+    if (self != nullptr && self->pool != state_) {
+        self = nullptr;
+    }
+
+    task* item = nullptr;
+    auto const ready = [&]() {
+        return group.try_wait() || (item = state_->find(self)) != nullptr;
+    };
+    while (sync::details::spin_until(ready)) {
+        if (item == nullptr) {
+            return;
+        }
+
+        item->run(item);
+        item = nullptr;
+    }
+
+    // Nothing is queued, the remaining tasks of the group are running on other threads
+    group.wait();
+}
+
+UTL_NAMESPACE_END
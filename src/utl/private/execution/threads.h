@@ -0,0 +1,46 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+namespace execution {
+namespace threads {
+
+/**
+ * Entry point of a thread, must outlive the start of the thread
+ */
+struct launch {
+    void (*entry)(void*) noexcept;
+    void* argument;
+};
+
+/**
+ * Native thread handle, large enough for the handle of every supported platform
+ */
+using handle = uintptr_t;
+
+/**
+ * Starts a thread running `info.entry(info.argument)`
+ *
+ * @return zero on success, otherwise the platform error code
+ */
+int start(handle& result, launch const& info) noexcept;
+
+/**
+ * Waits for the thread to finish and releases its handle
+ */
+void join(handle thread) noexcept;
+
+/**
+ * @return number of hardware threads available to the process, at least 1
+ */
+size_t hardware_concurrency() noexcept;
+
+} // namespace threads
+} // namespace execution
+UTL_NAMESPACE_END
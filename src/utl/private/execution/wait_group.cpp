@@ -0,0 +1,38 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/execution/utl_wait_group.h"
+
+#include "utl/atomic/utl_futex.h"
+#include "utl/sync/utl_backoff.h"
+#include "utl/tempus/utl_duration.h"
+
+UTL_NAMESPACE_BEGIN
+
+void wait_group::wait_contended() noexcept {
+    if (sync::details::spin_until([this]() { return try_wait(); })) {
+        return;
+    }
+
+    while (true) {
+        uint32_t current = atomic_acquire::load(&state_);
+        if ((current & count_mask) == 0) {
+            return;
+        }
+
+        if ((current & waiting) == 0) {
+            if (!atomic_relaxed::compare_exchange_weak(
+                    &state_, &current, current | waiting, atomics::relaxed_failure)) {
+                continue;
+            }
+            current |= waiting;
+        }
+
+        (void)__UTL futex::wait(&state_, current, __UTL tempus::duration::invalid());
+    }
+}
+
+void wait_group::wake() noexcept {
+    __UTL futex::notify_all(&state_);
+}
+
+UTL_NAMESPACE_END
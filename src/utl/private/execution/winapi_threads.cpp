@@ -0,0 +1,62 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "execution/threads.h"
+
+#if UTL_TARGET_MICROSOFT
+
+#  define NOMINMAX
+#  define NODRAWTEXT
+#  define NOGDI
+#  define NOBITMAP
+#  define NOMCX
+#  define NOSERVICE
+#  define NOHELP
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+
+#  include <Windows.h>
+#  include <processthreadsapi.h>
+#  include <sysinfoapi.h>
+
+UTL_NAMESPACE_BEGIN
+namespace execution {
+namespace threads {
+namespace {
+
+DWORD WINAPI trampoline(LPVOID argument) noexcept {
+    launch const& info = *static_cast<launch const*>(argument);
+    info.entry(info.argument);
+    return 0;
+}
+
+} // namespace
+
+int start(handle& result, launch const& info) noexcept {
+    HANDLE const thread =
+        CreateThread(nullptr, 0, &trampoline, const_cast<launch*>(&info), 0, nullptr);
+    if (thread == nullptr) {
+        return static_cast<int>(GetLastError());
+    }
+
+    result = reinterpret_cast<handle>(thread);
+    return 0;
+}
+
+void join(handle thread) noexcept {
+    HANDLE const native = reinterpret_cast<HANDLE>(thread);
+    WaitForSingleObject(native, INFINITE);
+    CloseHandle(native);
+}
+
+size_t hardware_concurrency() noexcept {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? static_cast<size_t>(info.dwNumberOfProcessors) : 1;
+}
+
+} // namespace threads
+} // namespace execution
+UTL_NAMESPACE_END
+
+#endif // UTL_TARGET_MICROSOFT
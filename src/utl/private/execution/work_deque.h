@@ -0,0 +1,172 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/execution/utl_thread_pool.h"
+
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+namespace execution {
+namespace details {
+
+/**
+ * Chase-Lev work-stealing deque of tasks
+ *
+ * The owning worker pushes and pops at the bottom, other threads steal from the top; only a pop
+ * racing a steal for the last task needs a compare-and-swap. The memory orders follow Lê et al.,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models". The buffer doubles when full; a
+ * replaced buffer may still be read by a thief, so it is kept until the deque is destroyed. Growing
+ * does not throw, a push fails instead if the larger buffer cannot be allocated.
+ */
+class work_deque {
+    struct buffer {
+        intptr_t mask;
+        buffer* previous;
+        task* slots[1];
+
+        UTL_ATTRIBUTES(NODISCARD, ALWAYS_INLINE) inline task*& at(intptr_t idx) noexcept {
+            return slots[idx & mask];
+        }
+    };
+
+public:
+    static constexpr intptr_t initial_capacity = 256;
+    static constexpr size_t cache_line = 64;
+
+    inline work_deque() UTL_THROWS
+        : top_(0)
+        , bottom_(0)
+        , buffer_(make(::operator new(bytes(initial_capacity)), initial_capacity, nullptr)) {}
+    work_deque(work_deque const&) = delete;
+    work_deque& operator=(work_deque const&) = delete;
+
+    inline ~work_deque() noexcept {
+        for (buffer* current = buffer_; current != nullptr;) {
+            buffer* const previous = current->previous;
+            ::operator delete(current);
+            current = previous;
+        }
+    }
+
+    /**
+     * Owner only
+     *
+     * @return false if the deque is full and could not grow
+     */
+    UTL_ATTRIBUTES(NODISCARD) inline bool push(task* item) noexcept {
+        intptr_t const bottom = atomic_relaxed::load(&bottom_);
+        intptr_t const top = atomic_acquire::load(&top_);
+        buffer* current = atomic_relaxed::load(&buffer_);
+        if (bottom - top > current->mask) {
+            current = grow(current, top, bottom);
+            if (current == nullptr) {
+                return false;
+            }
+        }
+
+        atomic_relaxed::store(&current->at(bottom), item);
+        atomic_release::store(&bottom_, bottom + 1);
+        return true;
+    }
+
+    /**
+     * Owner only
+     *
+     * @return the most recently pushed task, or null if the deque is empty
+     */
+    inline task* pop() noexcept {
+        intptr_t const bottom = atomic_relaxed::load(&bottom_) - 1;
+        buffer* const current = atomic_relaxed::load(&buffer_);
+        atomic_relaxed::store(&bottom_, bottom);
+        atomic_seq_cst::thread_fence();
+        intptr_t top = atomic_relaxed::load(&top_);
+        if (top > bottom) {
+            atomic_relaxed::store(&bottom_, bottom + 1);
+            return nullptr;
+        }
+
+        task* item = atomic_relaxed::load(&current->at(bottom));
+        if (top == bottom) {
+            // Last task, a thief may be taking it at the same time
+            if (!atomic_seq_cst::compare_exchange_strong(
+                    &top_, &top, top + 1, atomics::relaxed_failure)) {
+                item = nullptr;
+            }
+            atomic_relaxed::store(&bottom_, bottom + 1);
+        }
+
+        return item;
+    }
+
+    /**
+     * @return the least recently pushed task, or null if the deque is empty or another thread
+     * took the task first
+     */
+    inline task* steal() noexcept {
+        intptr_t top = atomic_acquire::load(&top_);
+        atomic_seq_cst::thread_fence();
+        intptr_t const bottom = atomic_acquire::load(&bottom_);
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        buffer* const current = atomic_acquire::load(&buffer_);
+        task* const item = atomic_relaxed::load(&current->at(top));
+        if (!atomic_seq_cst::compare_exchange_strong(
+                &top_, &top, top + 1, atomics::relaxed_failure)) {
+            return nullptr;
+        }
+
+        return item;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD) inline bool empty() const noexcept {
+        intptr_t const top = atomic_acquire::load(&top_);
+        return atomic_acquire::load(&bottom_) <= top;
+    }
+
+private:
+    static inline size_t bytes(intptr_t capacity) noexcept {
+        return sizeof(buffer) + (capacity - 1) * sizeof(task*);
+    }
+
+    static inline buffer* make(void* memory, intptr_t capacity, buffer* previous) noexcept {
+        buffer* const result = static_cast<buffer*>(memory);
+        result->mask = capacity - 1;
+        result->previous = previous;
+        return result;
+    }
+
+    /**
+     * @return the new buffer, or null if it could not be allocated
+     */
+    inline buffer* grow(buffer* current, intptr_t top, intptr_t bottom) noexcept {
+        intptr_t const capacity = (current->mask + 1) * 2;
+        void* const memory = ::operator new(bytes(capacity), std::nothrow);
+        if (memory == nullptr) {
+            return nullptr;
+        }
+
+        buffer* const result = make(memory, capacity, current);
+        for (intptr_t idx = top; idx != bottom; ++idx) {
+            result->at(idx) = atomic_relaxed::load(&current->at(idx));
+        }
+
+        atomic_release::store(&buffer_, result);
+        return result;
+    }
+
+    alignas(cache_line) intptr_t top_;
+    alignas(cache_line) intptr_t bottom_;
+    buffer* buffer_;
+};
+
+} // namespace details
+} // namespace execution
+UTL_NAMESPACE_END
@@ -0,0 +1,29 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/hash/utl_hash_accelerated.h"
+#include "utl/hash/utl_wyhash.h"
+
+#if !UTL_ARCH_x86_64
+
+UTL_NAMESPACE_BEGIN
+namespace hashing {
+namespace accelerated {
+
+uint64_t hash(void const* data, size_t bytes, uint64_t seed) noexcept {
+    return hashing::wyhash_bytes(data, bytes, seed);
+}
+
+uint64_t aes(void const* data, size_t bytes, uint64_t seed) noexcept {
+    return hashing::wyhash_bytes(data, bytes, seed);
+}
+
+uint64_t crc32c(void const* data, size_t bytes, uint64_t seed) noexcept {
+    return hashing::wyhash_bytes(data, bytes, seed);
+}
+
+} // namespace accelerated
+} // namespace hashing
+
+UTL_NAMESPACE_END
+
+#endif // !UTL_ARCH_x86_64
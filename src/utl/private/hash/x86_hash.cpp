@@ -0,0 +1,179 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/hardware/x86/utl_cpuid.h"
+#include "utl/hash/utl_hash_accelerated.h"
+#include "utl/hash/utl_wyhash.h"
+
+#if UTL_ARCH_x86_64
+
+#  include <immintrin.h>
+#  include <stdint.h>
+
+#  if UTL_COMPILER_GNU_BASED
+#    define __UTL_TARGET_AES __attribute__((target("aes,sse2")))
+#    define __UTL_TARGET_SSE42 __attribute__((target("sse4.2")))
+#  else
+#    define __UTL_TARGET_AES
+#    define __UTL_TARGET_SSE42
+#  endif
+
+UTL_NAMESPACE_BEGIN
+namespace hashing {
+namespace accelerated {
+namespace {
+
+using details::hashing::mix;
+using details::hashing::runtime_reader;
+using details::hashing::secret;
+
+template <unsigned int X, unsigned int S = 0>
+x86::cpuid_t cached_cpuid() noexcept {
+    static x86::cpuid_t const value = x86::cpuid<X, S>();
+    return value;
+}
+
+bool supports_sse42() noexcept {
+    static bool const value = (cached_cpuid<1>().ecx & (1u << 20)) != 0;
+    return value;
+}
+
+bool supports_aes() noexcept {
+    static bool const value = (cached_cpuid<1>().ecx & (1u << 25)) != 0;
+    return value;
+}
+
+/**
+ * Packs keys of up to 16 bytes into two words, identical to the short key path of wyhash
+ */
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline void load_short(
+    runtime_reader const& reader, size_t length, uint64_t& a, uint64_t& b) noexcept {
+    if (length >= 4) {
+        size_t const offset = (length >> 3) << 2;
+        a = (reader.read4(0) << 32) | reader.read4(offset);
+        b = (reader.read4(length - 4) << 32) | reader.read4(length - 4 - offset);
+    } else if (length > 0) {
+        a = details::hashing::read_small(reader, 0, length);
+        b = 0;
+    } else {
+        a = b = 0;
+    }
+}
+
+__UTL_TARGET_AES UTL_ATTRIBUTE(ALWAYS_INLINE) inline __m128i load(
+    unsigned char const* ptr) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr));
+}
+
+__UTL_TARGET_AES UTL_ATTRIBUTE(ALWAYS_INLINE) inline __m128i absorb(
+    __m128i state, __m128i block, __m128i key) noexcept {
+    return _mm_aesenc_si128(_mm_xor_si128(state, block), key);
+}
+
+/**
+ * Absorbs 16-byte blocks into two AES lanes with a single round each, the lanes are then merged
+ * and diffused with three further rounds
+ */
+__UTL_TARGET_AES uint64_t aes_hash(void const* data, size_t length, uint64_t seed) noexcept {
+    auto const ptr = static_cast<unsigned char const*>(data);
+    __m128i const key = _mm_set_epi64x(
+        static_cast<long long>(seed ^ secret[0]), static_cast<long long>(length ^ secret[1]));
+    __m128i lane0 = _mm_xor_si128(key,
+        _mm_set_epi64x(static_cast<long long>(secret[2]), static_cast<long long>(secret[3])));
+    __m128i lane1 = _mm_xor_si128(key,
+        _mm_set_epi64x(static_cast<long long>(secret[3]), static_cast<long long>(secret[2])));
+    if (length <= 16) {
+        uint64_t a;
+        uint64_t b;
+        load_short(runtime_reader{ptr}, length, a, b);
+        lane0 = absorb(lane0,
+            _mm_set_epi64x(static_cast<long long>(b), static_cast<long long>(a)), key);
+    } else {
+        size_t idx = 0;
+        size_t remaining = length;
+        while (remaining > 32) {
+            lane0 = absorb(lane0, load(ptr + idx), key);
+            lane1 = absorb(lane1, load(ptr + idx + 16), key);
+            idx += 32;
+            remaining -= 32;
+        }
+
+        // The final block overlaps the preceding bytes when the tail is not a full block
+        if (remaining > 16) {
+            lane1 = absorb(lane1, load(ptr + idx), key);
+        }
+        lane0 = absorb(lane0, load(ptr + length - 16), key);
+    }
+
+    __m128i state = _mm_aesenc_si128(lane0, lane1);
+    state = _mm_aesenc_si128(state, key);
+    state = _mm_aesenc_si128(state, lane0);
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(state)) ^
+        static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(state, state)));
+}
+
+/**
+ * Accumulates 8-byte words into three independent CRC32C lanes, hiding the latency of the CRC
+ * instruction, and finishes with the multiplicative mix of wyhash over the last 16 bytes
+ */
+__UTL_TARGET_SSE42 uint64_t crc32c_hash(void const* data, size_t length, uint64_t seed) noexcept {
+    runtime_reader const reader{static_cast<unsigned char const*>(data)};
+    uint64_t lane0 = static_cast<uint32_t>(seed ^ secret[0]);
+    uint64_t lane1 = static_cast<uint32_t>((seed >> 32) ^ secret[1]);
+    uint64_t lane2 = static_cast<uint32_t>(seed ^ length ^ secret[2]);
+    uint64_t a;
+    uint64_t b;
+    if (length <= 16) {
+        load_short(reader, length, a, b);
+    } else {
+        size_t idx = 0;
+        size_t remaining = length;
+        while (remaining > 24) {
+            lane0 = _mm_crc32_u64(lane0, reader.read8(idx));
+            lane1 = _mm_crc32_u64(lane1, reader.read8(idx + 8));
+            lane2 = _mm_crc32_u64(lane2, reader.read8(idx + 16));
+            idx += 24;
+            remaining -= 24;
+        }
+
+        a = reader.read8(length - 16);
+        b = reader.read8(length - 8);
+        if (remaining > 16) {
+            lane2 = _mm_crc32_u64(lane2, reader.read8(idx));
+        }
+    }
+
+    // The final words bypass the CRC so that short keys keep all of their 128 bits
+    a ^= ((lane0 << 32) | lane1) ^ secret[1];
+    b ^= (lane2 << 32) ^ seed;
+    details::hashing::multiply(a, b);
+    return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+using hash_function = uint64_t (*)(void const*, size_t, uint64_t) noexcept;
+
+hash_function select_hash() noexcept {
+    return supports_aes() ? aes_hash : supports_sse42() ? crc32c_hash : hashing::wyhash_bytes;
+}
+
+} // namespace
+
+uint64_t hash(void const* data, size_t bytes, uint64_t seed) noexcept {
+    static hash_function const function = select_hash();
+    return function(data, bytes, seed);
+}
+
+uint64_t aes(void const* data, size_t bytes, uint64_t seed) noexcept {
+    return supports_aes() ? aes_hash(data, bytes, seed) : hashing::wyhash_bytes(data, bytes, seed);
+}
+
+uint64_t crc32c(void const* data, size_t bytes, uint64_t seed) noexcept {
+    return supports_sse42() ? crc32c_hash(data, bytes, seed)
+                            : hashing::wyhash_bytes(data, bytes, seed);
+}
+
+} // namespace accelerated
+} // namespace hashing
+
+UTL_NAMESPACE_END
+
+#endif // UTL_ARCH_x86_64
@@ -0,0 +1,170 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_epoch_domain.h"
+
+UTL_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * Storage of the global domain, the destructor is never run so that threads exiting after the
+ * static objects are destroyed can still release their participant
+ */
+union global_storage {
+    epoch_domain domain;
+
+    global_storage() noexcept : domain() {}
+    ~global_storage() noexcept {}
+};
+
+} // namespace
+
+epoch_domain::epoch_domain() noexcept : epoch_(0), records_(nullptr), orphans_(nullptr) {}
+
+epoch_domain::~epoch_domain() noexcept {
+    for (retired* node = orphans_; node != nullptr;) {
+        retired* const next = node->next;
+        node->reclaim(node);
+        node = next;
+    }
+
+    for (record* current = records_; current != nullptr;) {
+        record* const next = current->next;
+        UTL_ASSERT(current->in_use == 0);
+        delete current;
+        current = next;
+    }
+}
+
+epoch_domain& epoch_domain::global() noexcept {
+    static global_storage storage;
+    return storage.domain;
+}
+
+epoch_domain::participant& epoch_domain::local() UTL_THROWS {
+    static thread_local participant instance(global());
+    return instance;
+}
+
+epoch_domain::record* epoch_domain::acquire() UTL_THROWS {
+    for (record* current = atomic_acquire::load(&records_); current != nullptr;
+         current = current->next) {
+        uint32_t expected = 0;
+        if (atomic_relaxed::load(&current->in_use) == 0 &&
+            atomic_acquire::compare_exchange_strong(
+                &current->in_use, &expected, uint32_t(1), atomics::relaxed_failure)) {
+            return current;
+        }
+    }
+
+    record* const result = new record{0, nullptr, 1};
+    result->next = atomic_relaxed::load(&records_);
+    while (!atomic_release::compare_exchange_weak(
+        &records_, &result->next, result, atomics::relaxed_failure)) {}
+    return result;
+}
+
+void epoch_domain::abandon(retired* head, retired* tail) noexcept {
+    tail->next = atomic_relaxed::load(&orphans_);
+    while (!atomic_release::compare_exchange_weak(
+        &orphans_, &tail->next, head, atomics::relaxed_failure)) {}
+}
+
+epoch_domain::retired* epoch_domain::adopt() noexcept {
+    if (atomic_relaxed::load(&orphans_) == nullptr) {
+        return nullptr;
+    }
+
+    return atomic_acquire::exchange(&orphans_, static_cast<retired*>(nullptr));
+}
+
+uint64_t epoch_domain::advance() noexcept {
+    // Pairs with the fence of `participant::enter`, either the scan sees the announcement or the
+    // critical section sees every unlink made before the epoch was read
+    atomic_seq_cst::thread_fence();
+    uint64_t epoch = atomic_acquire::load(&epoch_);
+    for (record* current = atomic_acquire::load(&records_); current != nullptr;
+         current = current->next) {
+        uint64_t const state = atomic_acquire::load(&current->state);
+        if ((state & 1) != 0 && (state >> 1) != epoch) {
+            return epoch;
+        }
+    }
+
+    return atomic_acq_rel::compare_exchange_strong(
+               &epoch_, &epoch, epoch + 1, atomics::acquire_failure)
+        ? epoch + 1
+        : epoch;
+}
+
+epoch_domain::participant::participant(epoch_domain& domain) UTL_THROWS
+    : record_(domain.acquire())
+    , domain_(&domain)
+    , nesting_(0)
+    , head_(nullptr)
+    , tail_(nullptr)
+    , pending_(0) {}
+
+epoch_domain::participant::~participant() noexcept {
+    UTL_ASSERT(nesting_ == 0);
+    collect();
+    if (head_ != nullptr) {
+        domain_->abandon(head_, tail_);
+    }
+
+    atomic_release::store(&record_->in_use, uint32_t(0));
+}
+
+void epoch_domain::participant::push(retired* node) noexcept {
+    node->next = nullptr;
+    // The object was unlinked before this point, a critical section announcing an older epoch may
+    // still hold it but one that starts after the epoch advances past `epoch` cannot
+    atomic_seq_cst::thread_fence();
+    node->epoch = atomic_acquire::load(&domain_->epoch_);
+    if (tail_ != nullptr) {
+        tail_->next = node;
+    } else {
+        head_ = node;
+    }
+
+    tail_ = node;
+    if (++pending_ >= collect_threshold) {
+        collect();
+    }
+}
+
+void epoch_domain::participant::collect() noexcept {
+    uint64_t const epoch = domain_->advance();
+    // Deleters may retire further objects, so the list is kept consistent before each call
+    while (head_ != nullptr && head_->epoch + 2 <= epoch) {
+        retired* const node = head_;
+        head_ = node->next;
+        if (head_ == nullptr) {
+            tail_ = nullptr;
+        }
+
+        --pending_;
+        node->reclaim(node);
+    }
+
+    for (retired* node = domain_->adopt(); node != nullptr;) {
+        retired* const next = node->next;
+        if (node->epoch + 2 <= epoch) {
+            node->reclaim(node);
+        } else {
+            node->next = nullptr;
+            if (tail_ != nullptr) {
+                tail_->next = node;
+            } else {
+                head_ = node;
+            }
+
+            tail_ = node;
+            ++pending_;
+        }
+
+        node = next;
+    }
+}
+
+UTL_NAMESPACE_END
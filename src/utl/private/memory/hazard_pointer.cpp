@@ -0,0 +1,170 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_hazard_pointer.h"
+
+#include "utl/numeric/utl_max.h"
+
+#include <new>
+
+UTL_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * Storage of the global domain, the destructor is never run so that hazard pointers destroyed
+ * after the static objects can still release their slot
+ */
+union global_storage {
+    hazard_domain domain;
+
+    global_storage() noexcept : domain() {}
+    ~global_storage() noexcept {}
+};
+
+using memory::details::retired;
+using memory::details::hazard::record;
+
+bool contains(void const* const* first, size_t count, void const* ptr) noexcept {
+    for (size_t idx = 0; idx != count; ++idx) {
+        if (first[idx] == ptr) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool contains(record const* first, void const* ptr) noexcept {
+    for (; first != nullptr; first = first->next) {
+        if (atomic_acquire::load(&first->pointer) == ptr) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+hazard_domain::hazard_domain() noexcept
+    : records_(nullptr)
+    , record_count_(0)
+    , retired_(nullptr)
+    , retired_count_(0) {}
+
+hazard_domain::~hazard_domain() noexcept {
+    for (retired* node = retired_; node != nullptr;) {
+        retired* const next = node->next;
+        node->reclaim(node);
+        node = next;
+    }
+
+    for (record* current = records_; current != nullptr;) {
+        record* const next = current->next;
+        UTL_ASSERT(current->in_use == 0);
+        delete current;
+        current = next;
+    }
+}
+
+hazard_domain& hazard_domain::global() noexcept {
+    static global_storage storage;
+    return storage.domain;
+}
+
+hazard_domain::record* hazard_domain::acquire() UTL_THROWS {
+    for (record* current = atomic_acquire::load(&records_); current != nullptr;
+         current = current->next) {
+        uint32_t expected = 0;
+        if (atomic_relaxed::load(&current->in_use) == 0 &&
+            atomic_acquire::compare_exchange_strong(
+                &current->in_use, &expected, uint32_t(1), atomics::relaxed_failure)) {
+            return current;
+        }
+    }
+
+    record* const result = new record{nullptr, nullptr, 1};
+    result->next = atomic_relaxed::load(&records_);
+    while (!atomic_release::compare_exchange_weak(
+        &records_, &result->next, result, atomics::relaxed_failure)) {}
+    atomic_relaxed::fetch_add(&record_count_, size_t(1));
+    return result;
+}
+
+void hazard_domain::requeue(retired* head, retired* tail, size_t count) noexcept {
+    // Counted before the nodes become visible so that a concurrent `collect` never subtracts more
+    // than was added
+    atomic_relaxed::fetch_add(&retired_count_, count);
+    tail->next = atomic_relaxed::load(&retired_);
+    while (!atomic_release::compare_exchange_weak(
+        &retired_, &tail->next, head, atomics::relaxed_failure)) {}
+}
+
+void hazard_domain::push(retired* node) noexcept {
+    requeue(node, node, 1);
+    size_t const threshold =
+        __UTL numeric::max(collect_threshold, 2 * atomic_relaxed::load(&record_count_));
+    if (atomic_relaxed::load(&retired_count_) >= threshold) {
+        collect();
+    }
+}
+
+void hazard_domain::collect() noexcept {
+    if (atomic_relaxed::load(&retired_) == nullptr) {
+        return;
+    }
+
+    retired* node = atomic_acquire::exchange(&retired_, static_cast<retired*>(nullptr));
+    // Pairs with the fence of `hazard_pointer::try_protect`, either the snapshot sees the
+    // protection or the reader sees the unlink and retries
+    atomic_seq_cst::thread_fence();
+    record const* const first = atomic_acquire::load(&records_);
+    size_t slots = 0;
+    for (record const* current = first; current != nullptr; current = current->next) {
+        ++slots;
+    }
+
+    // Without a snapshot every retired object is checked against the slots themselves
+    void const** const hazards = new (std::nothrow) void const*[slots];
+    size_t protections = 0;
+    if (hazards != nullptr) {
+        for (record const* current = first; slots != 0; current = current->next, --slots) {
+            void const* const ptr = atomic_acquire::load(&current->pointer);
+            if (ptr != nullptr) {
+                hazards[protections++] = ptr;
+            }
+        }
+    }
+
+    retired* head = nullptr;
+    retired* tail = nullptr;
+    size_t kept = 0;
+    size_t taken = 0;
+    while (node != nullptr) {
+        retired* const next = node->next;
+        ++taken;
+        if (hazards != nullptr ? contains(hazards, protections, node->object)
+                               : contains(first, node->object)) {
+            node->next = head;
+            tail = head == nullptr ? node : tail;
+            head = node;
+            ++kept;
+        } else {
+            node->reclaim(node);
+        }
+
+        node = next;
+    }
+
+    delete[] hazards;
+    atomic_relaxed::fetch_sub(&retired_count_, taken);
+    if (head != nullptr) {
+        requeue(head, tail, kept);
+    }
+}
+
+hazard_pointer make_hazard_pointer(hazard_domain& domain) UTL_THROWS {
+    return hazard_pointer(domain.acquire());
+}
+
+UTL_NAMESPACE_END
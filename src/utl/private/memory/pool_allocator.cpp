@@ -0,0 +1,185 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_allocator_decl.h"
+#include "utl/memory/utl_pool_allocator.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/sync/utl_mutex.h"
+
+UTL_NAMESPACE_BEGIN
+namespace memory {
+namespace pool {
+namespace {
+
+constexpr size_t cache_line = 64;
+/**
+ * Smallest amount of memory obtained from the global allocation functions at once
+ */
+constexpr size_t span_bytes = 16 * 1024;
+
+struct free_block {
+    free_block* next;
+};
+
+/**
+ * Chain of free blocks moved between a thread cache and the central list in one operation, the
+ * first block of the chain also links the batches in the central list
+ */
+struct batch {
+    free_block* next;
+    batch* next_batch;
+};
+
+static_assert(sizeof(batch) <= alignment, "Batch header must fit in the smallest block");
+
+/**
+ * @return number of blocks of class `idx` moved per batch, roughly 8 KiB worth of small blocks
+ */
+constexpr size_t batch_size(size_t idx) noexcept {
+    return __UTL numeric::max(
+        size_t(4), __UTL numeric::min(size_t(64), size_t(8192) / class_size(idx)));
+}
+
+struct alignas(cache_line) central_list {
+    mutex lock;
+    batch* head;
+};
+
+central_list central[class_count] = {};
+
+void push_batch(size_t idx, free_block* first) noexcept {
+    auto const chain = reinterpret_cast<batch*>(first);
+    central_list& list = central[idx];
+    list.lock.lock();
+    chain->next_batch = list.head;
+    list.head = chain;
+    list.lock.unlock();
+}
+
+free_block* pop_batch(size_t idx) noexcept {
+    central_list& list = central[idx];
+    list.lock.lock();
+    batch* const chain = list.head;
+    if (chain != nullptr) {
+        list.head = chain->next_batch;
+    }
+    list.lock.unlock();
+    return reinterpret_cast<free_block*>(chain);
+}
+
+struct free_list {
+    free_block* head;
+    /**
+     * Number of blocks in the list, a batch taken from the central list counts as full even if it
+     * was returned partially filled by an exiting thread so this is only used as a watermark
+     */
+    size_t count;
+
+    void refill(size_t idx) UTL_THROWS {
+        free_block* const chain = pop_batch(idx);
+        if (chain != nullptr) {
+            head = chain;
+            count = batch_size(idx);
+            return;
+        }
+
+        size_t const block_bytes = class_size(idx);
+        size_t const blocks =
+            __UTL numeric::max(span_bytes, block_bytes * batch_size(idx)) / block_bytes;
+        auto const span = static_cast<unsigned char*>(
+            memory::details::allocate(blocks * block_bytes, alignment));
+        free_block* next = nullptr;
+        for (size_t i = blocks; i > 0; --i) {
+            auto const block = reinterpret_cast<free_block*>(span + (i - 1) * block_bytes);
+            block->next = next;
+            next = block;
+        }
+
+        head = next;
+        count = blocks;
+    }
+
+    /**
+     * Detaches up to `batch_size(idx)` blocks from the front of the list and returns them to the
+     * central list
+     */
+    void flush(size_t idx) noexcept {
+        free_block* const first = head;
+        free_block* last = first;
+        size_t taken = 1;
+        for (size_t const size = batch_size(idx); taken < size && last->next != nullptr; ++taken) {
+            last = last->next;
+        }
+
+        head = last->next;
+        count = count > taken ? count - taken : 0;
+        last->next = nullptr;
+        push_batch(idx, first);
+    }
+};
+
+/**
+ * Set once the cache of the thread is destroyed, blocks released afterwards by destructors of other
+ * thread local objects go straight to the central lists
+ */
+thread_local bool cache_destroyed = false;
+
+struct thread_cache {
+    free_list lists[class_count];
+
+    ~thread_cache() noexcept {
+        for (size_t idx = 0; idx < class_count; ++idx) {
+            while (lists[idx].head != nullptr) {
+                lists[idx].flush(idx);
+            }
+        }
+        cache_destroyed = true;
+    }
+};
+
+thread_local thread_cache cache = {};
+
+} // namespace
+
+void* allocate(size_t idx) UTL_THROWS {
+    if (cache_destroyed) {
+        free_list list = {};
+        list.refill(idx);
+        free_block* const result = list.head;
+        list.head = result->next;
+        if (list.head != nullptr) {
+            push_batch(idx, list.head);
+        }
+        return result;
+    }
+
+    free_list& list = cache.lists[idx];
+    if (list.head == nullptr) {
+        list.refill(idx);
+    }
+
+    free_block* const result = list.head;
+    list.head = result->next;
+    list.count -= list.count != 0;
+    return result;
+}
+
+void deallocate(void* ptr, size_t idx) noexcept {
+    auto const block = static_cast<free_block*>(ptr);
+    if (cache_destroyed) {
+        block->next = nullptr;
+        push_batch(idx, block);
+        return;
+    }
+
+    free_list& list = cache.lists[idx];
+    block->next = list.head;
+    list.head = block;
+    if (++list.count >= 2 * batch_size(idx)) {
+        list.flush(idx);
+    }
+}
+
+} // namespace pool
+} // namespace memory
+UTL_NAMESPACE_END
@@ -0,0 +1,137 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_page_allocator.h"
+
+#if !UTL_TARGET_MICROSOFT
+
+#  include <stdint.h>
+#  include <stdio.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+
+#  if UTL_TARGET_LINUX
+#    include <sys/syscall.h>
+#  endif
+
+UTL_NAMESPACE_BEGIN
+namespace memory {
+namespace pages {
+namespace {
+
+#  if UTL_TARGET_LINUX
+/**
+ * Prefers `node` for the pages of the mapping without failing when the node is exhausted. The
+ * system call is used directly so that libnuma is not required, kernels without NUMA support
+ * reject it and the mapping keeps the default policy.
+ */
+void bind(void* ptr, size_t bytes, int node) noexcept {
+    constexpr unsigned long mpol_preferred = 1;
+    constexpr size_t word_bits = sizeof(unsigned long) * 8;
+    constexpr size_t max_nodes = 1024;
+    if (node < 0 || static_cast<size_t>(node) >= max_nodes) {
+        return;
+    }
+
+    unsigned long mask[max_nodes / word_bits] = {};
+    mask[node / word_bits] = 1ul << (node % word_bits);
+    (void)::syscall(SYS_mbind, ptr, bytes, mpol_preferred, mask, max_nodes + 1, 0u);
+}
+
+size_t read_huge_size() noexcept {
+    size_t result = 0;
+    FILE* const file = ::fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+    if (file != nullptr) {
+        if (::fscanf(file, "%zu", &result) != 1) {
+            result = 0;
+        }
+        ::fclose(file);
+    }
+
+    return result != 0 ? result : size_t(2 * 1024 * 1024);
+}
+#  else
+void bind(void*, size_t, int) noexcept {}
+
+size_t read_huge_size() noexcept {
+    return size();
+}
+#  endif
+
+void* map(size_t bytes, int flags) noexcept {
+    void* const result = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return result != MAP_FAILED ? result : nullptr;
+}
+
+/**
+ * Maps `bytes` bytes aligned to `alignment` by over-allocating and trimming both ends, so the
+ * kernel can back the mapping with whole huge pages
+ */
+void* map_aligned(size_t bytes, size_t alignment) noexcept {
+    auto const raw =
+        static_cast<unsigned char*>(map(bytes + alignment, MAP_PRIVATE | MAP_ANONYMOUS));
+    if (raw == nullptr) {
+        return nullptr;
+    }
+
+    auto const address = reinterpret_cast<uintptr_t>(raw);
+    size_t const head = ((address + alignment - 1) & ~uintptr_t(alignment - 1)) - address;
+    if (head != 0) {
+        ::munmap(raw, head);
+    }
+    ::munmap(raw + head + bytes, alignment - head);
+
+    return raw + head;
+}
+
+} // namespace
+
+size_t size() noexcept {
+    static size_t const value = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return value;
+}
+
+size_t huge_size() noexcept {
+    static size_t const value = read_huge_size();
+    return value;
+}
+
+void* allocate(size_t bytes, options opts) UTL_THROWS {
+    void* result = nullptr;
+#  if UTL_TARGET_LINUX && defined(MAP_HUGETLB)
+    if (opts.huge == huge_pages::reserved) {
+        result = map(bytes, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB);
+    }
+#  endif
+
+    if (result == nullptr) {
+        if (opts.huge != huge_pages::none && huge_size() > size()) {
+            result = map_aligned(bytes, huge_size());
+#  if defined(MADV_HUGEPAGE)
+            if (result != nullptr) {
+                (void)::madvise(result, bytes, MADV_HUGEPAGE);
+            }
+#  endif
+        } else {
+            result = map(bytes, MAP_PRIVATE | MAP_ANONYMOUS);
+        }
+    }
+
+    UTL_THROW_IF(result == nullptr,
+        bad_alloc(UTL_MESSAGE_FORMAT("[UTL] allocation operation failed, Reason=[page mapping "
+                                     "failed], bytes=[%zu]"),
+            bytes));
+    bind(result, bytes, opts.node);
+    return result;
+}
+
+void deallocate(void* ptr, size_t bytes) noexcept {
+    if (ptr != nullptr) {
+        ::munmap(ptr, bytes);
+    }
+}
+
+} // namespace pages
+} // namespace memory
+UTL_NAMESPACE_END
+
+#endif // !UTL_TARGET_MICROSOFT
@@ -0,0 +1,85 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_page_allocator.h"
+
+#if UTL_TARGET_MICROSOFT
+
+#  define NOMINMAX
+#  define NODRAWTEXT
+#  define NOGDI
+#  define NOBITMAP
+#  define NOMCX
+#  define NOSERVICE
+#  define NOHELP
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+
+#  include <Windows.h>
+#  include <memoryapi.h>
+#  include <sysinfoapi.h>
+
+UTL_NAMESPACE_BEGIN
+namespace memory {
+namespace pages {
+namespace {
+
+size_t read_size() noexcept {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+}
+
+/**
+ * Large pages require the lock pages in memory privilege, without it the allocation fails and
+ * base pages are used instead. Windows has no transparent huge pages.
+ */
+void* map(size_t bytes, DWORD type, int node) noexcept {
+    if (node >= 0) {
+        return VirtualAllocExNuma(GetCurrentProcess(), nullptr, bytes, type, PAGE_READWRITE,
+            static_cast<DWORD>(node));
+    }
+
+    return VirtualAlloc(nullptr, bytes, type, PAGE_READWRITE);
+}
+
+} // namespace
+
+size_t size() noexcept {
+    static size_t const value = read_size();
+    return value;
+}
+
+size_t huge_size() noexcept {
+    static size_t const value = GetLargePageMinimum() != 0 ? GetLargePageMinimum() : size();
+    return value;
+}
+
+void* allocate(size_t bytes, options opts) UTL_THROWS {
+    void* result = nullptr;
+    if (opts.huge == huge_pages::reserved && huge_size() > size()) {
+        result = map(bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, opts.node);
+    }
+
+    if (result == nullptr) {
+        result = map(bytes, MEM_RESERVE | MEM_COMMIT, opts.node);
+    }
+
+    UTL_THROW_IF(result == nullptr,
+        bad_alloc(UTL_MESSAGE_FORMAT("[UTL] allocation operation failed, Reason=[page mapping "
+                                     "failed], bytes=[%zu]"),
+            bytes));
+    return result;
+}
+
+void deallocate(void* ptr, size_t) noexcept {
+    if (ptr != nullptr) {
+        VirtualFree(ptr, 0, MEM_RELEASE);
+    }
+}
+
+} // namespace pages
+} // namespace memory
+UTL_NAMESPACE_END
+
+#endif // UTL_TARGET_MICROSOFT
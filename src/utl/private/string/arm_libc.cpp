@@ -0,0 +1,524 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/string/utl_libc_vectorized.h"
+#include "utl/utility/utl_signs.h"
+
+#if UTL_ARCH_AARCH64
+
+#  include "string/char_set.h"
+#  include "string/two_way.h"
+
+#  include <arm_neon.h>
+#  include <stdint.h>
+#  include <string.h>
+
+UTL_NAMESPACE_BEGIN
+namespace libc {
+namespace runtime {
+namespace vectorized {
+namespace {
+
+using vector_type = uint8x16_t;
+constexpr size_t vector_bytes = sizeof(vector_type);
+constexpr size_t page_size = 4096;
+
+template <size_t Bytes>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline bool crosses_page(void const* ptr) noexcept {
+    return ((uintptr_t)ptr & (page_size - 1)) > page_size - Bytes;
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline size_t countr_zero(uint64_t mask) noexcept {
+#  if UTL_COMPILER_MSVC
+    unsigned long idx;
+    _BitScanForward64(&idx, mask);
+    return idx;
+#  else
+    return __builtin_ctzll(mask);
+#  endif
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline size_t countl_zero(uint64_t mask) noexcept {
+#  if UTL_COMPILER_MSVC
+    unsigned long idx;
+    _BitScanReverse64(&idx, mask);
+    return 63 - idx;
+#  else
+    return __builtin_clzll(mask);
+#  endif
+}
+
+/**
+ * NEON has no movemask, narrowing each 16-bit lane by 4 produces a 64-bit mask with a nibble per
+ * byte instead
+ */
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t to_mask(vector_type value) noexcept {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(value), 4)), 0);
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline size_t first_element(uint64_t mask) noexcept {
+    return countr_zero(mask) / (4 * sizeof(T));
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline size_t last_element(uint64_t mask) noexcept {
+    return (63 - countl_zero(mask)) / (4 * sizeof(T));
+}
+
+/**
+ * Keeps a single bit of the nibble mask per element so that bits can be cleared one at a time
+ */
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t element_mask(uint64_t mask) noexcept {
+    return sizeof(T) == 1 ? mask & 0x1111111111111111ull
+        : sizeof(T) == 2  ? mask & 0x0101010101010101ull
+                          : mask & 0x0001000100010001ull;
+}
+
+/**
+ * Needles longer than this are matched with Two-Way, since each candidate found by the first/last
+ * element filter costs up to a full needle comparison
+ */
+constexpr size_t short_needle_length = 32;
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline bool equal_range(
+    T const* left, T const* right, size_t count) noexcept {
+    return ::memcmp(left, right, count * sizeof(T)) == 0;
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline vector_type broadcast(T value) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return vdupq_n_u8((uint8_t)value);
+    } else if constexpr (sizeof(T) == 2) {
+        return vreinterpretq_u8_u16(vdupq_n_u16((uint16_t)value));
+    } else {
+        return vreinterpretq_u8_u32(vdupq_n_u32((uint32_t)value));
+    }
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline vector_type equal(
+    vector_type left, vector_type right) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return vceqq_u8(left, right);
+    } else if constexpr (sizeof(T) == 2) {
+        return vreinterpretq_u8_u16(
+            vceqq_u16(vreinterpretq_u16_u8(left), vreinterpretq_u16_u8(right)));
+    } else {
+        return vreinterpretq_u8_u32(
+            vceqq_u32(vreinterpretq_u32_u8(left), vreinterpretq_u32_u8(right)));
+    }
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline vector_type load(void const* ptr) noexcept {
+    return vld1q_u8((uint8_t const*)ptr);
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t match_or_null(
+    T const* block, vector_type needle, vector_type zero) noexcept {
+    auto const value = load(block);
+    return to_mask(vorrq_u8(equal<T>(value, needle), equal<T>(value, zero)));
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t candidates(
+    T const* str, size_t m, vector_type first, vector_type last) noexcept {
+    auto const front = equal<T>(load(str), first);
+    auto const back = equal<T>(load(str + m - 1), last);
+    return element_mask<T>(to_mask(vandq_u8(front, back)));
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline int compare_element(T left, T right) noexcept {
+    return (__UTL to_unsigned(left) < __UTL to_unsigned(right)) ? -1
+        : (__UTL to_unsigned(right) < __UTL to_unsigned(left))  ? 1
+                                                                : 0;
+}
+
+template <typename T>
+T const* memchr_impl(T const* str, T const ch, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const needle = broadcast(ch);
+    for (; count >= lanes; str += lanes, count -= lanes) {
+        uint64_t const mask = to_mask(equal<T>(load(str), needle));
+        if (mask) {
+            return str + first_element<T>(mask);
+        }
+    }
+
+    for (; count; ++str, --count) {
+        if (*str == ch) {
+            return str;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+T const* memrchr_impl(T const* str, T const ch, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const needle = broadcast(ch);
+    for (; count >= lanes; count -= lanes) {
+        uint64_t const mask = to_mask(equal<T>(load(str + count - lanes), needle));
+        if (mask) {
+            return str + count - lanes + last_element<T>(mask);
+        }
+    }
+
+    while (count) {
+        --count;
+        if (str[count] == ch) {
+            return str + count;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Compares the first and last element of the needle against every candidate position at once,
+ * only candidates that match both are verified
+ */
+template <typename T>
+T const* memmem_short(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const first = broadcast(needle[0]);
+    auto const last = broadcast(needle[m - 1]);
+    size_t i = 0;
+    for (; i + m - 1 + lanes <= n; i += lanes) {
+        uint64_t mask = candidates(haystack + i, m, first, last);
+        while (mask) {
+            size_t const idx = first_element<T>(mask);
+            if (equal_range(haystack + i + idx + 1, needle + 1, m - 2)) {
+                return haystack + i + idx;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i + m <= n; ++i) {
+        if (haystack[i] == needle[0] && haystack[i + m - 1] == needle[m - 1] &&
+            equal_range(haystack + i + 1, needle + 1, m - 2)) {
+            return haystack + i;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+T const* memrmem_short(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const first = broadcast(needle[0]);
+    auto const last = broadcast(needle[m - 1]);
+    // One past the last candidate position
+    size_t end = n - m + 1;
+    for (; end >= lanes; end -= lanes) {
+        size_t const base = end - lanes;
+        uint64_t mask = candidates(haystack + base, m, first, last);
+        while (mask) {
+            size_t const idx = last_element<T>(mask);
+            if (equal_range(haystack + base + idx + 1, needle + 1, m - 2)) {
+                return haystack + base + idx;
+            }
+            mask &= ~(1ull << (63 - countl_zero(mask)));
+        }
+    }
+
+    while (end) {
+        --end;
+        if (haystack[end] == needle[0] && haystack[end + m - 1] == needle[m - 1] &&
+            equal_range(haystack + end + 1, needle + 1, m - 2)) {
+            return haystack + end;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+T const* memmem_impl(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    if (!m) {
+        return haystack;
+    }
+
+    if (m > n) {
+        return nullptr;
+    }
+
+    if (m == 1) {
+        return memchr_impl(haystack, *needle, n);
+    }
+
+    if (m <= short_needle_length) {
+        return memmem_short(haystack, n, needle, m);
+    }
+
+    return two_way::find(haystack, n, needle, m);
+}
+
+template <typename T>
+T const* memrmem_impl(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    if (!m) {
+        return haystack + n;
+    }
+
+    if (m > n) {
+        return nullptr;
+    }
+
+    if (m == 1) {
+        return memrchr_impl(haystack, *needle, n);
+    }
+
+    if (m <= short_needle_length) {
+        return memrmem_short(haystack, n, needle, m);
+    }
+
+    return two_way::rfind(haystack, n, needle, m);
+}
+
+/**
+ * Classifies every byte against the set, the index formed from the low nibble and top bit
+ * addresses both halves of the bitmap as a single 32-byte table
+ */
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline vector_type members(
+    vector_type value, uint8x16x2_t table, vector_type bits) noexcept {
+    auto const low = vandq_u8(value, vdupq_n_u8(0x0F));
+    auto const index = vorrq_u8(low, vandq_u8(vshrq_n_u8(value, 3), vdupq_n_u8(0x10)));
+    auto const rows = vqtbl2q_u8(table, index);
+    return vtstq_u8(rows, vqtbl1q_u8(bits, vshrq_n_u8(value, 4)));
+}
+
+template <bool Accept, typename T>
+T const* find_first_of_impl(
+    T const* str, size_t count, T const* chars, size_t chars_count) noexcept {
+    if (Accept && chars_count == 1) {
+        return memchr_impl(str, *chars, count);
+    }
+
+    char_set<T> const set(chars, chars_count);
+    if constexpr (sizeof(T) == 1) {
+        uint8x16x2_t const table = {{vld1q_u8(set.table), vld1q_u8(set.table + 16)}};
+        auto const bits = vld1q_u8(nibble_bits);
+        for (; count >= vector_bytes; str += vector_bytes, count -= vector_bytes) {
+            auto const found = members(load(str), table, bits);
+            uint64_t const mask = to_mask(Accept ? found : vmvnq_u8(found));
+            if (mask) {
+                return str + first_element<T>(mask);
+            }
+        }
+    }
+
+    return scalar_find_first_of<Accept>(str, count, set);
+}
+
+template <bool Accept, typename T>
+T const* find_last_of_impl(
+    T const* str, size_t count, T const* chars, size_t chars_count) noexcept {
+    if (Accept && chars_count == 1) {
+        return memrchr_impl(str, *chars, count);
+    }
+
+    char_set<T> const set(chars, chars_count);
+    if constexpr (sizeof(T) == 1) {
+        uint8x16x2_t const table = {{vld1q_u8(set.table), vld1q_u8(set.table + 16)}};
+        auto const bits = vld1q_u8(nibble_bits);
+        for (; count >= vector_bytes; count -= vector_bytes) {
+            T const* const block = str + count - vector_bytes;
+            auto const found = members(load(block), table, bits);
+            uint64_t const mask = to_mask(Accept ? found : vmvnq_u8(found));
+            if (mask) {
+                return block + last_element<T>(mask);
+            }
+        }
+    }
+
+    return scalar_find_last_of<Accept>(str, count, set);
+}
+
+template <typename T>
+size_t strlen_impl(T const* str) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const zero = broadcast(T());
+    // Aligned loads never cross a page boundary
+    size_t const offset = (uintptr_t)str & (vector_bytes - 1);
+    T const* block = (T const*)((uintptr_t)str - offset);
+    uint64_t mask = to_mask(equal<T>(load(block), zero)) >> (4 * offset);
+    if (mask) {
+        return first_element<T>(mask);
+    }
+
+    while (true) {
+        block += lanes;
+        mask = to_mask(equal<T>(load(block), zero));
+        if (mask) {
+            return (size_t)(block - str) + first_element<T>(mask);
+        }
+    }
+}
+
+template <typename T>
+T const* strnchr_impl(T const* str, T const ch, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    if (!count) {
+        return nullptr;
+    }
+
+    auto const needle = broadcast(ch);
+    auto const zero = broadcast(T());
+    size_t const offset = (uintptr_t)str & (vector_bytes - 1);
+    T const* block = (T const*)((uintptr_t)str - offset);
+    uint64_t mask = match_or_null(block, needle, zero) >> (4 * offset);
+    size_t scanned = lanes - offset / sizeof(T);
+    while (!mask) {
+        if (scanned >= count) {
+            return nullptr;
+        }
+
+        str += scanned;
+        count -= scanned;
+        block += lanes;
+        mask = match_or_null(block, needle, zero);
+        scanned = lanes;
+    }
+
+    size_t const idx = first_element<T>(mask);
+    return idx < count && str[idx] == ch ? str + idx : nullptr;
+}
+
+template <typename T>
+int strncmp_impl(T const* left, T const* right, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const zero = broadcast(T());
+    while (count >= lanes) {
+        if (crosses_page<vector_bytes>(left) || crosses_page<vector_bytes>(right)) {
+            // Step until neither load straddles a page, the strings may terminate before it
+            if (*left != *right) {
+                return compare_element(*left, *right);
+            }
+
+            if (*left == T()) {
+                return 0;
+            }
+
+            ++left;
+            ++right;
+            --count;
+            continue;
+        }
+
+        auto const l = load(left);
+        auto const r = load(right);
+        uint64_t const mask = to_mask(vorrq_u8(vmvnq_u8(equal<T>(l, r)), equal<T>(l, zero)));
+        if (mask) {
+            size_t const idx = first_element<T>(mask);
+            return compare_element(left[idx], right[idx]);
+        }
+
+        left += lanes;
+        right += lanes;
+        count -= lanes;
+    }
+
+    for (; count; ++left, ++right, --count) {
+        if (*left != *right) {
+            return compare_element(*left, *right);
+        }
+
+        if (*left == T()) {
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+template <typename T>
+T* strnset_impl(T* dst, T const value, size_t count) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return (T*)::memset(dst, (unsigned char)value, count);
+    } else {
+        constexpr size_t lanes = vector_bytes / sizeof(T);
+        auto const v = broadcast(value);
+        T* ptr = dst;
+        for (; count >= lanes; ptr += lanes, count -= lanes) {
+            vst1q_u8((uint8_t*)ptr, v);
+        }
+
+        for (; count; ++ptr, --count) {
+            *ptr = value;
+        }
+
+        return dst;
+    }
+}
+
+} // namespace
+
+#  define __UTL_DEFINE_VECTORIZED_KERNELS(TYPE)                                          \
+      TYPE* memchr(TYPE const* str, TYPE ch, element_count_t count) noexcept {            \
+          return const_cast<TYPE*>(memchr_impl(str, ch, (size_t)count));                  \
+      }                                                                                   \
+      size_t strlen(TYPE const* str) noexcept {                                           \
+          return strlen_impl(str);                                                        \
+      }                                                                                   \
+      TYPE* strnchr(TYPE const* str, TYPE ch, element_count_t count) noexcept {           \
+          return const_cast<TYPE*>(strnchr_impl(str, ch, (size_t)count));                 \
+      }                                                                                   \
+      int strncmp(TYPE const* left, TYPE const* right, element_count_t count) noexcept {  \
+          return strncmp_impl(left, right, (size_t)count);                                \
+      }                                                                                   \
+      TYPE* strnset(TYPE* dst, TYPE value, element_count_t count) noexcept {              \
+          return strnset_impl(dst, value, (size_t)count);                                 \
+      }                                                                                   \
+      TYPE* memrchr(TYPE const* str, TYPE ch, element_count_t count) noexcept {           \
+          return const_cast<TYPE*>(memrchr_impl(str, ch, (size_t)count));                 \
+      }                                                                                   \
+      TYPE* memmem(TYPE const* haystack, element_count_t n, TYPE const* needle,           \
+          element_count_t m) noexcept {                                                   \
+          return const_cast<TYPE*>(memmem_impl(haystack, (size_t)n, needle, (size_t)m));  \
+      }                                                                                   \
+      TYPE* memrmem(TYPE const* haystack, element_count_t n, TYPE const* needle,          \
+          element_count_t m) noexcept {                                                   \
+          return const_cast<TYPE*>(memrmem_impl(haystack, (size_t)n, needle, (size_t)m)); \
+      }                                                                                   \
+      TYPE* find_first_of(TYPE const* str, element_count_t count, TYPE const* chars,      \
+          element_count_t chars_count) noexcept {                                         \
+          return const_cast<TYPE*>(                                                       \
+              find_first_of_impl<true>(str, (size_t)count, chars, (size_t)chars_count));  \
+      }                                                                                   \
+      TYPE* find_first_not_of(TYPE const* str, element_count_t count, TYPE const* chars,  \
+          element_count_t chars_count) noexcept {                                         \
+          return const_cast<TYPE*>(                                                       \
+              find_first_of_impl<false>(str, (size_t)count, chars, (size_t)chars_count)); \
+      }                                                                                   \
+      TYPE* find_last_of(TYPE const* str, element_count_t count, TYPE const* chars,       \
+          element_count_t chars_count) noexcept {                                         \
+          return const_cast<TYPE*>(                                                       \
+              find_last_of_impl<true>(str, (size_t)count, chars, (size_t)chars_count));   \
+      }                                                                                   \
+      TYPE* find_last_not_of(TYPE const* str, element_count_t count, TYPE const* chars,   \
+          element_count_t chars_count) noexcept {                                         \
+          return const_cast<TYPE*>(                                                       \
+              find_last_of_impl<false>(str, (size_t)count, chars, (size_t)chars_count));  \
+      }
+
+__UTL_DEFINE_VECTORIZED_KERNELS(char)
+__UTL_DEFINE_VECTORIZED_KERNELS(wchar_t)
+__UTL_DEFINE_VECTORIZED_KERNELS(char16_t)
+__UTL_DEFINE_VECTORIZED_KERNELS(char32_t)
+
+#  undef __UTL_DEFINE_VECTORIZED_KERNELS
+
+} // namespace vectorized
+} // namespace runtime
+} // namespace libc
+
+UTL_NAMESPACE_END
+
+#endif // UTL_ARCH_AARCH64
@@ -0,0 +1,108 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/string/utl_libc_common.h"
+#include "utl/utility/utl_signs.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+namespace libc {
+namespace runtime {
+namespace vectorized {
+namespace {
+
+/**
+ * Membership table for the set of characters passed to the `find_*_of` kernels
+ *
+ * Elements below 256 are recorded in a 256-bit bitmap split into two 16-byte tables indexed by
+ * the low nibble, one for each value of the top bit; bit `(c >> 4) & 7` of the selected byte is
+ * set if `c` is a member. This is the layout consumed by the PSHUFB/TBL nibble lookups. Any
+ * larger element is checked against the original set.
+ */
+template <typename T>
+struct char_set {
+    char_set(T const* chars, size_t count) noexcept : chars(chars), count(count) {
+        for (size_t i = 0; i < count; ++i) {
+            auto const value = __UTL to_unsigned(chars[i]);
+            if (value > 0xFF) {
+                has_wide = true;
+            } else {
+                table[index(value)] |= bit(value);
+            }
+        }
+    }
+
+    UTL_ATTRIBUTE(ALWAYS_INLINE) static inline size_t index(size_t value) noexcept {
+        return ((value >> 3) & 0x10) | (value & 0xF);
+    }
+
+    UTL_ATTRIBUTE(ALWAYS_INLINE) static inline uint8_t bit(size_t value) noexcept {
+        return (uint8_t)(1u << ((value >> 4) & 0x7));
+    }
+
+    UTL_ATTRIBUTE(ALWAYS_INLINE) inline bool contains(T ch) const noexcept {
+        auto const value = __UTL to_unsigned(ch);
+        if (value <= 0xFF) {
+            return (table[index(value)] & bit(value)) != 0;
+        }
+
+        if (!has_wide) {
+            return false;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            if (chars[i] == ch) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    alignas(16) uint8_t table[32] = {};
+    T const* chars;
+    size_t count;
+    bool has_wide = false;
+};
+
+/**
+ * Per-nibble bit selectors for the second lookup, `(1 << (i & 7))` at index `i`
+ */
+alignas(16) constexpr uint8_t nibble_bits[16] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+
+template <bool Accept, typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline T const* scalar_find_first_of(
+    T const* str, size_t count, char_set<T> const& set) noexcept {
+    for (; count; ++str, --count) {
+        if (set.contains(*str) == Accept) {
+            return str;
+        }
+    }
+
+    return nullptr;
+}
+
+template <bool Accept, typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline T const* scalar_find_last_of(
+    T const* str, size_t count, char_set<T> const& set) noexcept {
+    while (count) {
+        --count;
+        if (set.contains(str[count]) == Accept) {
+            return str + count;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace
+} // namespace vectorized
+} // namespace runtime
+} // namespace libc
+
+UTL_NAMESPACE_END
@@ -0,0 +1,186 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/string/utl_libc_common.h"
+#include "utl/utility/utl_signs.h"
+
+UTL_NAMESPACE_BEGIN
+namespace libc {
+namespace runtime {
+namespace vectorized {
+namespace {
+namespace two_way {
+
+/**
+ * Crochemore-Perrin Two-Way string matching
+ *
+ * Linear time and constant space regardless of the contents of the needle or haystack; the
+ * reverse variant runs the same algorithm over the reversed needle and haystack.
+ */
+template <bool Reverse>
+struct sequence;
+
+template <>
+struct sequence<false> {
+    template <typename T>
+    UTL_ATTRIBUTE(ALWAYS_INLINE) static inline T at(T const* str, size_t, size_t idx) noexcept {
+        return str[idx];
+    }
+};
+
+template <>
+struct sequence<true> {
+    template <typename T>
+    UTL_ATTRIBUTE(ALWAYS_INLINE) static inline T at(T const* str, size_t len, size_t idx) noexcept {
+        return str[len - 1 - idx];
+    }
+};
+
+constexpr size_t not_found = static_cast<size_t>(-1);
+
+template <bool Reverse, typename T>
+size_t maximal_suffix(T const* needle, size_t m, bool invert, size_t& period) noexcept {
+    using seq = sequence<Reverse>;
+    size_t suffix = not_found;
+    size_t j = 0;
+    size_t k = 1;
+    size_t p = 1;
+    while (j + k < m) {
+        auto const a = __UTL to_unsigned(seq::at(needle, m, j + k));
+        auto const b = __UTL to_unsigned(seq::at(needle, m, suffix + k));
+        if (invert ? b < a : a < b) {
+            j += k;
+            k = 1;
+            p = j - suffix;
+        } else if (a == b) {
+            if (k != p) {
+                ++k;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            suffix = j++;
+            k = p = 1;
+        }
+    }
+
+    period = p;
+    return suffix;
+}
+
+template <bool Reverse, typename T>
+size_t critical_factorization(T const* needle, size_t m, size_t& period) noexcept {
+    size_t forward_period;
+    size_t reverse_period;
+    size_t const forward = maximal_suffix<Reverse>(needle, m, false, forward_period);
+    size_t const reverse = maximal_suffix<Reverse>(needle, m, true, reverse_period);
+    // Choose the longer suffix, returns the first element of the right half
+    if (reverse + 1 < forward + 1) {
+        period = forward_period;
+        return forward + 1;
+    }
+
+    period = reverse_period;
+    return reverse + 1;
+}
+
+template <bool Reverse, typename T>
+bool is_periodic(T const* needle, size_t m, size_t period, size_t suffix) noexcept {
+    using seq = sequence<Reverse>;
+    for (size_t i = 0; i < suffix; ++i) {
+        if (seq::at(needle, m, i) != seq::at(needle, m, i + period)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @return The offset of the match within the (possibly reversed) haystack, or `not_found`
+ */
+template <bool Reverse, typename T>
+size_t search(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    using seq = sequence<Reverse>;
+    size_t period;
+    size_t const suffix = critical_factorization<Reverse>(needle, m, period);
+    size_t j = 0;
+    if (is_periodic<Reverse>(needle, m, period, suffix)) {
+        // The left half of the needle is repeated, remember how much of it has been matched
+        size_t memory = 0;
+        while (j <= n - m) {
+            size_t i = suffix < memory ? memory : suffix;
+            while (i < m && seq::at(needle, m, i) == seq::at(haystack, n, i + j)) {
+                ++i;
+            }
+
+            if (m <= i) {
+                i = suffix - 1;
+                while (memory < i + 1 && seq::at(needle, m, i) == seq::at(haystack, n, i + j)) {
+                    --i;
+                }
+
+                if (i + 1 < memory + 1) {
+                    return j;
+                }
+
+                j += period;
+                memory = m - period;
+            } else {
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
+    } else {
+        period = (suffix < m - suffix ? m - suffix : suffix) + 1;
+        while (j <= n - m) {
+            size_t i = suffix;
+            while (i < m && seq::at(needle, m, i) == seq::at(haystack, n, i + j)) {
+                ++i;
+            }
+
+            if (m <= i) {
+                i = suffix - 1;
+                while (i != not_found && seq::at(needle, m, i) == seq::at(haystack, n, i + j)) {
+                    --i;
+                }
+
+                if (i == not_found) {
+                    return j;
+                }
+
+                j += period;
+            } else {
+                j += i - suffix + 1;
+            }
+        }
+    }
+
+    return not_found;
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline T const* find(
+    T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    size_t const idx = search<false>(haystack, n, needle, m);
+    return idx == not_found ? nullptr : haystack + idx;
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline T const* rfind(
+    T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    size_t const idx = search<true>(haystack, n, needle, m);
+    return idx == not_found ? nullptr : haystack + (n - m - idx);
+}
+
+} // namespace two_way
+} // namespace
+} // namespace vectorized
+} // namespace runtime
+} // namespace libc
+
+UTL_NAMESPACE_END
@@ -0,0 +1,979 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/hardware/x86/utl_cpuid.h"
+#include "utl/hardware/x86/utl_xgetbv.h"
+#include "utl/string/utl_libc_vectorized.h"
+#include "utl/utility/utl_signs.h"
+
+#if UTL_ARCH_x86
+
+#  include "string/char_set.h"
+#  include "string/two_way.h"
+
+#  include <immintrin.h>
+#  include <stdint.h>
+#  include <string.h>
+
+#  if UTL_COMPILER_GNU_BASED
+#    define __UTL_TARGET_SSSE3 __attribute__((target("ssse3")))
+#    define __UTL_TARGET_AVX2 __attribute__((target("avx2")))
+#  else
+#    define __UTL_TARGET_SSSE3
+#    define __UTL_TARGET_AVX2
+#  endif
+
+UTL_NAMESPACE_BEGIN
+namespace libc {
+namespace runtime {
+namespace vectorized {
+namespace {
+
+template <unsigned int X, unsigned int S = 0>
+x86::cpuid_t cached_cpuid() noexcept {
+    static x86::cpuid_t const value = x86::cpuid<X, S>();
+    return value;
+}
+
+bool supports_ssse3() noexcept {
+    static bool const value = (cached_cpuid<1>().ecx & (1u << 9)) != 0;
+    return value;
+}
+
+bool supports_avx2() noexcept {
+    static bool const value = []() {
+        if (cached_cpuid<0>().eax < 7) {
+            return false;
+        }
+
+        auto const ecx = cached_cpuid<1>().ecx;
+        // OSXSAVE and AVX
+        if (!(ecx & (1u << 27)) || !(ecx & (1u << 28))) {
+            return false;
+        }
+
+        // The OS must preserve both the XMM and YMM state
+        if ((x86::xgetbv<0>() & 0x6) != 0x6) {
+            return false;
+        }
+
+        return (cached_cpuid<7, 0>().ebx & (1u << 5)) != 0;
+    }();
+
+    return value;
+}
+
+constexpr size_t page_size = 4096;
+
+template <size_t Bytes>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline bool crosses_page(void const* ptr) noexcept {
+    return ((uintptr_t)ptr & (page_size - 1)) > page_size - Bytes;
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline size_t countr_zero(uint32_t mask) noexcept {
+#  if UTL_COMPILER_MSVC
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return idx;
+#  else
+    return __builtin_ctz(mask);
+#  endif
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline size_t countl_zero(uint32_t mask) noexcept {
+#  if UTL_COMPILER_MSVC
+    unsigned long idx;
+    _BitScanReverse(&idx, mask);
+    return 31 - idx;
+#  else
+    return __builtin_clz(mask);
+#  endif
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline size_t first_element(uint32_t mask) noexcept {
+    return countr_zero(mask) / sizeof(T);
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline size_t last_element(uint32_t mask) noexcept {
+    return (31 - countl_zero(mask)) / sizeof(T);
+}
+
+/**
+ * Keeps a single bit of the byte mask per element so that bits can be cleared one at a time
+ */
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint32_t element_mask(uint32_t mask) noexcept {
+    return sizeof(T) == 1 ? mask : sizeof(T) == 2 ? mask & 0x55555555u : mask & 0x11111111u;
+}
+
+/**
+ * Needles longer than this are matched with Two-Way, since each candidate found by the first/last
+ * element filter costs up to a full needle comparison
+ */
+constexpr size_t short_needle_length = 32;
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline bool equal_range(
+    T const* left, T const* right, size_t count) noexcept {
+    return ::memcmp(left, right, count * sizeof(T)) == 0;
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline int compare_element(T left, T right) noexcept {
+    return (__UTL to_unsigned(left) < __UTL to_unsigned(right)) ? -1
+        : (__UTL to_unsigned(right) < __UTL to_unsigned(left))  ? 1
+                                                                : 0;
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline T const* scalar_memchr(
+    T const* str, T const ch, size_t count) noexcept {
+    for (; count; ++str, --count) {
+        if (*str == ch) {
+            return str;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline T const* scalar_memrchr(
+    T const* str, T const ch, size_t count) noexcept {
+    while (count) {
+        --count;
+        if (str[count] == ch) {
+            return str + count;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline T const* scalar_memmem(
+    T const* haystack, size_t n, T const* needle, size_t m, size_t begin) noexcept {
+    for (size_t i = begin; i + m <= n; ++i) {
+        if (haystack[i] == needle[0] && haystack[i + m - 1] == needle[m - 1] &&
+            equal_range(haystack + i + 1, needle + 1, m - 2)) {
+            return haystack + i;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline T const* scalar_memrmem(
+    T const* haystack, T const* needle, size_t m, size_t end) noexcept {
+    for (size_t i = end; i-- > 0;) {
+        if (haystack[i] == needle[0] && haystack[i + m - 1] == needle[m - 1] &&
+            equal_range(haystack + i + 1, needle + 1, m - 2)) {
+            return haystack + i;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline int scalar_strncmp(
+    T const* left, T const* right, size_t count) noexcept {
+    for (; count; ++left, ++right, --count) {
+        if (*left != *right) {
+            return compare_element(*left, *right);
+        }
+
+        if (*left == T()) {
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+namespace sse2 {
+using vector_type = __m128i;
+constexpr size_t vector_bytes = sizeof(vector_type);
+constexpr uint32_t lane_mask = (1u << vector_bytes) - 1;
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline vector_type broadcast(T value) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return _mm_set1_epi8((char)value);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_set1_epi16((short)value);
+    } else {
+        return _mm_set1_epi32((int)value);
+    }
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline vector_type equal(
+    vector_type left, vector_type right) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return _mm_cmpeq_epi8(left, right);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_cmpeq_epi16(left, right);
+    } else {
+        return _mm_cmpeq_epi32(left, right);
+    }
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint32_t to_mask(vector_type value) noexcept {
+    return (uint32_t)_mm_movemask_epi8(value);
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline vector_type load(void const* ptr) noexcept {
+    return _mm_loadu_si128((vector_type const*)ptr);
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline vector_type load_aligned(void const* ptr) noexcept {
+    return _mm_load_si128((vector_type const*)ptr);
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint32_t match_or_null(
+    T const* block, vector_type needle, vector_type zero) noexcept {
+    auto const value = load_aligned(block);
+    return to_mask(_mm_or_si128(equal<T>(value, needle), equal<T>(value, zero)));
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint32_t candidates(
+    T const* str, size_t m, vector_type first, vector_type last) noexcept {
+    auto const front = equal<T>(load(str), first);
+    auto const back = equal<T>(load(str + m - 1), last);
+    return element_mask<T>(to_mask(_mm_and_si128(front, back)));
+}
+
+template <typename T>
+T const* memchr(T const* str, T const ch, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const needle = broadcast(ch);
+    for (; count >= lanes; str += lanes, count -= lanes) {
+        uint32_t const mask = to_mask(equal<T>(load(str), needle));
+        if (mask) {
+            return str + first_element<T>(mask);
+        }
+    }
+
+    return scalar_memchr(str, ch, count);
+}
+
+template <typename T>
+size_t strlen(T const* str) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const zero = broadcast(T());
+    // Aligned loads never cross a page boundary
+    size_t const offset = (uintptr_t)str & (vector_bytes - 1);
+    T const* block = (T const*)((uintptr_t)str - offset);
+    uint32_t mask = to_mask(equal<T>(load_aligned(block), zero)) >> offset;
+    if (mask) {
+        return first_element<T>(mask);
+    }
+
+    while (true) {
+        block += lanes;
+        mask = to_mask(equal<T>(load_aligned(block), zero));
+        if (mask) {
+            return (size_t)(block - str) + first_element<T>(mask);
+        }
+    }
+}
+
+template <typename T>
+T const* strnchr(T const* str, T const ch, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    if (!count) {
+        return nullptr;
+    }
+
+    auto const needle = broadcast(ch);
+    auto const zero = broadcast(T());
+    size_t const offset = (uintptr_t)str & (vector_bytes - 1);
+    T const* block = (T const*)((uintptr_t)str - offset);
+    uint32_t mask = match_or_null(block, needle, zero) >> offset;
+    size_t scanned = lanes - offset / sizeof(T);
+    while (!mask) {
+        if (scanned >= count) {
+            return nullptr;
+        }
+
+        str += scanned;
+        count -= scanned;
+        block += lanes;
+        mask = match_or_null(block, needle, zero);
+        scanned = lanes;
+    }
+
+    size_t const idx = first_element<T>(mask);
+    return idx < count && str[idx] == ch ? str + idx : nullptr;
+}
+
+template <typename T>
+int strncmp(T const* left, T const* right, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const zero = broadcast(T());
+    while (count >= lanes) {
+        if (crosses_page<vector_bytes>(left) || crosses_page<vector_bytes>(right)) {
+            // Step until neither load straddles a page, the strings may terminate before it
+            if (*left != *right) {
+                return compare_element(*left, *right);
+            }
+
+            if (*left == T()) {
+                return 0;
+            }
+
+            ++left;
+            ++right;
+            --count;
+            continue;
+        }
+
+        auto const l = load(left);
+        auto const r = load(right);
+        uint32_t const mask =
+            ((~to_mask(equal<T>(l, r))) & lane_mask) | to_mask(equal<T>(l, zero));
+        if (mask) {
+            size_t const idx = first_element<T>(mask);
+            return compare_element(left[idx], right[idx]);
+        }
+
+        left += lanes;
+        right += lanes;
+        count -= lanes;
+    }
+
+    return scalar_strncmp(left, right, count);
+}
+
+template <typename T>
+T* strnset(T* dst, T const value, size_t count) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return (T*)::memset(dst, (unsigned char)value, count);
+    } else {
+        constexpr size_t lanes = vector_bytes / sizeof(T);
+        auto const v = broadcast(value);
+        T* ptr = dst;
+        for (; count >= lanes; ptr += lanes, count -= lanes) {
+            _mm_storeu_si128((vector_type*)ptr, v);
+        }
+
+        for (; count; ++ptr, --count) {
+            *ptr = value;
+        }
+
+        return dst;
+    }
+}
+
+template <typename T>
+T const* memrchr(T const* str, T const ch, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const needle = broadcast(ch);
+    for (; count >= lanes; count -= lanes) {
+        uint32_t const mask = to_mask(equal<T>(load(str + count - lanes), needle));
+        if (mask) {
+            return str + count - lanes + last_element<T>(mask);
+        }
+    }
+
+    return scalar_memrchr(str, ch, count);
+}
+
+/**
+ * Compares the first and last element of the needle against every candidate position at once,
+ * only candidates that match both are verified
+ */
+template <typename T>
+T const* memmem_short(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const first = broadcast(needle[0]);
+    auto const last = broadcast(needle[m - 1]);
+    size_t i = 0;
+    for (; i + m - 1 + lanes <= n; i += lanes) {
+        uint32_t mask = candidates(haystack + i, m, first, last);
+        while (mask) {
+            size_t const idx = first_element<T>(mask);
+            if (equal_range(haystack + i + idx + 1, needle + 1, m - 2)) {
+                return haystack + i + idx;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return scalar_memmem(haystack, n, needle, m, i);
+}
+
+template <typename T>
+T const* memrmem_short(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const first = broadcast(needle[0]);
+    auto const last = broadcast(needle[m - 1]);
+    // One past the last candidate position
+    size_t end = n - m + 1;
+    for (; end >= lanes; end -= lanes) {
+        size_t const base = end - lanes;
+        uint32_t mask = candidates(haystack + base, m, first, last);
+        while (mask) {
+            size_t const idx = last_element<T>(mask);
+            if (equal_range(haystack + base + idx + 1, needle + 1, m - 2)) {
+                return haystack + base + idx;
+            }
+            mask &= ~(1u << (31 - countl_zero(mask)));
+        }
+    }
+
+    return scalar_memrmem(haystack, needle, m, end);
+}
+} // namespace sse2
+
+namespace ssse3 {
+using vector_type = __m128i;
+constexpr size_t vector_bytes = sizeof(vector_type);
+
+/**
+ * Classifies every byte against the set with two nibble lookups into its bitmap
+ */
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_SSSE3 inline uint32_t members(
+    vector_type value, vector_type low, vector_type high, vector_type bits) noexcept {
+    // PSHUFB yields zero for any index with the top bit set, so each table only answers for
+    // the half of the byte range it describes
+    auto const rows = _mm_or_si128(_mm_shuffle_epi8(low, value),
+        _mm_shuffle_epi8(high, _mm_xor_si128(value, _mm_set1_epi8((char)0x80))));
+    auto const column = _mm_and_si128(_mm_srli_epi16(value, 4), _mm_set1_epi8(0x0F));
+    auto const hits = _mm_and_si128(rows, _mm_shuffle_epi8(bits, column));
+    return ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(hits, _mm_setzero_si128())) &
+        ((1u << vector_bytes) - 1);
+}
+
+template <bool Accept, typename T>
+__UTL_TARGET_SSSE3 T const* find_first_of(
+    T const* str, size_t count, char_set<T> const& set) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        auto const low = _mm_load_si128((vector_type const*)set.table);
+        auto const high = _mm_load_si128((vector_type const*)(set.table + 16));
+        auto const bits = _mm_load_si128((vector_type const*)nibble_bits);
+        for (; count >= vector_bytes; str += vector_bytes, count -= vector_bytes) {
+            uint32_t const found =
+                members(_mm_loadu_si128((vector_type const*)str), low, high, bits);
+            uint32_t const mask = Accept ? found : found ^ ((1u << vector_bytes) - 1);
+            if (mask) {
+                return str + countr_zero(mask);
+            }
+        }
+    }
+
+    return scalar_find_first_of<Accept>(str, count, set);
+}
+
+template <bool Accept, typename T>
+__UTL_TARGET_SSSE3 T const* find_last_of(
+    T const* str, size_t count, char_set<T> const& set) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        auto const low = _mm_load_si128((vector_type const*)set.table);
+        auto const high = _mm_load_si128((vector_type const*)(set.table + 16));
+        auto const bits = _mm_load_si128((vector_type const*)nibble_bits);
+        for (; count >= vector_bytes; count -= vector_bytes) {
+            T const* const block = str + count - vector_bytes;
+            uint32_t const found =
+                members(_mm_loadu_si128((vector_type const*)block), low, high, bits);
+            uint32_t const mask = Accept ? found : found ^ ((1u << vector_bytes) - 1);
+            if (mask) {
+                return block + (31 - countl_zero(mask));
+            }
+        }
+    }
+
+    return scalar_find_last_of<Accept>(str, count, set);
+}
+} // namespace ssse3
+
+namespace avx2 {
+using vector_type = __m256i;
+constexpr size_t vector_bytes = sizeof(vector_type);
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_AVX2 inline vector_type broadcast(T value) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_set1_epi8((char)value);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_set1_epi16((short)value);
+    } else {
+        return _mm256_set1_epi32((int)value);
+    }
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_AVX2 inline vector_type equal(
+    vector_type left, vector_type right) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_cmpeq_epi8(left, right);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_cmpeq_epi16(left, right);
+    } else {
+        return _mm256_cmpeq_epi32(left, right);
+    }
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_AVX2 inline uint32_t to_mask(vector_type value) noexcept {
+    return (uint32_t)_mm256_movemask_epi8(value);
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_AVX2 inline vector_type load(void const* ptr) noexcept {
+    return _mm256_loadu_si256((vector_type const*)ptr);
+}
+
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_AVX2 inline vector_type load_aligned(
+    void const* ptr) noexcept {
+    return _mm256_load_si256((vector_type const*)ptr);
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_AVX2 inline uint32_t match_or_null(
+    T const* block, vector_type needle, vector_type zero) noexcept {
+    auto const value = load_aligned(block);
+    return to_mask(_mm256_or_si256(equal<T>(value, needle), equal<T>(value, zero)));
+}
+
+template <typename T>
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_AVX2 inline uint32_t candidates(
+    T const* str, size_t m, vector_type first, vector_type last) noexcept {
+    auto const front = equal<T>(load(str), first);
+    auto const back = equal<T>(load(str + m - 1), last);
+    return element_mask<T>(to_mask(_mm256_and_si256(front, back)));
+}
+
+template <typename T>
+__UTL_TARGET_AVX2 T const* memchr(T const* str, T const ch, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const needle = broadcast(ch);
+    for (; count >= 2 * lanes; str += 2 * lanes, count -= 2 * lanes) {
+        auto const first = equal<T>(load(str), needle);
+        auto const second = equal<T>(load(str + lanes), needle);
+        if (!_mm256_testz_si256(_mm256_or_si256(first, second), _mm256_or_si256(first, second))) {
+            uint32_t const mask = to_mask(first);
+            return mask ? str + first_element<T>(mask)
+                        : str + lanes + first_element<T>(to_mask(second));
+        }
+    }
+
+    for (; count >= lanes; str += lanes, count -= lanes) {
+        uint32_t const mask = to_mask(equal<T>(load(str), needle));
+        if (mask) {
+            return str + first_element<T>(mask);
+        }
+    }
+
+    return scalar_memchr(str, ch, count);
+}
+
+template <typename T>
+__UTL_TARGET_AVX2 size_t strlen(T const* str) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const zero = broadcast(T());
+    // Aligned loads never cross a page boundary
+    size_t const offset = (uintptr_t)str & (vector_bytes - 1);
+    T const* block = (T const*)((uintptr_t)str - offset);
+    uint32_t mask = to_mask(equal<T>(load_aligned(block), zero)) >> offset;
+    if (mask) {
+        return first_element<T>(mask);
+    }
+
+    while (true) {
+        block += lanes;
+        mask = to_mask(equal<T>(load_aligned(block), zero));
+        if (mask) {
+            return (size_t)(block - str) + first_element<T>(mask);
+        }
+    }
+}
+
+template <typename T>
+__UTL_TARGET_AVX2 T const* strnchr(T const* str, T const ch, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    if (!count) {
+        return nullptr;
+    }
+
+    auto const needle = broadcast(ch);
+    auto const zero = broadcast(T());
+    size_t const offset = (uintptr_t)str & (vector_bytes - 1);
+    T const* block = (T const*)((uintptr_t)str - offset);
+    uint32_t mask = match_or_null(block, needle, zero) >> offset;
+    size_t scanned = lanes - offset / sizeof(T);
+    while (!mask) {
+        if (scanned >= count) {
+            return nullptr;
+        }
+
+        str += scanned;
+        count -= scanned;
+        block += lanes;
+        mask = match_or_null(block, needle, zero);
+        scanned = lanes;
+    }
+
+    size_t const idx = first_element<T>(mask);
+    return idx < count && str[idx] == ch ? str + idx : nullptr;
+}
+
+template <typename T>
+__UTL_TARGET_AVX2 int strncmp(T const* left, T const* right, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const zero = broadcast(T());
+    while (count >= lanes) {
+        if (crosses_page<vector_bytes>(left) || crosses_page<vector_bytes>(right)) {
+            // Step until neither load straddles a page, the strings may terminate before it
+            if (*left != *right) {
+                return compare_element(*left, *right);
+            }
+
+            if (*left == T()) {
+                return 0;
+            }
+
+            ++left;
+            ++right;
+            --count;
+            continue;
+        }
+
+        auto const l = load(left);
+        auto const r = load(right);
+        uint32_t const mask = ~to_mask(equal<T>(l, r)) | to_mask(equal<T>(l, zero));
+        if (mask) {
+            size_t const idx = first_element<T>(mask);
+            return compare_element(left[idx], right[idx]);
+        }
+
+        left += lanes;
+        right += lanes;
+        count -= lanes;
+    }
+
+    return scalar_strncmp(left, right, count);
+}
+
+template <typename T>
+__UTL_TARGET_AVX2 T* strnset(T* dst, T const value, size_t count) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return (T*)::memset(dst, (unsigned char)value, count);
+    } else {
+        constexpr size_t lanes = vector_bytes / sizeof(T);
+        auto const v = broadcast(value);
+        T* ptr = dst;
+        for (; count >= lanes; ptr += lanes, count -= lanes) {
+            _mm256_storeu_si256((vector_type*)ptr, v);
+        }
+
+        for (; count; ++ptr, --count) {
+            *ptr = value;
+        }
+
+        return dst;
+    }
+}
+
+template <typename T>
+__UTL_TARGET_AVX2 T const* memrchr(T const* str, T const ch, size_t count) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const needle = broadcast(ch);
+    for (; count >= lanes; count -= lanes) {
+        uint32_t const mask = to_mask(equal<T>(load(str + count - lanes), needle));
+        if (mask) {
+            return str + count - lanes + last_element<T>(mask);
+        }
+    }
+
+    return scalar_memrchr(str, ch, count);
+}
+
+/**
+ * Compares the first and last element of the needle against every candidate position at once,
+ * only candidates that match both are verified
+ */
+template <typename T>
+__UTL_TARGET_AVX2 T const* memmem_short(
+    T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const first = broadcast(needle[0]);
+    auto const last = broadcast(needle[m - 1]);
+    size_t i = 0;
+    for (; i + m - 1 + lanes <= n; i += lanes) {
+        uint32_t mask = candidates(haystack + i, m, first, last);
+        while (mask) {
+            size_t const idx = first_element<T>(mask);
+            if (equal_range(haystack + i + idx + 1, needle + 1, m - 2)) {
+                return haystack + i + idx;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return scalar_memmem(haystack, n, needle, m, i);
+}
+
+template <typename T>
+__UTL_TARGET_AVX2 T const* memrmem_short(
+    T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    constexpr size_t lanes = vector_bytes / sizeof(T);
+    auto const first = broadcast(needle[0]);
+    auto const last = broadcast(needle[m - 1]);
+    // One past the last candidate position
+    size_t end = n - m + 1;
+    for (; end >= lanes; end -= lanes) {
+        size_t const base = end - lanes;
+        uint32_t mask = candidates(haystack + base, m, first, last);
+        while (mask) {
+            size_t const idx = last_element<T>(mask);
+            if (equal_range(haystack + base + idx + 1, needle + 1, m - 2)) {
+                return haystack + base + idx;
+            }
+            mask &= ~(1u << (31 - countl_zero(mask)));
+        }
+    }
+
+    return scalar_memrmem(haystack, needle, m, end);
+}
+
+/**
+ * Classifies every byte against the set with two nibble lookups into its bitmap
+ */
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_AVX2 inline uint32_t members(
+    vector_type value, vector_type low, vector_type high, vector_type bits) noexcept {
+    // VPSHUFB yields zero for any index with the top bit set, so each table only answers for
+    // the half of the byte range it describes
+    auto const rows = _mm256_or_si256(_mm256_shuffle_epi8(low, value),
+        _mm256_shuffle_epi8(high, _mm256_xor_si256(value, _mm256_set1_epi8((char)0x80))));
+    auto const column = _mm256_and_si256(_mm256_srli_epi16(value, 4), _mm256_set1_epi8(0x0F));
+    auto const hits = _mm256_and_si256(rows, _mm256_shuffle_epi8(bits, column));
+    return ~to_mask(_mm256_cmpeq_epi8(hits, _mm256_setzero_si256()));
+}
+
+/**
+ * VPSHUFB looks up within each 128-bit lane, so the tables are repeated in both lanes
+ */
+UTL_ATTRIBUTE(ALWAYS_INLINE) __UTL_TARGET_AVX2 inline vector_type load_table(
+    uint8_t const* table) noexcept {
+    return _mm256_broadcastsi128_si256(_mm_load_si128((__m128i const*)table));
+}
+
+template <bool Accept, typename T>
+__UTL_TARGET_AVX2 T const* find_first_of(
+    T const* str, size_t count, char_set<T> const& set) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        auto const low = load_table(set.table);
+        auto const high = load_table(set.table + 16);
+        auto const bits = load_table(nibble_bits);
+        for (; count >= vector_bytes; str += vector_bytes, count -= vector_bytes) {
+            uint32_t const found = members(load(str), low, high, bits);
+            uint32_t const mask = Accept ? found : ~found;
+            if (mask) {
+                return str + countr_zero(mask);
+            }
+        }
+    }
+
+    return scalar_find_first_of<Accept>(str, count, set);
+}
+
+template <bool Accept, typename T>
+__UTL_TARGET_AVX2 T const* find_last_of(
+    T const* str, size_t count, char_set<T> const& set) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        auto const low = load_table(set.table);
+        auto const high = load_table(set.table + 16);
+        auto const bits = load_table(nibble_bits);
+        for (; count >= vector_bytes; count -= vector_bytes) {
+            T const* const block = str + count - vector_bytes;
+            uint32_t const found = members(load(block), low, high, bits);
+            uint32_t const mask = Accept ? found : ~found;
+            if (mask) {
+                return block + (31 - countl_zero(mask));
+            }
+        }
+    }
+
+    return scalar_find_last_of<Accept>(str, count, set);
+}
+} // namespace avx2
+
+template <typename T>
+struct kernel_table {
+    T const* (*memchr)(T const*, T, size_t) noexcept;
+    size_t (*strlen)(T const*) noexcept;
+    T const* (*strnchr)(T const*, T, size_t) noexcept;
+    int (*strncmp)(T const*, T const*, size_t) noexcept;
+    T* (*strnset)(T*, T, size_t) noexcept;
+    T const* (*memrchr)(T const*, T, size_t) noexcept;
+    T const* (*memmem_short)(T const*, size_t, T const*, size_t) noexcept;
+    T const* (*memrmem_short)(T const*, size_t, T const*, size_t) noexcept;
+    T const* (*find_first_of)(T const*, size_t, char_set<T> const&) noexcept;
+    T const* (*find_first_not_of)(T const*, size_t, char_set<T> const&) noexcept;
+    T const* (*find_last_of)(T const*, size_t, char_set<T> const&) noexcept;
+    T const* (*find_last_not_of)(T const*, size_t, char_set<T> const&) noexcept;
+};
+
+/**
+ * Resolves the kernels once on first use, similar to an ifunc resolver
+ */
+template <typename T>
+kernel_table<T> const& kernels() noexcept {
+    static kernel_table<T> const value = supports_avx2()
+        ? kernel_table<T>{&avx2::memchr<T>, &avx2::strlen<T>, &avx2::strnchr<T>,
+              &avx2::strncmp<T>, &avx2::strnset<T>, &avx2::memrchr<T>, &avx2::memmem_short<T>,
+              &avx2::memrmem_short<T>, &avx2::find_first_of<true, T>,
+              &avx2::find_first_of<false, T>, &avx2::find_last_of<true, T>,
+              &avx2::find_last_of<false, T>}
+        : supports_ssse3()
+        ? kernel_table<T>{&sse2::memchr<T>, &sse2::strlen<T>, &sse2::strnchr<T>,
+              &sse2::strncmp<T>, &sse2::strnset<T>, &sse2::memrchr<T>, &sse2::memmem_short<T>,
+              &sse2::memrmem_short<T>, &ssse3::find_first_of<true, T>,
+              &ssse3::find_first_of<false, T>, &ssse3::find_last_of<true, T>,
+              &ssse3::find_last_of<false, T>}
+        // SSE2 has no byte shuffle to perform the nibble lookup with
+        : kernel_table<T>{&sse2::memchr<T>, &sse2::strlen<T>, &sse2::strnchr<T>,
+              &sse2::strncmp<T>, &sse2::strnset<T>, &sse2::memrchr<T>, &sse2::memmem_short<T>,
+              &sse2::memrmem_short<T>, &scalar_find_first_of<true, T>,
+              &scalar_find_first_of<false, T>, &scalar_find_last_of<true, T>,
+              &scalar_find_last_of<false, T>};
+    return value;
+}
+
+template <typename T>
+T const* memmem_impl(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    if (!m) {
+        return haystack;
+    }
+
+    if (m > n) {
+        return nullptr;
+    }
+
+    if (m == 1) {
+        return kernels<T>().memchr(haystack, *needle, n);
+    }
+
+    if (m <= short_needle_length) {
+        return kernels<T>().memmem_short(haystack, n, needle, m);
+    }
+
+    return two_way::find(haystack, n, needle, m);
+}
+
+template <typename T>
+T const* memrmem_impl(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    if (!m) {
+        return haystack + n;
+    }
+
+    if (m > n) {
+        return nullptr;
+    }
+
+    if (m == 1) {
+        return kernels<T>().memrchr(haystack, *needle, n);
+    }
+
+    if (m <= short_needle_length) {
+        return kernels<T>().memrmem_short(haystack, n, needle, m);
+    }
+
+    return two_way::rfind(haystack, n, needle, m);
+}
+
+template <bool Accept, typename T>
+T const* find_first_of_impl(
+    T const* str, size_t count, T const* chars, size_t chars_count) noexcept {
+    if (Accept && chars_count == 1) {
+        return kernels<T>().memchr(str, *chars, count);
+    }
+
+    char_set<T> const set(chars, chars_count);
+    return Accept ? kernels<T>().find_first_of(str, count, set)
+                  : kernels<T>().find_first_not_of(str, count, set);
+}
+
+template <bool Accept, typename T>
+T const* find_last_of_impl(
+    T const* str, size_t count, T const* chars, size_t chars_count) noexcept {
+    if (Accept && chars_count == 1) {
+        return kernels<T>().memrchr(str, *chars, count);
+    }
+
+    char_set<T> const set(chars, chars_count);
+    return Accept ? kernels<T>().find_last_of(str, count, set)
+                  : kernels<T>().find_last_not_of(str, count, set);
+}
+
+} // namespace
+
+#  define __UTL_DEFINE_VECTORIZED_KERNELS(TYPE)                                          \
+      TYPE* memchr(TYPE const* str, TYPE ch, element_count_t count) noexcept {            \
+          return const_cast<TYPE*>(kernels<TYPE>().memchr(str, ch, (size_t)count));       \
+      }                                                                                   \
+      size_t strlen(TYPE const* str) noexcept {                                           \
+          return kernels<TYPE>().strlen(str);                                             \
+      }                                                                                   \
+      TYPE* strnchr(TYPE const* str, TYPE ch, element_count_t count) noexcept {           \
+          return const_cast<TYPE*>(kernels<TYPE>().strnchr(str, ch, (size_t)count));      \
+      }                                                                                   \
+      int strncmp(TYPE const* left, TYPE const* right, element_count_t count) noexcept {  \
+          return kernels<TYPE>().strncmp(left, right, (size_t)count);                     \
+      }                                                                                   \
+      TYPE* strnset(TYPE* dst, TYPE value, element_count_t count) noexcept {              \
+          return kernels<TYPE>().strnset(dst, value, (size_t)count);                      \
+      }                                                                                   \
+      TYPE* memrchr(TYPE const* str, TYPE ch, element_count_t count) noexcept {           \
+          return const_cast<TYPE*>(kernels<TYPE>().memrchr(str, ch, (size_t)count));      \
+      }                                                                                   \
+      TYPE* memmem(TYPE const* haystack, element_count_t n, TYPE const* needle,           \
+          element_count_t m) noexcept {                                                   \
+          return const_cast<TYPE*>(memmem_impl(haystack, (size_t)n, needle, (size_t)m));  \
+      }                                                                                   \
+      TYPE* memrmem(TYPE const* haystack, element_count_t n, TYPE const* needle,          \
+          element_count_t m) noexcept {                                                   \
+          return const_cast<TYPE*>(memrmem_impl(haystack, (size_t)n, needle, (size_t)m)); \
+      }                                                                                   \
+      TYPE* find_first_of(TYPE const* str, element_count_t count, TYPE const* chars,      \
+          element_count_t chars_count) noexcept {                                         \
+          return const_cast<TYPE*>(                                                       \
+              find_first_of_impl<true>(str, (size_t)count, chars, (size_t)chars_count));  \
+      }                                                                                   \
+      TYPE* find_first_not_of(TYPE const* str, element_count_t count, TYPE const* chars,  \
+          element_count_t chars_count) noexcept {                                         \
+          return const_cast<TYPE*>(                                                       \
+              find_first_of_impl<false>(str, (size_t)count, chars, (size_t)chars_count)); \
+      }                                                                                   \
+      TYPE* find_last_of(TYPE const* str, element_count_t count, TYPE const* chars,       \
+          element_count_t chars_count) noexcept {                                         \
+          return const_cast<TYPE*>(                                                       \
+              find_last_of_impl<true>(str, (size_t)count, chars, (size_t)chars_count));   \
+      }                                                                                   \
+      TYPE* find_last_not_of(TYPE const* str, element_count_t count, TYPE const* chars,   \
+          element_count_t chars_count) noexcept {                                         \
+          return const_cast<TYPE*>(                                                       \
+              find_last_of_impl<false>(str, (size_t)count, chars, (size_t)chars_count));  \
+      }
+
+__UTL_DEFINE_VECTORIZED_KERNELS(char)
+__UTL_DEFINE_VECTORIZED_KERNELS(wchar_t)
+__UTL_DEFINE_VECTORIZED_KERNELS(char16_t)
+__UTL_DEFINE_VECTORIZED_KERNELS(char32_t)
+
+#  undef __UTL_DEFINE_VECTORIZED_KERNELS
+
+} // namespace vectorized
+} // namespace runtime
+} // namespace libc
+
+UTL_NAMESPACE_END
+
+#  undef __UTL_TARGET_SSSE3
+#  undef __UTL_TARGET_AVX2
+
+#endif // UTL_ARCH_x86
@@ -0,0 +1,58 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/sync/utl_barrier.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/atomic/utl_futex.h"
+#include "utl/sync/utl_backoff.h"
+#include "utl/tempus/utl_duration.h"
+
+UTL_NAMESPACE_BEGIN
+
+barrier::arrival_token barrier::arrive(uint32_t dropped) noexcept {
+    uint32_t current = atomic_relaxed::load(&state_);
+    while (true) {
+        // A dropped thread lowers the count expected in this phase instead of arriving
+        uint32_t const arrived = (current & count_mask) + 1 - dropped;
+        uint32_t const expected = ((current >> expected_shift) & count_mask) - dropped;
+        uint32_t const phase = current & phase_mask;
+        bool const completed = arrived >= expected;
+        // Completing a phase resets the arrival count, and the phase counter wraps around
+        uint32_t const next = completed ? (phase + phase_one) | (expected << expected_shift)
+                                        : phase | (expected << expected_shift) | arrived;
+        if (atomic_acq_rel::compare_exchange_weak(
+                &state_, &current, next, atomics::acquire_failure)) {
+            if (completed) {
+                __UTL futex::notify_all(&state_);
+            }
+            return phase;
+        }
+    }
+}
+
+barrier::arrival_token barrier::arrive() noexcept {
+    return arrive(0);
+}
+
+void barrier::wait(arrival_token token) const noexcept {
+    auto const state = const_cast<uint32_t*>(&state_);
+    if (sync::details::spin_until(
+            [&]() { return (atomic_acquire::load(state) & phase_mask) != token; })) {
+        return;
+    }
+
+    for (uint32_t current = atomic_acquire::load(state); (current & phase_mask) == token;
+         current = atomic_acquire::load(state)) {
+        (void)__UTL futex::wait(state, current, __UTL tempus::duration::invalid());
+    }
+}
+
+void barrier::arrive_and_wait() noexcept {
+    wait(arrive(0));
+}
+
+void barrier::arrive_and_drop() noexcept {
+    (void)arrive(1);
+}
+
+UTL_NAMESPACE_END
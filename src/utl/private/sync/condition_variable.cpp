@@ -0,0 +1,44 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/sync/utl_condition_variable.h"
+
+#include "utl/atomic/utl_futex.h"
+#include "utl/tempus/utl_duration.h"
+
+#include <errno.h>
+#include <limits.h>
+
+UTL_NAMESPACE_BEGIN
+
+void condition_variable::wait(mutex& m) noexcept {
+    uint32_t const sequence = atomic_relaxed::load(&sequence_);
+    m.unlock();
+    (void)__UTL futex::wait(&sequence_, sequence, __UTL tempus::duration::invalid());
+    // The waiter may have been moved onto the mutex along with others
+    m.lock_marked();
+}
+
+void condition_variable::notify_one() noexcept {
+    atomic_relaxed::fetch_add(&sequence_, uint32_t(1));
+    __UTL futex::notify_one(&sequence_);
+}
+
+void condition_variable::notify_all() noexcept {
+    atomic_relaxed::fetch_add(&sequence_, uint32_t(1));
+    __UTL futex::notify_all(&sequence_);
+}
+
+void condition_variable::notify_all(mutex& m) noexcept {
+#if UTL_TARGET_LINUX
+    uint32_t sequence = atomic_relaxed::fetch_add(&sequence_, uint32_t(1)) + 1;
+    // The woken waiter takes the mutex marked as contended, so its release wakes the next one
+    while (__UTL futex::requeue(&sequence_, sequence, 1, &m.state_, INT_MAX).value() == EAGAIN) {
+        sequence = atomic_relaxed::load(&sequence_);
+    }
+#else
+    (void)m;
+    notify_all();
+#endif
+}
+
+UTL_NAMESPACE_END
@@ -0,0 +1,25 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/sync/utl_event_count.h"
+
+#include "utl/atomic/utl_futex.h"
+#include "utl/tempus/utl_duration.h"
+
+UTL_NAMESPACE_BEGIN
+
+void event_count::wait(uint32_t key) noexcept {
+    (void)__UTL futex::wait(&epoch_, key, __UTL tempus::duration::invalid());
+    atomic_relaxed::fetch_sub(&waiters_, uint32_t(1));
+}
+
+void event_count::wake_one() noexcept {
+    atomic_release::fetch_add(&epoch_, uint32_t(1));
+    __UTL futex::notify_one(&epoch_);
+}
+
+void event_count::wake_all() noexcept {
+    atomic_release::fetch_add(&epoch_, uint32_t(1));
+    __UTL futex::notify_all(&epoch_);
+}
+
+UTL_NAMESPACE_END
@@ -0,0 +1,27 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/sync/utl_latch.h"
+
+#include "utl/atomic/utl_futex.h"
+#include "utl/sync/utl_backoff.h"
+#include "utl/tempus/utl_duration.h"
+
+UTL_NAMESPACE_BEGIN
+
+void latch::wait_contended() const noexcept {
+    if (sync::details::spin_until([this]() { return try_wait(); })) {
+        return;
+    }
+
+    auto const count = const_cast<uint32_t*>(&count_);
+    for (uint32_t current = atomic_acquire::load(count); current != 0;
+         current = atomic_acquire::load(count)) {
+        (void)__UTL futex::wait(count, current, __UTL tempus::duration::invalid());
+    }
+}
+
+void latch::wake() noexcept {
+    __UTL futex::notify_all(&count_);
+}
+
+UTL_NAMESPACE_END
@@ -0,0 +1,41 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/sync/utl_mutex.h"
+
+#include "utl/atomic/utl_futex.h"
+#include "utl/sync/utl_backoff.h"
+#include "utl/tempus/utl_duration.h"
+
+UTL_NAMESPACE_BEGIN
+
+void mutex::lock_contended() noexcept {
+    // Spin while the owner is likely to release the lock soon, but not once others are blocked
+    bool acquired = false;
+    sync::details::spin_until([this, &acquired]() {
+        uint32_t expected = atomic_relaxed::load(&state_);
+        if (expected == unlocked) {
+            acquired = atomic_acquire::compare_exchange_weak(
+                &state_, &expected, locked, atomics::relaxed_failure);
+            return acquired;
+        }
+
+        return expected == contended;
+    });
+
+    if (!acquired) {
+        lock_marked();
+    }
+}
+
+void mutex::lock_marked() noexcept {
+    // The waiter cannot tell whether others are blocked, so it takes the lock marked as contended
+    while (atomic_acquire::exchange(&state_, contended) != unlocked) {
+        (void)__UTL futex::wait(&state_, contended, __UTL tempus::duration::invalid());
+    }
+}
+
+void mutex::wake() noexcept {
+    __UTL futex::notify_one(&state_);
+}
+
+UTL_NAMESPACE_END
@@ -0,0 +1,70 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/sync/utl_shared_mutex.h"
+
+#include "utl/atomic/utl_futex.h"
+#include "utl/sync/utl_backoff.h"
+#include "utl/tempus/utl_duration.h"
+
+UTL_NAMESPACE_BEGIN
+
+void shared_mutex::lock_contended() noexcept {
+    auto const try_acquire = [this]() {
+        uint32_t expected = atomic_relaxed::load(&state_);
+        return (expected & (write_locked | reader_mask)) == 0 &&
+            atomic_acquire::compare_exchange_weak(
+                &state_, &expected, expected | write_locked, atomics::relaxed_failure);
+    };
+
+    if (sync::details::spin_until(try_acquire)) {
+        return;
+    }
+
+    // Registering as a waiting writer stops new readers from entering
+    atomic_relaxed::fetch_add(&state_, writer_one);
+    while (true) {
+        uint32_t expected = atomic_relaxed::load(&state_);
+        if ((expected & (write_locked | reader_mask)) == 0) {
+            if (atomic_acquire::compare_exchange_weak(&state_, &expected,
+                    (expected - writer_one) | write_locked, atomics::relaxed_failure)) {
+                return;
+            }
+            continue;
+        }
+
+        (void)__UTL futex::wait(&state_, expected, __UTL tempus::duration::invalid());
+    }
+}
+
+void shared_mutex::lock_shared_contended() noexcept {
+    if (sync::details::spin_until([this]() { return try_lock_shared(); })) {
+        return;
+    }
+
+    while (true) {
+        uint32_t expected = atomic_relaxed::load(&state_);
+        if (readable(expected)) {
+            if (atomic_acquire::compare_exchange_weak(
+                    &state_, &expected, expected + 1, atomics::relaxed_failure)) {
+                return;
+            }
+            continue;
+        }
+
+        if ((expected & readers_waiting) == 0) {
+            if (!atomic_relaxed::compare_exchange_weak(&state_, &expected,
+                    expected | readers_waiting, atomics::relaxed_failure)) {
+                continue;
+            }
+            expected |= readers_waiting;
+        }
+
+        (void)__UTL futex::wait(&state_, expected, __UTL tempus::duration::invalid());
+    }
+}
+
+void shared_mutex::wake() noexcept {
+    __UTL futex::notify_all(&state_);
+}
+
+UTL_NAMESPACE_END
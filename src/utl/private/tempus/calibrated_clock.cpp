@@ -0,0 +1,318 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/tempus/utl_calibrated_clock.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/sync/utl_mutex.h"
+#include "utl/tempus/utl_clock.h"
+#include "utl/tempus/utl_hardware_ticks.h"
+
+#if UTL_ARCH_x86_64
+#  include "utl/hardware/x86/utl_cpuid.h"
+#endif
+
+UTL_NAMESPACE_BEGIN
+
+namespace tempus {
+namespace {
+
+/**
+ * Length of the initial measurement if the hardware does not report the frequency
+ */
+constexpr int64_t measure_ns = 5000000;
+/**
+ * Resync intervals, the interval doubles after each resync up to the maximum
+ */
+constexpr int64_t first_interval_ns = 10000000;
+constexpr int64_t max_interval_ns = 1000000000;
+/**
+ * Lag beyond which the clock steps forwards instead of catching up
+ */
+constexpr int64_t max_lag_ns = 1000000;
+/**
+ * Reads racing a resync see the new mapping at least this long after its base, a lower rate is
+ * offset so that it does not fall behind the old mapping within that time
+ */
+constexpr double guard_ns = 1000.0;
+constexpr int64_t never = INT64_MAX;
+constexpr int64_t always = INT64_MIN;
+
+struct mapping_t {
+    calibration value;
+    int64_t resync_at;
+};
+
+struct sample_t {
+    int64_t ticks;
+    int64_t ns;
+};
+
+/**
+ * Constant initialized, so that the clock may be read by static constructors
+ */
+struct clock_state {
+    /**
+     * Seqlock over the mapping, odd while the mapping is written
+     */
+    uint32_t sequence;
+    int64_t base_ticks;
+    int64_t base_ns;
+    uint64_t mult;
+    int64_t resync_at;
+    /**
+     * Set if the counter is unreliable, the clock then reads the steady clock
+     */
+    uint32_t fallback;
+    uint64_t frequency;
+
+    /**
+     * Serializes calibration and resyncs, guards the members below
+     */
+    mutex lock;
+    sample_t synced;
+    /**
+     * Measured nanoseconds per tick
+     */
+    double rate;
+    int64_t interval_ns;
+};
+
+clock_state state = {};
+
+int64_t steady_ns() noexcept {
+    auto const now = get_time(tempus::steady_clock).time_since_epoch();
+    return static_cast<int64_t>(now.seconds()) * 1000000000 + now.nanoseconds();
+}
+
+/**
+ * @return whether the counter runs at a constant rate, regardless of power states
+ */
+bool invariant_counter() noexcept {
+#if UTL_ARCH_x86_64
+    if (x86::cpuid<0x80000000>().eax < 0x80000007) {
+        return false;
+    }
+
+    return (x86::cpuid<0x80000007>().edx & (1 << 8)) != 0;
+#elif UTL_ARCH_AARCH64
+    return true;
+#else
+    return false;
+#endif
+}
+
+mapping_t load() noexcept {
+    while (true) {
+        uint32_t const sequence = atomic_acquire::load(&state.sequence);
+        mapping_t const result = {
+            {atomic_relaxed::load(&state.base_ticks), atomic_relaxed::load(&state.base_ns),
+                atomic_relaxed::load(&state.mult)},
+            atomic_relaxed::load(&state.resync_at)
+        };
+        atomic_acquire::thread_fence();
+        if ((sequence & 1) == 0 && atomic_relaxed::load(&state.sequence) == sequence) {
+            return result;
+        }
+    }
+}
+
+void publish(mapping_t const& mapping) noexcept {
+    uint32_t const sequence = atomic_relaxed::load(&state.sequence);
+    atomic_relaxed::store(&state.sequence, sequence + 1);
+    atomic_release::thread_fence();
+    atomic_relaxed::store(&state.base_ticks, mapping.value.base_ticks);
+    atomic_relaxed::store(&state.base_ns, mapping.value.base_ns);
+    atomic_relaxed::store(&state.mult, mapping.value.mult);
+    atomic_relaxed::store(&state.resync_at, mapping.resync_at);
+    atomic_release::store(&state.sequence, sequence + 2);
+}
+
+/**
+ * @return a reading of the steady clock paired with the counter at the middle of the call, the
+ * tightest of a few attempts so that a preempted read is discarded
+ */
+sample_t measure() noexcept {
+    sample_t result = {0, 0};
+    int64_t width = never;
+    for (int attempt = 0; attempt != 3; ++attempt) {
+        int64_t const before = calibrated_clock::ticks();
+        int64_t const ns = steady_ns();
+        int64_t const after = calibrated_clock::ticks();
+        if (after - before < width) {
+            width = after - before;
+            result = {before + width / 2, ns};
+        }
+    }
+
+    return result;
+}
+
+uint64_t to_mult(double rate) noexcept {
+    return static_cast<uint64_t>(rate * 4294967296.0 + 0.5);
+}
+
+void publish_rate(double rate) noexcept {
+    atomic_relaxed::store(&state.frequency, static_cast<uint64_t>(1e9 / rate + 0.5));
+}
+
+void initialize_locked() noexcept {
+#if UTL_ARCH_x86_64 || UTL_ARCH_AARCH64
+    bool const fallback = !invariant_counter();
+    sample_t const first = measure();
+    double rate;
+    if (!fallback && hardware_ticks::invariant_frequency()) {
+        rate = 1e9 / static_cast<double>(hardware_ticks::frequency());
+        state.synced = first;
+    } else {
+        while (steady_ns() - first.ns < measure_ns) {}
+        state.synced = measure();
+        rate = static_cast<double>(state.synced.ns - first.ns) /
+            static_cast<double>(state.synced.ticks - first.ticks);
+    }
+
+    state.rate = rate;
+    state.interval_ns = first_interval_ns;
+    publish_rate(rate);
+    atomic_relaxed::store(&state.fallback, uint32_t(fallback));
+    // Without an invariant counter every read takes the slow path to the steady clock, the
+    // mapping is only kept for `current`
+    publish({
+        {state.synced.ticks, state.synced.ns, to_mult(rate)},
+        fallback ? always : state.synced.ticks + static_cast<int64_t>(first_interval_ns / rate)
+    });
+#else
+    // Ticks are already steady nanoseconds
+    state.rate = 1.0;
+    publish_rate(1.0);
+    publish({
+        {0, 0, uint64_t(1) << calibration::shift},
+        never
+    });
+#endif
+}
+
+/**
+ * Remeasures the rate and steers the mapping back to the steady clock by the next resync
+ */
+void resync_locked(mapping_t const& current, sample_t const& now) noexcept {
+    if (now.ticks - state.synced.ticks > 0) {
+        state.rate = static_cast<double>(now.ns - state.synced.ns) /
+            static_cast<double>(now.ticks - state.synced.ticks);
+        publish_rate(state.rate);
+    }
+
+    state.synced = now;
+    state.interval_ns = state.interval_ns * 2 < max_interval_ns ? state.interval_ns * 2
+                                                                 : max_interval_ns;
+
+    double const rate = state.rate;
+    double const interval_ticks = static_cast<double>(state.interval_ns) / rate;
+    // Read last so that readers still on the old mapping do not run ahead of the new one if the
+    // resync was preempted
+    int64_t const base_ticks = calibrated_clock::ticks();
+    int64_t const steady =
+        now.ns + static_cast<int64_t>(static_cast<double>(base_ticks - now.ticks) * rate);
+    int64_t const estimate = current.value.to_nanoseconds(base_ticks);
+    int64_t const lag = steady - estimate;
+    int64_t base_ns = estimate;
+    double slope = rate;
+    if (lag > max_lag_ns) {
+        base_ns = steady;
+    } else {
+        // Clamped so that the clock keeps advancing at least at half the rate
+        slope += static_cast<double>(lag) / interval_ticks;
+        slope = slope < rate / 2 ? rate / 2 : slope > rate * 2 ? rate * 2 : slope;
+        double const previous = static_cast<double>(current.value.mult) / 4294967296.0;
+        if (slope < previous) {
+            base_ns += static_cast<int64_t>((previous - slope) * guard_ns / rate + 1.0);
+        }
+    }
+
+    publish({
+        {base_ticks, base_ns, to_mult(slope)},
+        base_ticks + static_cast<int64_t>(interval_ticks)
+    });
+}
+
+/**
+ * Calibrates if needed, then resyncs if `force`d or due
+ */
+void sync_locked(bool force) noexcept {
+    mapping_t const current = load();
+    if (current.value.mult == 0) {
+        initialize_locked();
+        return;
+    }
+
+    if (atomic_relaxed::load(&state.fallback) != 0 || current.resync_at == never) {
+        return;
+    }
+
+    sample_t const now = measure();
+    if (force || now.ticks >= current.resync_at) {
+        resync_locked(current, now);
+    }
+}
+
+UTL_ATTRIBUTE(NOINLINE) int64_t now_ns_slow(int64_t now, mapping_t const& current) noexcept {
+    if (atomic_relaxed::load(&state.fallback) != 0) {
+        return steady_ns();
+    }
+
+    if (!state.lock.try_lock()) {
+        // Another thread is resyncing, the current mapping remains valid until it is done
+        return current.value.mult != 0 ? current.value.to_nanoseconds(now) : steady_ns();
+    }
+
+    sync_locked(false);
+    state.lock.unlock();
+    if (atomic_relaxed::load(&state.fallback) != 0) {
+        return steady_ns();
+    }
+
+    return load().value.to_nanoseconds(calibrated_clock::ticks());
+}
+
+} // namespace
+
+int64_t calibrated_clock::now_ns() noexcept {
+    // The counter is read after the mapping, a later mapping is based past the resync point of the
+    // current one, so a read delayed between the two never converts ticks past a newer base
+    mapping_t const current = load();
+    int64_t const now = ticks();
+    if (now >= current.resync_at) UTL_UNLIKELY {
+        return now_ns_slow(now, current);
+    }
+
+    return current.value.to_nanoseconds(now);
+}
+
+calibration calibrated_clock::current() noexcept {
+    calibrate();
+    return load().value;
+}
+
+uint64_t calibrated_clock::frequency() noexcept {
+    calibrate();
+    return atomic_relaxed::load(&state.frequency);
+}
+
+void calibrated_clock::calibrate() noexcept {
+    if (load().value.mult != 0) UTL_LIKELY {
+        return;
+    }
+
+    state.lock.lock();
+    sync_locked(false);
+    state.lock.unlock();
+}
+
+void calibrated_clock::resync() noexcept {
+    state.lock.lock();
+    sync_locked(true);
+    state.lock.unlock();
+}
+
+} // namespace tempus
+
+UTL_NAMESPACE_END
@@ -0,0 +1,96 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/tempus/utl_coarse_clock.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/atomic/utl_futex.h"
+#include "utl/sync/utl_mutex.h"
+
+#include "execution/threads.h"
+
+UTL_NAMESPACE_BEGIN
+
+namespace tempus {
+namespace {
+
+/**
+ * Constant initialized, so that the clock may be read by static constructors
+ */
+struct ticker_state {
+    /**
+     * Guards `start` and `stop`
+     */
+    mutex lock;
+    bool running;
+    uint32_t stopping;
+    int64_t interval_ns;
+    execution::threads::handle thread;
+};
+
+ticker_state ticker = {};
+
+int64_t steady_ns() noexcept {
+    auto const now = get_time(tempus::steady_clock).time_since_epoch();
+    return static_cast<int64_t>(now.seconds()) * 1000000000 + now.nanoseconds();
+}
+
+} // namespace
+
+int64_t coarse_clock_t::published_ = 0;
+
+int64_t coarse_clock_t::fallback() noexcept {
+    return steady_ns();
+}
+
+void coarse_clock_t::run(void*) noexcept {
+    tempus::duration const interval(
+        ticker.interval_ns / 1000000000, ticker.interval_ns % 1000000000);
+    while (atomic_acquire::load(&ticker.stopping) == 0) {
+        (void)__UTL futex::wait(&ticker.stopping, uint32_t(0), interval);
+        atomic_relaxed::store(&published_, steady_ns());
+    }
+}
+
+bool coarse_clock_t::start(duration interval) noexcept {
+    static execution::threads::launch const tick_launch = {&run, nullptr};
+    if (!interval || (interval.seconds() == 0 && interval.nanoseconds() == 0)) {
+        return false;
+    }
+
+    ticker.lock.lock();
+    if (ticker.running) {
+        ticker.lock.unlock();
+        return false;
+    }
+
+    ticker.interval_ns = static_cast<int64_t>(interval.seconds()) * 1000000000 +
+        interval.nanoseconds();
+    atomic_relaxed::store(&ticker.stopping, uint32_t(0));
+    atomic_relaxed::store(&published_, steady_ns());
+    if (execution::threads::start(ticker.thread, tick_launch) != 0) {
+        atomic_relaxed::store(&published_, int64_t(0));
+        ticker.lock.unlock();
+        return false;
+    }
+
+    ticker.running = true;
+    ticker.lock.unlock();
+    return true;
+}
+
+void coarse_clock_t::stop() noexcept {
+    ticker.lock.lock();
+    if (ticker.running) {
+        atomic_release::store(&ticker.stopping, uint32_t(1));
+        __UTL futex::notify_all(&ticker.stopping);
+        execution::threads::join(ticker.thread);
+        // Reads fall back to the steady clock, which is ahead of the last published time
+        atomic_relaxed::store(&published_, int64_t(0));
+        ticker.running = false;
+    }
+    ticker.lock.unlock();
+}
+
+} // namespace tempus
+
+UTL_NAMESPACE_END
@@ -0,0 +1,188 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/tempus/utl_histogram.h"
+
+#include "utl/assert/utl_assert.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/utility/utl_move.h"
+
+#include <math.h>
+#include <string.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace tempus {
+
+using details::histogram::bucket_count;
+using details::histogram::highest_of;
+using details::histogram::lowest_of;
+
+histogram::histogram() noexcept : shards_(nullptr) {}
+
+histogram::~histogram() noexcept {
+    for (shard* current = shards_; current != nullptr;) {
+        shard* const next = current->next;
+        UTL_ASSERT(current->in_use == 0);
+        delete current;
+        current = next;
+    }
+}
+
+histogram::shard* histogram::acquire() UTL_THROWS {
+    for (shard* current = atomic_acquire::load(&shards_); current != nullptr;
+         current = current->next) {
+        uint32_t expected = 0;
+        if (atomic_relaxed::load(&current->in_use) == 0 &&
+            atomic_acquire::compare_exchange_strong(
+                &current->in_use, &expected, uint32_t(1), atomics::relaxed_failure)) {
+            return current;
+        }
+    }
+
+    shard* const result = new shard();
+    result->min = uint64_t(-1);
+    result->in_use = 1;
+    result->next = atomic_relaxed::load(&shards_);
+    while (!atomic_release::compare_exchange_weak(
+        &shards_, &result->next, result, atomics::relaxed_failure)) {}
+    return result;
+}
+
+histogram::snapshot histogram::read() const UTL_THROWS {
+    snapshot result;
+    for (shard const* current = atomic_acquire::load(&shards_); current != nullptr;
+         current = current->next) {
+        // The total is published after the buckets, loading it first never counts a value that is
+        // missing from the buckets
+        uint64_t const total = atomic_acquire::load(&current->total);
+        if (total == 0) {
+            continue;
+        }
+
+        if (result.counts_ == nullptr) {
+            result.counts_ = new uint64_t[bucket_count]();
+            result.min_ = uint64_t(-1);
+        }
+
+        for (size_t idx = 0; idx != bucket_count; ++idx) {
+            result.counts_[idx] += atomic_relaxed::load(&current->counts[idx]);
+        }
+
+        result.total_ += total;
+        result.min_ = __UTL numeric::min(result.min_, atomic_relaxed::load(&current->min));
+        result.max_ = __UTL numeric::max(result.max_, atomic_relaxed::load(&current->max));
+    }
+
+    return result;
+}
+
+histogram::snapshot::snapshot(snapshot const& other) UTL_THROWS
+    : counts_(nullptr)
+    , total_(other.total_)
+    , min_(other.min_)
+    , max_(other.max_) {
+    if (other.counts_ != nullptr) {
+        counts_ = new uint64_t[bucket_count];
+        memcpy(counts_, other.counts_, bucket_count * sizeof(uint64_t));
+    }
+}
+
+histogram::snapshot& histogram::snapshot::operator=(snapshot const& other) UTL_THROWS {
+    if (this != &other) {
+        snapshot copy(other);
+        *this = __UTL move(copy);
+    }
+
+    return *this;
+}
+
+histogram::snapshot& histogram::snapshot::operator=(snapshot&& other) noexcept {
+    if (this != &other) {
+        delete[] counts_;
+        counts_ = other.counts_;
+        total_ = other.total_;
+        min_ = other.min_;
+        max_ = other.max_;
+        other.counts_ = nullptr;
+        other.total_ = 0;
+    }
+
+    return *this;
+}
+
+histogram::snapshot::~snapshot() noexcept {
+    delete[] counts_;
+}
+
+void histogram::snapshot::merge(snapshot const& other) UTL_THROWS {
+    if (other.counts_ != nullptr) {
+        add(other.counts_, other.total_, other.min_, other.max_);
+    }
+}
+
+void histogram::snapshot::add(
+    uint64_t const* counts, uint64_t total, uint64_t min, uint64_t max) UTL_THROWS {
+    if (counts_ == nullptr) {
+        counts_ = new uint64_t[bucket_count]();
+        min_ = min;
+        max_ = max;
+    }
+
+    for (size_t idx = 0; idx != bucket_count; ++idx) {
+        counts_[idx] += counts[idx];
+    }
+
+    total_ += total;
+    min_ = __UTL numeric::min(min_, min);
+    max_ = __UTL numeric::max(max_, max);
+}
+
+double histogram::snapshot::mean() const noexcept {
+    if (total_ == 0) {
+        return 0;
+    }
+
+    double sum = 0;
+    uint64_t counted = 0;
+    for (size_t idx = 0; idx != bucket_count; ++idx) {
+        if (counts_[idx] != 0) {
+            double const middle =
+                (static_cast<double>(lowest_of(idx)) + static_cast<double>(highest_of(idx))) / 2;
+            sum += middle * static_cast<double>(counts_[idx]);
+            counted += counts_[idx];
+        }
+    }
+
+    return sum / static_cast<double>(counted);
+}
+
+uint64_t histogram::snapshot::value_at(double quantile) const noexcept {
+    if (total_ == 0) {
+        return 0;
+    }
+
+    quantile = __UTL numeric::min(__UTL numeric::max(quantile, 0.0), 1.0);
+    // Rank of the value, counted from 1
+    uint64_t const rank = __UTL numeric::max(
+        static_cast<uint64_t>(ceil(quantile * static_cast<double>(total_))), uint64_t(1));
+    uint64_t seen = 0;
+    for (size_t idx = 0; idx != bucket_count; ++idx) {
+        seen += counts_[idx];
+        if (seen >= rank) {
+            return __UTL numeric::min(highest_of(idx), max_);
+        }
+    }
+
+    return max_;
+}
+
+histogram::recorder::recorder(histogram& owner) UTL_THROWS : shard_(owner.acquire()) {}
+
+histogram::recorder::~recorder() noexcept {
+    atomic_release::store(&shard_->in_use, uint32_t(0));
+}
+
+} // namespace tempus
+
+UTL_NAMESPACE_END
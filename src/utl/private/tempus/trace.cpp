@@ -0,0 +1,379 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/tempus/utl_trace.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/atomic/utl_futex.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/sync/utl_mutex.h"
+#include "utl/sync/utl_spsc_ring.h"
+#include "utl/tempus/utl_duration.h"
+
+#include "execution/threads.h"
+
+#include <new>
+
+UTL_NAMESPACE_BEGIN
+
+namespace tempus {
+namespace trace {
+namespace {
+
+/**
+ * Capacity of the buffer of each thread
+ */
+constexpr size_t buffer_events = 4096;
+
+/**
+ * Ring written by one thread and read by the drain, buffers are reused by later threads and never
+ * freed so that the drain may read a buffer while its thread exits
+ */
+struct buffer {
+    spsc_ring<event, buffer_events> events;
+    buffer* next;
+    uint32_t thread;
+    uint32_t in_use;
+    /**
+     * Only written by the owning thread
+     */
+    uint64_t dropped;
+};
+
+constexpr size_t chunk_events = 4096;
+
+struct chunk {
+    chunk* next;
+    size_t size;
+    event events[chunk_events];
+};
+
+/**
+ * Constant initialized and trivially destructible, so that probes in static constructors and
+ * destructors remain valid
+ */
+struct session_state {
+    uint32_t enabled;
+    uint32_t stopping;
+    /**
+     * Drain thread state, 0 if none, 1 while running, 2 while `stop` joins it
+     */
+    uint32_t draining;
+    uint32_t next_thread;
+    buffer* buffers;
+    execution::threads::handle drainer;
+    uint64_t interval_ns;
+    size_t max_chunks;
+
+    /**
+     * Guards the members below and serializes the drain, the single consumer of every buffer
+     */
+    mutex lock;
+    chunk* head;
+    chunk* tail;
+    size_t chunks;
+    uint64_t overwritten;
+    /**
+     * Sum of the drop counters of the buffers at the last `clear`
+     */
+    uint64_t cleared;
+    bool has_origin;
+    int64_t origin_ticks;
+};
+
+session_state session = {};
+
+thread_local buffer* current = nullptr;
+thread_local bool exited = false;
+
+bool claim(buffer* candidate) noexcept {
+    uint32_t expected = 0;
+    return atomic_relaxed::load(&candidate->in_use) == 0 &&
+        atomic_acquire::compare_exchange_strong(
+            &candidate->in_use, &expected, uint32_t(1), atomics::relaxed_failure);
+}
+
+buffer* acquire() noexcept {
+    // Only drained buffers are reused, so that events left by an exited thread are not dropped
+    // for lack of capacity
+    buffer* result = nullptr;
+    for (buffer* candidate = atomic_acquire::load(&session.buffers);
+         candidate != nullptr && result == nullptr; candidate = candidate->next) {
+        if (candidate->events.empty() && claim(candidate)) {
+            result = candidate;
+        }
+    }
+
+    if (result == nullptr) {
+        UTL_TRY {
+            result = new buffer();
+        } UTL_CATCH(...) {
+            return nullptr;
+        }
+
+        result->in_use = 1;
+        result->next = atomic_relaxed::load(&session.buffers);
+        while (!atomic_release::compare_exchange_weak(
+            &session.buffers, &result->next, result, atomics::relaxed_failure)) {}
+    }
+
+    result->thread = atomic_relaxed::fetch_add(&session.next_thread, uint32_t(1)) + 1;
+    return result;
+}
+
+/**
+ * Releases the buffer of the thread on exit, events still buffered are drained later
+ */
+struct owner {
+    ~owner() noexcept {
+        if (current != nullptr) {
+            atomic_release::store(&current->in_use, uint32_t(0));
+            current = nullptr;
+        }
+        exited = true;
+    }
+};
+
+buffer* local() noexcept {
+    if (current != nullptr) UTL_LIKELY {
+        return current;
+    }
+
+    if (exited) {
+        return nullptr;
+    }
+
+    static thread_local owner registration;
+    (void)registration;
+    current = acquire();
+    return current;
+}
+
+/**
+ * @return a chunk with free space, recycling the oldest chunk once the limit is reached
+ */
+chunk* writable_chunk() noexcept {
+    if (session.tail != nullptr && session.tail->size != chunk_events) {
+        return session.tail;
+    }
+
+    chunk* result = nullptr;
+    if (session.chunks < session.max_chunks) {
+        result = new (std::nothrow) chunk;
+        if (result != nullptr) {
+            ++session.chunks;
+        }
+    }
+
+    if (result == nullptr) {
+        if (session.head == nullptr) {
+            return nullptr;
+        }
+
+        result = session.head;
+        session.head = result->next;
+        session.overwritten += result->size;
+        if (session.head == nullptr) {
+            session.tail = nullptr;
+        }
+    }
+
+    result->next = nullptr;
+    result->size = 0;
+    if (session.tail != nullptr) {
+        session.tail->next = result;
+    } else {
+        session.head = result;
+    }
+    session.tail = result;
+    return result;
+}
+
+void drain_locked() noexcept {
+    for (buffer* source = atomic_acquire::load(&session.buffers); source != nullptr;
+         source = source->next) {
+        while (!source->events.empty()) {
+            chunk* const target = writable_chunk();
+            if (target == nullptr) {
+                event discarded[64];
+                session.overwritten += source->events.try_pop_n(discarded, 64);
+                continue;
+            }
+
+            target->size += source->events.try_pop_n(
+                target->events + target->size, chunk_events - target->size);
+        }
+    }
+}
+
+void write_name(FILE* file, char const* name) noexcept {
+    for (; *name != '\0'; ++name) {
+        unsigned char const value = static_cast<unsigned char>(*name);
+        if (value == '"' || value == '\\') {
+            fputc('\\', file);
+            fputc(value, file);
+        } else if (value < 0x20) {
+            fprintf(file, "\\u%04x", value);
+        } else {
+            fputc(value, file);
+        }
+    }
+}
+
+void drain_main(void*) noexcept {
+    while (atomic_acquire::load(&session.stopping) == 0) {
+        drain();
+        (void)__UTL futex::wait(&session.stopping, uint32_t(0),
+            tempus::duration(static_cast<int64_t>(session.interval_ns / 1000000000),
+                static_cast<int64_t>(session.interval_ns % 1000000000)));
+    }
+}
+
+execution::threads::launch const drain_launch = {&drain_main, nullptr};
+
+} // namespace
+
+namespace details {
+bool enabled() noexcept {
+    return atomic_relaxed::load(&session.enabled) != 0;
+}
+
+void record(char const* name, int64_t begin, int64_t end) noexcept {
+    buffer* const target = local();
+    if (target == nullptr) UTL_UNLIKELY {
+        return;
+    }
+
+    if (!target->events.try_emplace(event{name, begin, end, target->thread})) UTL_UNLIKELY {
+        atomic_relaxed::store(&target->dropped, atomic_relaxed::load(&target->dropped) + 1);
+    }
+}
+} // namespace details
+
+bool start(options const& config) noexcept {
+    session.lock.lock();
+    if (atomic_relaxed::load(&session.enabled) != 0 || session.draining != 0) {
+        session.lock.unlock();
+        return false;
+    }
+
+    session.interval_ns = config.drain_interval_ns;
+    session.max_chunks = __UTL numeric::max((config.max_events + chunk_events - 1) / chunk_events,
+        size_t(1));
+    if (!session.has_origin) {
+        session.origin_ticks = details::now();
+        session.has_origin = true;
+    }
+
+    if (config.drain_interval_ns != 0) {
+        atomic_relaxed::store(&session.stopping, uint32_t(0));
+        if (execution::threads::start(session.drainer, drain_launch) != 0) {
+            session.lock.unlock();
+            return false;
+        }
+        session.draining = 1;
+    }
+
+    atomic_relaxed::store(&session.enabled, uint32_t(1));
+    session.lock.unlock();
+    return true;
+}
+
+void stop() noexcept {
+    session.lock.lock();
+    atomic_relaxed::store(&session.enabled, uint32_t(0));
+    bool const draining = session.draining == 1;
+    if (draining) {
+        session.draining = 2;
+    }
+    session.lock.unlock();
+
+    // The drain thread takes the lock, so it is joined without holding it
+    if (draining) {
+        atomic_release::store(&session.stopping, uint32_t(1));
+        __UTL futex::notify_all(&session.stopping);
+        execution::threads::join(session.drainer);
+        session.lock.lock();
+        session.draining = 0;
+        session.lock.unlock();
+    }
+
+    drain();
+}
+
+void drain() noexcept {
+    session.lock.lock();
+    drain_locked();
+    session.lock.unlock();
+}
+
+void clear() noexcept {
+    session.lock.lock();
+    drain_locked();
+    for (chunk* current = session.head; current != nullptr;) {
+        chunk* const next = current->next;
+        delete current;
+        current = next;
+    }
+
+    session.head = nullptr;
+    session.tail = nullptr;
+    session.chunks = 0;
+    session.overwritten = 0;
+    session.cleared = 0;
+    // The counters of the buffers are owned by their threads and are never reset
+    for (buffer* source = atomic_acquire::load(&session.buffers); source != nullptr;
+         source = source->next) {
+        session.cleared += atomic_relaxed::load(&source->dropped);
+    }
+
+    if (atomic_relaxed::load(&session.enabled) == 0) {
+        session.has_origin = false;
+    }
+    session.lock.unlock();
+}
+
+uint64_t dropped() noexcept {
+    session.lock.lock();
+    uint64_t result = session.overwritten - session.cleared;
+    for (buffer* source = atomic_acquire::load(&session.buffers); source != nullptr;
+         source = source->next) {
+        result += atomic_relaxed::load(&source->dropped);
+    }
+    session.lock.unlock();
+    return result;
+}
+
+bool write_chrome_trace(FILE* file) noexcept {
+    session.lock.lock();
+    drain_locked();
+    calibration const mapping = calibrated_clock::current();
+    int64_t const origin = mapping.to_nanoseconds(session.origin_ticks);
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+    char const* separator = "\n";
+    for (chunk const* current = session.head; current != nullptr; current = current->next) {
+        for (size_t idx = 0; idx != current->size; ++idx) {
+            event const& value = current->events[idx];
+            int64_t const begin = mapping.to_nanoseconds(value.begin);
+            fputs(separator, file);
+            fputs("{\"name\":\"", file);
+            write_name(file, value.name);
+            fprintf(file,
+                "\",\"cat\":\"utl\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                static_cast<double>(begin - origin) / 1000.0,
+                static_cast<double>(mapping.to_nanoseconds(value.end) - begin) / 1000.0,
+                value.thread);
+            separator = ",\n";
+        }
+    }
+
+    fputs("\n]}\n", file);
+    bool const result = fflush(file) == 0 && ferror(file) == 0;
+    session.lock.unlock();
+    return result;
+}
+
+} // namespace trace
+} // namespace tempus
+
+UTL_NAMESPACE_END
@@ -19,7 +19,7 @@ x86::cpuid_t cached_cpuid() noexcept {
 }
 
 struct tsc_frequency_t {
-    unsigned int value;
+    uint64_t value;
     bool supported;
 };
 
@@ -110,14 +110,14 @@ tsc_frequency_t tsc_frequency() noexcept {
 
         auto const freq = tsc.ecx ? tsc.ecx : crystal_clock_frequency();
         if (freq) {
-            return {freq * tsc.ebx / tsc.eax, true};
+            return {uint64_t(freq) * tsc.ebx / tsc.eax, true};
         }
 
         if (cached_cpuid<0>().eax < 0x16) {
             return {0, false};
         }
 
-        auto const base_frequency = (cached_cpuid<0x16>().eax & 0xFFFF) * 1000000;
+        auto const base_frequency = uint64_t(cached_cpuid<0x16>().eax & 0xFFFF) * 1000000;
         return {base_frequency, true};
     }();
 
@@ -0,0 +1,24 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/atomic/utl_futex.h"
+
+#if UTL_TARGET_LINUX
+
+static_assert(sizeof(utl::futex::waitv_entry) == 24, "");
+
+utl::error_code func(unsigned int* first, unsigned int* second) {
+    auto const deadline = get_time(utl::tempus::steady_clock);
+    auto result = utl::futex::wait_until(first, 0u, deadline);
+    result = utl::futex::wait_bitset(first, 0u, 1u << 1, deadline);
+    utl::futex::wake_bitset(first, 1u << 1);
+
+    utl::futex::waitv_entry const entries[] = {
+        {first, 0u},
+        {second, 0u}
+    };
+    size_t woken = 0;
+    result = utl::futex::wait_any(entries, 2, woken, get_time(utl::tempus::system_clock));
+    return result;
+}
+
+#endif // UTL_TARGET_LINUX
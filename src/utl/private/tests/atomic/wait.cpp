@@ -0,0 +1,32 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/atomic/utl_atomic_type.h"
+
+struct alignas(8) Pair {
+    int first;
+    int second;
+};
+
+static_assert(alignof(utl::atomic<long long>) == sizeof(long long), "");
+static_assert(sizeof(utl::atomic<Pair>) == sizeof(Pair), "");
+
+void func(utl::atomic<int>& a) {
+    int expected = a.load(utl::memory_order_acquire);
+    a.compare_exchange_strong(expected, expected + 1, utl::memory_order_acq_rel);
+    a.fetch_add(1, utl::memory_order_relaxed);
+    a.wait(expected, utl::memory_order_acquire);
+    a.notify_one();
+}
+
+void func(utl::atomic<Pair>& a) {
+    Pair const old = a.exchange(Pair{1, 2}, utl::memory_order_release);
+    a.notify_all();
+    a.wait(old);
+}
+
+void func(unsigned long long& value) {
+    utl::atomic_ref<unsigned long long> ref(value);
+    ref |= 1;
+    ref.notify_all();
+    ref.wait(0, utl::memory_order_relaxed);
+}
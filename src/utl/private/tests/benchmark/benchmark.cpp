@@ -0,0 +1,25 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/benchmark.h"
+
+static_assert(sizeof(utl::benchmark::state::value) == 1, "");
+
+uint64_t func(utl::benchmark::state& state) {
+    uint64_t sum = 0;
+    state.set_items_per_iteration(2);
+    for (auto _ : state) {
+        state.pause_timing();
+        sum += state.iterations();
+        state.resume_timing();
+        utl::benchmark::do_not_optimize(sum);
+        utl::benchmark::clobber_memory();
+    }
+
+    return sum + static_cast<uint64_t>(state.elapsed_ticks());
+}
+
+utl::benchmark::result func(utl::benchmark::function_type function) {
+    utl::benchmark::options config;
+    config.repetitions = 5;
+    return utl::benchmark::run("func", function, config);
+}
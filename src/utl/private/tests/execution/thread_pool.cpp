@@ -0,0 +1,18 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/execution.h"
+
+static_assert(sizeof(utl::wait_group) == 4, "");
+
+void func(utl::thread_pool& pool, int* values, size_t count) {
+    utl::wait_group group;
+    pool.submit(group, [values]() { values[0] = 1; });
+    pool.submit([]() {});
+    pool.wait(group);
+
+    pool.parallel_for(0, count, 1024, [values](size_t first, size_t last) {
+        for (; first != last; ++first) {
+            values[first] *= 2;
+        }
+    });
+}
@@ -0,0 +1,20 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/hash/utl_hash.h"
+#include "utl/hash/utl_wyhash.h"
+
+// utl_wyhash
+static_assert(utl::hashing::wyhash("abc", 3) != utl::hashing::wyhash("abd", 3), "");
+static_assert(utl::hashing::wyhash("abc", 3) != utl::hashing::wyhash("abc", 2), "");
+static_assert(utl::hashing::wyhash("abc", 3, 1) != utl::hashing::wyhash("abc", 3, 2), "");
+static_assert(utl::hashing::wyhash("", 0) != utl::hashing::wyhash("", 0, 1), "");
+static_assert(utl::hashing::wyhash("0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdef", 52) !=
+        utl::hashing::wyhash("0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdeg", 52),
+    "");
+static_assert(utl::hashing::wyhash(u"ab", 2) == utl::hashing::wyhash("a\0b\0", 4), "");
+
+// utl_hash
+static_assert(utl::hash<utl::string_view>{}("key") == utl::hashing::string_hash{}("key"), "");
+static_assert(utl::hash<utl::string_view>{}("key") != utl::hash<utl::string_view>{}("kez"), "");
+static_assert(utl::hash<utl::string_view>{1}("key") != utl::hash<utl::string_view>{2}("key"), "");
+static_assert(utl::hash<utl::string_view>{3}.seed() == 3, "");
@@ -0,0 +1,41 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_allocator_traits.h"
+#include "utl/memory/utl_arena_allocator.h"
+#include "utl/memory/utl_monotonic_arena.h"
+#include "utl/type_traits/utl_is_trivially_relocatable.h"
+
+#include <vector>
+
+namespace {
+struct relocatable {
+    relocatable(relocatable&&) noexcept;
+    ~relocatable();
+};
+} // namespace
+
+UTL_NAMESPACE_BEGIN
+template <>
+struct is_trivially_relocatable<relocatable> : true_type {};
+UTL_NAMESPACE_END
+
+void func(utl::monotonic_arena& arena) {
+    utl::arena_allocator<int> a(arena);
+    using traits = utl::allocator_traits<utl::arena_allocator<int>>;
+    auto result = traits::allocate_at_least(a, 3);
+    result = traits::reallocate_at_least(a, result, 100);
+    traits::deallocate(a, result.ptr, result.size);
+    arena.reset();
+}
+
+void func(utl::arena_allocator<relocatable> a) {
+    using traits = utl::allocator_traits<utl::arena_allocator<relocatable>>;
+    auto result = traits::allocate_at_least(a, 3);
+    result = traits::reallocate_at_least(a, result, 100);
+    traits::deallocate(a, result.ptr, result.size);
+}
+
+void func(std::vector<int, utl::arena_allocator<int>> v) {
+    v.reserve(100);
+    std::vector<int, utl::arena_allocator<int>> u(v);
+}
@@ -0,0 +1,20 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_allocator_traits.h"
+#include "utl/memory/utl_malloc_allocator.h"
+
+#include <string>
+#include <vector>
+
+void func() {
+    utl::malloc_allocator<char> a;
+    using traits = utl::allocator_traits<utl::malloc_allocator<char>>;
+    auto result = traits::allocate_at_least(a, 3);
+    result = traits::reallocate_at_least(a, result, 1024 * 1024);
+    traits::deallocate(a, result.ptr, result.size);
+}
+
+void func(std::vector<std::string, utl::malloc_allocator<std::string>> v) {
+    v.reserve(100);
+    std::vector<std::string, utl::malloc_allocator<std::string>> u(v);
+}
@@ -0,0 +1,18 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_allocator_traits.h"
+#include "utl/memory/utl_page_allocator.h"
+
+#include <vector>
+
+void func() {
+    utl::page_allocator<char> a({utl::memory::pages::huge_pages::transparent, 0});
+    using traits = utl::allocator_traits<utl::page_allocator<char>>;
+    auto result = traits::allocate_at_least(a, 3);
+    traits::deallocate(a, result.ptr, result.size);
+}
+
+void func(std::vector<double, utl::page_allocator<double>> v) {
+    v.reserve(1024 * 1024);
+    std::vector<double, utl::page_allocator<double>> u(v);
+}
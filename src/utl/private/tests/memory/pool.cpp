@@ -0,0 +1,31 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_allocator_traits.h"
+#include "utl/memory/utl_pool_allocator.h"
+
+#include <vector>
+
+static_assert(utl::memory::pool::class_of(1) == 0, "");
+static_assert(utl::memory::pool::class_of(16) == 0, "");
+static_assert(utl::memory::pool::class_of(17) == 1, "");
+static_assert(utl::memory::pool::class_of(128) == 7, "");
+static_assert(utl::memory::pool::class_of(129) == 8, "");
+static_assert(utl::memory::pool::class_size(8) == 160, "");
+static_assert(utl::memory::pool::class_of(utl::memory::pool::max_bytes) ==
+        utl::memory::pool::class_count - 1,
+    "");
+static_assert(utl::memory::pool::class_size(utl::memory::pool::class_count - 1) ==
+        utl::memory::pool::max_bytes,
+    "");
+
+void func() {
+    utl::pool_allocator<int> a;
+    using traits = utl::allocator_traits<utl::pool_allocator<int>>;
+    auto result = traits::allocate_at_least(a, 3);
+    traits::deallocate(a, result.ptr, result.size);
+}
+
+void func(std::vector<int, utl::pool_allocator<int>> v) {
+    v.reserve(100);
+    std::vector<int, utl::pool_allocator<int>> u(v);
+}
@@ -0,0 +1,30 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/memory/utl_atomic_reference_count.h"
+#include "utl/memory/utl_epoch_domain.h"
+#include "utl/memory/utl_hazard_pointer.h"
+
+static_assert(sizeof(utl::memory::details::epoch::record) == 64, "");
+static_assert(sizeof(utl::memory::details::hazard::record) == 64, "");
+static_assert(sizeof(utl::hazard_pointer) == sizeof(void*), "");
+
+struct snapshot : utl::atomic_reference_count<snapshot> {
+    int value;
+};
+
+int func(utl::epoch_domain::participant& participant, snapshot*& shared) {
+    utl::epoch_domain::guard guard(participant);
+    snapshot* const next = new snapshot;
+    snapshot* const previous = utl::atomic_acq_rel::exchange(&shared, next);
+    participant.retire(previous);
+    return utl::atomic_acquire::load(&shared)->value;
+}
+
+int func(utl::hazard_domain& domain, snapshot*& shared) {
+    utl::hazard_pointer hazard = utl::make_hazard_pointer(domain);
+    snapshot* const current = hazard.protect(shared);
+    int const result = current->value;
+    hazard.reset_protection();
+    domain.retire(new int(result), [](int* ptr) { delete ptr; });
+    return result;
+}
@@ -0,0 +1,46 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/expected/utl_expected.h"
+#include "utl/memory/utl_relocate.h"
+#include "utl/tuple/utl_tuple.h"
+#include "utl/type_traits/utl_is_trivially_relocatable.h"
+#include "utl/utility/utl_pair.h"
+
+struct nontrivial {
+    nontrivial(nontrivial&&) noexcept;
+    ~nontrivial();
+};
+
+struct opted_in {
+    opted_in(opted_in&&) noexcept;
+    ~opted_in();
+};
+
+UTL_NAMESPACE_BEGIN
+template <>
+struct is_trivially_relocatable<opted_in> : true_type {};
+UTL_NAMESPACE_END
+
+static_assert(utl::is_trivially_relocatable<int>::value, "");
+static_assert(utl::is_trivially_relocatable<int const[4]>::value, "");
+static_assert(utl::is_trivially_relocatable<opted_in const[2][3]>::value, "");
+static_assert(!utl::is_trivially_relocatable<nontrivial>::value, "");
+static_assert(utl::is_trivially_relocatable<opted_in>::value, "");
+static_assert(utl::is_trivially_relocatable<utl::pair<opted_in, int&>>::value, "");
+static_assert(!utl::is_trivially_relocatable<utl::pair<opted_in, nontrivial>>::value, "");
+static_assert(utl::is_trivially_relocatable<utl::tuple<opted_in, int, char>>::value, "");
+static_assert(utl::is_trivially_relocatable<utl::expected<opted_in, int>>::value, "");
+static_assert(utl::is_trivially_relocatable<utl::expected<void, opted_in>>::value, "");
+static_assert(!utl::is_trivially_relocatable<utl::expected<nontrivial, int>>::value, "");
+
+void func(opted_in* first, opted_in* last, opted_in* d_first) {
+    d_first = utl::uninitialized_relocate(first, last, d_first);
+    utl::uninitialized_relocate_n(d_first, 3, first);
+    utl::relocate_at(first, d_first);
+}
+
+void func(nontrivial* first, nontrivial* last, nontrivial* d_first) {
+    d_first = utl::uninitialized_relocate(first, last, d_first);
+    utl::uninitialized_relocate_n(d_first, 3, first);
+    utl::relocate_at(first, d_first);
+}
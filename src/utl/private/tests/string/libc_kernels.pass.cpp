@@ -0,0 +1,501 @@
+// Copyright 2023-2024 Bryan Wong
+
+// Compares the vectorized string kernels against the scalar paths
+//
+// Test executables are linked on their own, so the kernels are compiled into this translation
+// unit, which also gives access to every instruction set tier rather than only the one selected
+// for the executing CPU.
+
+#include "string/arm_libc.cpp"
+#include "string/x86_libc.cpp"
+
+#include "utl/string/utl_libc_compile_time.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <stdint.h>
+#include <string.h>
+
+#if UTL_TARGET_UNIX
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace libc_kernels {
+
+using utl::libc::element_count_t;
+namespace compile_time = utl::libc::compile_time;
+namespace vectorized = utl::libc::runtime::vectorized;
+
+/**
+ * Widest vector used by any kernel in bytes, lengths are tested up to twice this many elements
+ */
+constexpr size_t vector_bytes = 32;
+constexpr size_t max_length = 2 * vector_bytes;
+constexpr size_t npos = size_t(-1);
+
+template <typename T>
+constexpr size_t lanes = vector_bytes / sizeof(T);
+
+template <typename T>
+T element(size_t idx) noexcept {
+    return T('a' + idx % 23);
+}
+
+/**
+ * Never produced by `element`, the high value also checks that elements compare unsigned
+ */
+template <typename T>
+constexpr T target = T('z');
+template <typename T>
+constexpr T high = T(~T());
+
+template <typename T>
+void fill(T* str, size_t count) noexcept {
+    for (size_t idx = 0; idx != count; ++idx) {
+        str[idx] = element<T>(idx);
+    }
+}
+
+int sign(int value) noexcept {
+    return (value > 0) - (value < 0);
+}
+
+template <typename T>
+size_t index_of(T const* str, T const* found) noexcept {
+    return found != nullptr ? size_t(found - str) : npos;
+}
+
+template <typename T>
+T const* reference_memrchr(T const* str, T ch, size_t count) noexcept {
+    while (count) {
+        --count;
+        if (str[count] == ch) {
+            return str + count;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+T const* reference_memmem(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    for (size_t idx = 0; m <= n && idx <= n - m; ++idx) {
+        if (::memcmp(haystack + idx, needle, m * sizeof(T)) == 0) {
+            return haystack + idx;
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+T const* reference_memrmem(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+    for (size_t idx = n - m + 1; m <= n && idx-- > 0;) {
+        if (::memcmp(haystack + idx, needle, m * sizeof(T)) == 0) {
+            return haystack + idx;
+        }
+    }
+
+    return nullptr;
+}
+
+template <bool Accept, bool Reverse, typename T>
+T const* reference_find_of(
+    T const* str, size_t count, T const* chars, size_t chars_count) noexcept {
+    for (size_t step = 0; step != count; ++step) {
+        size_t const idx = Reverse ? count - 1 - step : step;
+        bool const member =
+            compile_time::memchr(chars, str[idx], element_count_t(chars_count)) != nullptr;
+        if (member == Accept) {
+            return str + idx;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * The public entry points, which use the kernels selected for the executing CPU
+ */
+template <typename T>
+struct dispatched {
+    static constexpr size_t min_needle = 0;
+    static constexpr size_t max_needle = npos;
+
+    static T const* memchr(T const* str, T ch, size_t count) noexcept {
+        return vectorized::memchr(str, ch, element_count_t(count));
+    }
+    static size_t strlen(T const* str) noexcept { return vectorized::strlen(str); }
+    static T const* strnchr(T const* str, T ch, size_t count) noexcept {
+        return vectorized::strnchr(str, ch, element_count_t(count));
+    }
+    static int strncmp(T const* left, T const* right, size_t count) noexcept {
+        return vectorized::strncmp(left, right, element_count_t(count));
+    }
+    static T* strnset(T* dst, T value, size_t count) noexcept {
+        return vectorized::strnset(dst, value, element_count_t(count));
+    }
+    static T const* memrchr(T const* str, T ch, size_t count) noexcept {
+        return vectorized::memrchr(str, ch, element_count_t(count));
+    }
+    static T const* memmem(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+        return vectorized::memmem(haystack, element_count_t(n), needle, element_count_t(m));
+    }
+    static T const* memrmem(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+        return vectorized::memrmem(haystack, element_count_t(n), needle, element_count_t(m));
+    }
+    template <bool Accept, bool Reverse>
+    static T const* find_of(
+        T const* str, size_t count, T const* chars, size_t chars_count) noexcept {
+        auto const n = element_count_t(count);
+        auto const k = element_count_t(chars_count);
+        return Accept ? (Reverse ? vectorized::find_last_of(str, n, chars, k)
+                                 : vectorized::find_first_of(str, n, chars, k))
+                      : (Reverse ? vectorized::find_last_not_of(str, n, chars, k)
+                                 : vectorized::find_first_not_of(str, n, chars, k));
+    }
+};
+
+#if UTL_ARCH_x86
+/**
+ * A single tier of the x86 kernels, which only search for needles of up to
+ * `short_needle_length` elements themselves
+ */
+template <typename T>
+struct tier {
+    static vectorized::kernel_table<T> table;
+
+    static constexpr size_t min_needle = 2;
+    static constexpr size_t max_needle = vectorized::short_needle_length;
+
+    static T const* memchr(T const* str, T ch, size_t count) noexcept {
+        return table.memchr(str, ch, count);
+    }
+    static size_t strlen(T const* str) noexcept { return table.strlen(str); }
+    static T const* strnchr(T const* str, T ch, size_t count) noexcept {
+        return table.strnchr(str, ch, count);
+    }
+    static int strncmp(T const* left, T const* right, size_t count) noexcept {
+        return table.strncmp(left, right, count);
+    }
+    static T* strnset(T* dst, T value, size_t count) noexcept {
+        return table.strnset(dst, value, count);
+    }
+    static T const* memrchr(T const* str, T ch, size_t count) noexcept {
+        return table.memrchr(str, ch, count);
+    }
+    static T const* memmem(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+        return table.memmem_short(haystack, n, needle, m);
+    }
+    static T const* memrmem(T const* haystack, size_t n, T const* needle, size_t m) noexcept {
+        return table.memrmem_short(haystack, n, needle, m);
+    }
+    template <bool Accept, bool Reverse>
+    static T const* find_of(
+        T const* str, size_t count, T const* chars, size_t chars_count) noexcept {
+        vectorized::char_set<T> const set(chars, chars_count);
+        return Accept ? (Reverse ? table.find_last_of(str, count, set)
+                                 : table.find_first_of(str, count, set))
+                      : (Reverse ? table.find_last_not_of(str, count, set)
+                                 : table.find_first_not_of(str, count, set));
+    }
+};
+
+template <typename T>
+vectorized::kernel_table<T> tier<T>::table = {};
+#endif
+
+template <typename K, typename T>
+void check_memchr(T const* str, size_t count, T ch) {
+    assert(index_of(str, K::memchr(str, ch, count)) ==
+        index_of(str, compile_time::memchr(str, ch, element_count_t(count))));
+    assert(index_of(str, K::memrchr(str, ch, count)) ==
+        index_of(str, reference_memrchr(str, ch, count)));
+}
+
+template <typename K, typename T>
+void check_strnchr(T const* str, size_t count, T ch) {
+    assert(index_of(str, K::strnchr(str, ch, count)) ==
+        index_of(str, compile_time::strnchr(str, ch, element_count_t(count))));
+}
+
+template <typename K, typename T>
+void check_strncmp(T const* left, T const* right, size_t count) {
+    int const expected = compile_time::strncmp(left, right, element_count_t(count));
+    assert(sign(K::strncmp(left, right, count)) == expected);
+    assert(sign(K::strncmp(right, left, count)) == -expected);
+}
+
+template <typename K, typename T>
+void check_memmem(T const* haystack, size_t n, T const* needle, size_t m) {
+    if (m < K::min_needle || m > K::max_needle || (K::min_needle != 0 && m > n)) {
+        return;
+    }
+
+    assert(index_of(haystack, K::memmem(haystack, n, needle, m)) ==
+        index_of(haystack, reference_memmem(haystack, n, needle, m)));
+    assert(index_of(haystack, K::memrmem(haystack, n, needle, m)) ==
+        index_of(haystack, m == 0 ? haystack + n : reference_memrmem(haystack, n, needle, m)));
+}
+
+template <typename K, typename T>
+void check_find_of(T const* str, size_t count, T const* chars, size_t chars_count) {
+    assert(index_of(str, K::template find_of<true, false>(str, count, chars, chars_count)) ==
+        index_of(str, reference_find_of<true, false>(str, count, chars, chars_count)));
+    assert(index_of(str, K::template find_of<false, false>(str, count, chars, chars_count)) ==
+        index_of(str, reference_find_of<false, false>(str, count, chars, chars_count)));
+    assert(index_of(str, K::template find_of<true, true>(str, count, chars, chars_count)) ==
+        index_of(str, reference_find_of<true, true>(str, count, chars, chars_count)));
+    assert(index_of(str, K::template find_of<false, true>(str, count, chars, chars_count)) ==
+        index_of(str, reference_find_of<false, true>(str, count, chars, chars_count)));
+}
+
+template <typename K, typename T>
+void check_find_of(T const* str, size_t count) {
+    T const none[1] = {};
+    T const one[] = {target<T>};
+    T const several[] = {T('y'), high<T>, target<T>, element<T>(3)};
+    check_find_of<K>(str, count, none, 0);
+    check_find_of<K>(str, count, one, 1);
+    check_find_of<K>(str, count, several, sizeof(several) / sizeof(T));
+    if constexpr (sizeof(T) > 1) {
+        T const wide[] = {T(0x1234), target<T>};
+        check_find_of<K>(str, count, wide, 2);
+    }
+}
+
+/**
+ * Every length up to twice the widest vector at every element offset from a vector boundary,
+ * with the memory around the string holding the value searched for
+ */
+template <typename K, typename T>
+void test_lengths() {
+    alignas(vector_bytes) T storage[4 * vector_bytes];
+    T copy[max_length + 1];
+    for (size_t offset = 0; offset != lanes<T>; ++offset) {
+        T* const str = storage + offset;
+        for (size_t length = 0; length <= max_length; ++length) {
+            for (T const ch : {target<T>, high<T>}) {
+                compile_time::strnset(storage, ch, element_count_t(4 * vector_bytes));
+                fill(str, length);
+                check_memchr<K>(str, length, ch);
+                check_find_of<K>(str, length);
+                for (size_t idx = 0; idx != length; ++idx) {
+                    str[idx] = ch;
+                    check_memchr<K>(str, length, ch);
+                    check_find_of<K>(str, length);
+                    str[idx] = element<T>(idx);
+                }
+            }
+
+            compile_time::strnset(storage, target<T>, element_count_t(4 * vector_bytes));
+            assert(K::strnset(str, high<T>, length) == str);
+            for (size_t idx = 0; idx != length; ++idx) {
+                assert(str[idx] == high<T>);
+            }
+            assert(str[length] == target<T>);
+            assert(offset == 0 || str[-1] == target<T>);
+
+            fill(storage, 4 * vector_bytes);
+            str[length] = T();
+            assert(K::strlen(str) == length);
+            str[length + 1] = target<T>;
+            for (size_t idx = 0; idx <= length + 1; ++idx) {
+                T const previous = str[idx];
+                str[idx] = target<T>;
+                for (size_t count : {idx, idx + 1, length, length + 1, npos}) {
+                    check_strnchr<K>(str, count, target<T>);
+                }
+                str[idx] = previous;
+            }
+
+            // The copy is misaligned relative to the string so that both loads are exercised
+            fill(copy, length);
+            copy[length] = T();
+            for (size_t idx = 0; idx <= length; ++idx) {
+                for (T const ch : {T(), high<T>, T('a' - 1)}) {
+                    T const previous = copy[idx];
+                    copy[idx] = ch;
+                    for (size_t count : {idx, idx + 1, length + 1, npos}) {
+                        check_strncmp<K>(str, copy, count);
+                    }
+                    copy[idx] = previous;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Needles drawn from a two letter haystack, so that most candidate positions match the first and
+ * last element of the needle and have to be verified
+ */
+template <typename K, typename T>
+void test_needles() {
+    alignas(vector_bytes) T storage[4 * vector_bytes];
+    T needle[max_length + 2];
+    uint32_t seed = 0x9E3779B9u;
+    for (size_t offset = 0; offset != lanes<T>; ++offset) {
+        T* const haystack = storage + offset;
+        for (size_t n = 0; n <= max_length; ++n) {
+            for (size_t idx = 0; idx != n; ++idx) {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                haystack[idx] = T('a' + (seed & 1));
+            }
+            haystack[n] = target<T>;
+
+            for (size_t m = 0; m <= n + 1; ++m) {
+                for (size_t position : {size_t(0), (n - m) / 2, n - m}) {
+                    if (m > n) {
+                        fill(needle, m);
+                    } else {
+                        compile_time::memcpy(needle, haystack + position, element_count_t(m));
+                    }
+
+                    check_memmem<K>(haystack, n, needle, m);
+                    if (m != 0) {
+                        T const previous = needle[m - 1];
+                        needle[m - 1] = target<T>;
+                        check_memmem<K>(haystack, n, needle, m);
+                        needle[m - 1] = previous;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Strings ending at the end of the last accessible page, the kernels must not fault reading them,
+ * and strings straddling two pages with a match on either side of the boundary
+ */
+template <typename K, typename T>
+void test_pages(unsigned char* pages, size_t page_size) {
+    T* const end = (T*)(pages + 2 * page_size);
+    T* const boundary = (T*)(pages + page_size);
+    T copy[max_length + 1];
+    for (size_t length = 1; length <= max_length; ++length) {
+        T* const str = end - length;
+        fill(str, length);
+        check_memchr<K>(str, length, target<T>);
+        check_find_of<K>(str, length);
+        str[length - 1] = target<T>;
+        check_memchr<K>(str, length, target<T>);
+        check_find_of<K>(str, length);
+        check_memmem<K>(str, length, str, length);
+        if (length >= 2) {
+            check_memmem<K>(str, length, str + length - 2, 2);
+        }
+
+        str[length - 1] = T();
+        fill(copy, length - 1);
+        copy[length - 1] = T();
+        assert(K::strlen(str) == length - 1);
+        check_strnchr<K>(str, npos, target<T>);
+        check_strncmp<K>(str, copy, npos);
+        if (length > 1) {
+            str[length - 2] = target<T>;
+            check_strnchr<K>(str, npos, target<T>);
+        }
+    }
+
+    for (size_t before = 0; before <= max_length; ++before) {
+        T* const str = boundary - before;
+        for (size_t idx : {before - 1, before}) {
+            if (idx == npos) {
+                continue;
+            }
+
+            fill(str, max_length);
+            str[idx] = target<T>;
+            check_memchr<K>(str, max_length, target<T>);
+            check_find_of<K>(str, max_length);
+            check_strnchr<K>(str, npos, target<T>);
+            if (idx != 0) {
+                check_memmem<K>(str, max_length, str + idx - 1, 2);
+            }
+
+            str[idx] = T();
+            assert(K::strlen(str) == idx);
+            fill(copy, idx);
+            copy[idx] = T();
+            check_strncmp<K>(str, copy, npos);
+        }
+    }
+}
+
+template <typename K, typename T>
+void test_kernels(unsigned char* pages, size_t page_size) {
+    test_lengths<K, T>();
+    test_needles<K, T>();
+    test_pages<K, T>(pages, page_size);
+}
+
+template <typename T>
+void test_all(unsigned char* pages, size_t page_size) {
+#if UTL_ARCH_x86
+    namespace sse2 = vectorized::sse2;
+    namespace ssse3 = vectorized::ssse3;
+    namespace avx2 = vectorized::avx2;
+    using vectorized::scalar_find_first_of;
+    using vectorized::scalar_find_last_of;
+
+    tier<T>::table = {&sse2::memchr<T>, &sse2::strlen<T>, &sse2::strnchr<T>, &sse2::strncmp<T>,
+        &sse2::strnset<T>, &sse2::memrchr<T>, &sse2::memmem_short<T>, &sse2::memrmem_short<T>,
+        &scalar_find_first_of<true, T>, &scalar_find_first_of<false, T>,
+        &scalar_find_last_of<true, T>, &scalar_find_last_of<false, T>};
+    test_kernels<tier<T>, T>(pages, page_size);
+
+    if (vectorized::supports_ssse3()) {
+        tier<T>::table.find_first_of = &ssse3::find_first_of<true, T>;
+        tier<T>::table.find_first_not_of = &ssse3::find_first_of<false, T>;
+        tier<T>::table.find_last_of = &ssse3::find_last_of<true, T>;
+        tier<T>::table.find_last_not_of = &ssse3::find_last_of<false, T>;
+        test_kernels<tier<T>, T>(pages, page_size);
+    }
+
+    if (vectorized::supports_avx2()) {
+        tier<T>::table = {&avx2::memchr<T>, &avx2::strlen<T>, &avx2::strnchr<T>,
+            &avx2::strncmp<T>, &avx2::strnset<T>, &avx2::memrchr<T>, &avx2::memmem_short<T>,
+            &avx2::memrmem_short<T>, &avx2::find_first_of<true, T>,
+            &avx2::find_first_of<false, T>, &avx2::find_last_of<true, T>,
+            &avx2::find_last_of<false, T>};
+        test_kernels<tier<T>, T>(pages, page_size);
+    }
+#endif
+
+    test_kernels<dispatched<T>, T>(pages, page_size);
+}
+
+} // namespace libc_kernels
+
+int main(int, char**) {
+#if UTL_TARGET_UNIX
+    size_t const page_size = (size_t)::sysconf(_SC_PAGESIZE);
+    void* const mapping = ::mmap(nullptr, 3 * page_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(mapping != MAP_FAILED);
+    // Reading past the second page faults
+    assert(::mprotect((char*)mapping + 2 * page_size, page_size, PROT_NONE) == 0);
+    unsigned char* const pages = (unsigned char*)mapping;
+#else
+    constexpr size_t page_size = 4096;
+    alignas(page_size) static unsigned char pages[3 * page_size];
+#endif
+
+    libc_kernels::test_all<char>(pages, page_size);
+    libc_kernels::test_all<wchar_t>(pages, page_size);
+    libc_kernels::test_all<char16_t>(pages, page_size);
+    libc_kernels::test_all<char32_t>(pages, page_size);
+#if UTL_SUPPORTS_CHAR8_T
+    libc_kernels::test_kernels<libc_kernels::dispatched<char8_t>, char8_t>(pages, page_size);
+#endif
+
+#if UTL_TARGET_UNIX
+    ::munmap(mapping, 3 * page_size);
+#endif
+    return 0;
+}
@@ -1,8 +1,11 @@
 // Copyright 2023-2024 Bryan Wong
 
 #include "utl/string/utl_basic_short_string.h"
+#include "utl/string/utl_basic_string_builder.h"
+#include "utl/string/utl_basic_string_pool.h"
 #include "utl/string/utl_basic_string_view.h"
 #include "utl/string/utl_basic_zstring_view.h"
+#include "utl/string/utl_split_view.h"
 
 static_assert(utl::string_view("  \tabc ").find_last_not_of(" ") == 5, "");
 static_assert(remove_prefix(utl::string_view(" abc "), 1) == utl::string_view("abc "), "");
@@ -13,6 +16,39 @@ static_assert(unwrap(utl::string_view("<abc>"), '\'') == utl::string_view("<abc>
 static_assert(unwrap(utl::string_view("<abc>"), '<', '>') == utl::string_view("abc"), "");
 static_assert(unwrap(utl::string_view("\"abc\""), '\"') == utl::string_view("abc"), "");
 static_assert(unwrap(utl::string_view("racecar"), "rac", "car") == utl::string_view("e"), "");
+static_assert(utl::string_view("abcabc").find("ca") == 2, "");
+static_assert(utl::string_view("abcabc").find("cb") == utl::string_view::npos, "");
+static_assert(utl::string_view("abcabc").rfind("bc") == 4, "");
+static_assert(utl::string_view("abcabc").rfind("bc", 1) == 1, "");
+static_assert(utl::string_view("abcabc").rfind("", 2) == 2, "");
+static_assert(utl::string_view("abcabc").rfind('a') == 3, "");
+static_assert(utl::string_view("abcabc").find_first_of("cb") == 1, "");
+static_assert(utl::string_view("abcabc").find_first_not_of("ab") == 2, "");
+static_assert(utl::string_view("abcabc").find_last_of("a", 3) == 3, "");
+static_assert(utl::string_view("abcabc").find_last_not_of("c", 4) == 4, "");
+static_assert(utl::string_view("xabcabcabd").find(utl::string_searcher("abcabd")) == 4, "");
+static_assert(utl::string_view("xabcabcabd").find(utl::string_searcher("abcabd"), 5) ==
+        utl::string_view::npos,
+    "");
+static_assert(split_all(utl::string_view("a--b--c"), utl::string_searcher("--"),
+                  [](utl::string_view) {}) == 3,
+    "");
+
+template <typename View>
+constexpr size_t count_fields(View view) {
+    size_t count = 0;
+    for (auto field : view) {
+        count += field.size() > 0 ? 1 : 0x100;
+    }
+    return count;
+}
+
+static_assert(count_fields(utl::split(utl::string_view("a,b,,c"), ',')) == 0x103, "");
+static_assert(count_fields(utl::split(utl::string_view("a,b,,c,"), ',',
+                  utl::string_utils::empty_fields::skip)) == 3,
+    "");
+static_assert(count_fields(utl::split(utl::string_view("a::b::c"), "::")) == 3, "");
+static_assert(count_fields(utl::split_any_of(utl::string_view("a b\tc"), " \t")) == 3, "");
 
 int comparable(utl::string s) {
     if (s != "hello") {
@@ -22,6 +58,32 @@ int comparable(utl::string s) {
     return s.compare("hello") + s.rfind("jasl") + s.find("OIKAOSDJMI");
 }
 
+utl::string buildable(utl::string_view head, utl::string_view tail) {
+    utl::string_builder builder;
+    builder.append_view(tail);
+    builder.insert(0, head).push_back('\n');
+    builder.insert_view(head.size(), ", ");
+    return builder.str();
+}
+
+bool internable(utl::string_pool& pool, utl::string_view a, utl::string_view b) {
+    return pool.intern(a).data() == pool.intern(b).data();
+}
+
+bool concurrently_internable(utl::concurrent_string_pool& pool, utl::string_view a) {
+    auto const handle = pool.intern(a);
+    return handle.data() == pool.find(a).data() && pool.contains(a) && !pool.empty() &&
+        pool.size() <= pool.capacity() && pool.statistics().strings == pool.size();
+}
+
+size_t concurrently_internable(utl::wstring_view a, utl::wstring_view b) {
+    utl::concurrent_wstring_pool pool(16, utl::concurrent_wstring_pool::allocator_type());
+    pool.intern(a);
+    pool.intern(b);
+    (void)pool.get_allocator();
+    return pool.size();
+}
+
 void iterable(utl::string s) {
     for (auto c : s) {
         if (c == '\0') {
@@ -82,3 +144,12 @@ using small_string = utl::basic_string<CharT, utl::char_traits<CharT>, small_ite
 
 static_assert(sizeof(small_string<char>) == 6, "");
 static_assert(sizeof(utl::string) == 32, "");
+
+static_assert(utl::string_growth::doubling::next_capacity<char>(24, 25, 1024) == 48, "");
+static_assert(utl::string_growth::one_and_a_half::next_capacity<char>(24, 25, 1024) == 36, "");
+static_assert(utl::string_growth::doubling::next_capacity<char>(24, 100, 1024) == 100, "");
+static_assert(utl::string_growth::doubling::next_capacity<char>(768, 769, 1024) == 1024, "");
+static_assert(utl::string_growth::size_class<>::next_capacity<char>(100, 101, 1024) == 160, "");
+static_assert(sizeof(utl::basic_short_string<char, 23, utl::char_traits<char>, utl::allocator<char>,
+                  utl::string_growth::exact>) == 32,
+    "");
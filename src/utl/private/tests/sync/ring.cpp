@@ -0,0 +1,34 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/sync/utl_mpmc_ring.h"
+#include "utl/sync/utl_spsc_ring.h"
+
+static_assert(sizeof(utl::event_count) == 8, "");
+static_assert(alignof(utl::spsc_ring<int, 64>) == utl::details::ring::cache_line, "");
+static_assert(utl::spsc_ring<int, 64>::capacity() == 64, "");
+
+size_t func(utl::spsc_ring<int, 64>& ring) {
+    int values[4] = {1, 2, 3, 4};
+    size_t const pushed = ring.try_push_n(values, 4);
+    int value = 0;
+    return pushed + ring.try_pop(value) + ring.try_pop_n(values, 4);
+}
+
+void func(utl::spsc_ring<long, 16, true>& ring) {
+    long value = 0;
+    ring.push(1);
+    ring.pop(value);
+}
+
+size_t func(utl::mpmc_ring<int>& ring) {
+    int values[4] = {1, 2, 3, 4};
+    size_t const pushed = ring.try_push_n(values, 4);
+    int value = 0;
+    return pushed + ring.try_emplace(5) + ring.try_pop(value) + ring.try_pop_n(values, 4);
+}
+
+void func(utl::mpmc_ring<long, true>& ring) {
+    long value = 0;
+    ring.push(value);
+    ring.pop(value);
+}
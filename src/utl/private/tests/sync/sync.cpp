@@ -0,0 +1,30 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/sync.h"
+
+static_assert(sizeof(utl::mutex) == 4, "");
+static_assert(sizeof(utl::shared_mutex) == 4, "");
+static_assert(sizeof(utl::condition_variable) == 4, "");
+static_assert(sizeof(utl::latch) == 4, "");
+static_assert(sizeof(utl::barrier) == 4, "");
+
+void func(utl::mutex& m, utl::condition_variable& cv, bool& ready) {
+    m.lock();
+    cv.wait(m, [&]() { return ready; });
+    m.unlock();
+    cv.notify_all(m);
+}
+
+void func(utl::shared_mutex& m) {
+    if (m.try_lock_shared()) {
+        m.unlock_shared();
+    }
+    m.lock();
+    m.unlock();
+}
+
+void func(utl::latch& l, utl::barrier& b) {
+    l.arrive_and_wait();
+    b.wait(b.arrive());
+    b.arrive_and_drop();
+}
@@ -0,0 +1,23 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/tempus/utl_calibrated_clock.h"
+
+namespace calibrated_clock = utl::tempus::details::calibrated_clock;
+
+static_assert(calibrated_clock::multiply_shift(3, uint64_t(1) << 32) == 3, "");
+static_assert(calibrated_clock::multiply_shift(-3, uint64_t(1) << 32) == -3, "");
+static_assert(calibrated_clock::multiply_shift(3, uint64_t(1) << 31) == 1, "");
+static_assert(calibrated_clock::multiply_shift(-3, uint64_t(1) << 31) == -2, "");
+static_assert(calibrated_clock::multiply_shift(int64_t(1) << 40, uint64_t(5) << 32) ==
+        int64_t(5) << 40,
+    "");
+static_assert(
+    utl::tempus::calibration{100, 1000, uint64_t(1) << 33}.to_nanoseconds(150) == 1100, "");
+
+int64_t func() {
+    utl::tempus::calibrated_clock::calibrate();
+    utl::tempus::calibration const mapping = utl::tempus::calibrated_clock::current();
+    int64_t const ticks = utl::tempus::calibrated_clock::ticks();
+    return utl::tempus::calibrated_clock::now_ns() - mapping.to_nanoseconds(ticks) +
+        static_cast<int64_t>(utl::tempus::calibrated_clock::frequency());
+}
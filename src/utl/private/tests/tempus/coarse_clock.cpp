@@ -0,0 +1,13 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/tempus/utl_coarse_clock.h"
+
+static_assert(UTL_TRAIT_is_tempus_clock(utl::tempus::coarse_clock_t), "");
+
+bool func() {
+    auto const before = get_time(utl::tempus::coarse_clock);
+    bool const started = utl::tempus::coarse_clock_t::start();
+    auto const after = get_time(utl::tempus::coarse_clock);
+    utl::tempus::coarse_clock_t::stop();
+    return started && after >= before && (after - before).seconds() < 1;
+}
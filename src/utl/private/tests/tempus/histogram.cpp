@@ -0,0 +1,23 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/tempus/utl_histogram.h"
+
+namespace histogram = utl::tempus::details::histogram;
+
+static_assert(histogram::index_of(255) == 255, "");
+static_assert(histogram::index_of(256) == 256, "");
+static_assert(histogram::index_of(uint64_t(-1)) == histogram::bucket_count - 1, "");
+static_assert(histogram::lowest_of(histogram::index_of(1000)) <= 1000, "");
+static_assert(histogram::highest_of(histogram::index_of(1000)) >= 1000, "");
+static_assert(histogram::highest_of(383) + 1 == histogram::lowest_of(384), "");
+
+uint64_t func(utl::tempus::histogram& latencies, utl::tempus::histogram::recorder& recorder) {
+    recorder.record(utl::tempus::duration(0, 1500));
+    {
+        utl::tempus::histogram::timer<utl::tempus::steady_clock_t> timer(recorder);
+    }
+
+    utl::tempus::histogram::snapshot total = latencies.read();
+    total.merge(latencies.read());
+    return total.p50() + total.p99() + total.p999() + total.max();
+}
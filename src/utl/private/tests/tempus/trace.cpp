@@ -0,0 +1,27 @@
+// Copyright 2023-2024 Bryan Wong
+
+#include "utl/tempus/utl_trace.h"
+
+int func(int value) {
+    UTL_TRACE_SCOPE("func");
+    return value * 2;
+}
+
+bool func(FILE* file) {
+    utl::tempus::trace::options config;
+    config.drain_interval_ns = 0;
+    if (!utl::tempus::trace::start(config)) {
+        return false;
+    }
+
+    {
+        UTL_TRACE_SCOPE("outer");
+        (void)func(1);
+    }
+
+    utl::tempus::trace::stop();
+    bool const result =
+        utl::tempus::trace::dropped() == 0 && utl::tempus::trace::write_chrome_trace(file);
+    utl::tempus::trace::clear();
+    return result;
+}
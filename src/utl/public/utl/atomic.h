@@ -3,3 +3,5 @@
 #pragma once
 
 #include "utl/atomic/utl_atomic.h"
+#include "utl/atomic/utl_atomic_type.h"
+#include "utl/atomic/utl_atomic_wait.h"
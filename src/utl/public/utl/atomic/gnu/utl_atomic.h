@@ -26,6 +26,7 @@
 #include "utl/type_traits/utl_is_trivially_copyable.h"
 #include "utl/type_traits/utl_make_unsigned.h"
 #include "utl/type_traits/utl_remove_cv.h"
+#include "utl/type_traits/utl_remove_pointer.h"
 #include "utl/type_traits/utl_underlying_type.h"
 
 #include <stdint.h>
@@ -33,6 +34,20 @@
 UTL_NAMESPACE_BEGIN
 
 namespace atomics {
+/**
+ * Bytes by which arithmetic on a pointer to `T` advances, pointers to void advance by bytes
+ */
+template <typename T>
+struct pointer_stride : size_constant<sizeof(T)> {};
+template <>
+struct pointer_stride<void> : size_constant<1> {};
+template <typename T>
+struct pointer_stride<T const> : pointer_stride<T> {};
+template <typename T>
+struct pointer_stride<T volatile> : pointer_stride<T> {};
+template <typename T>
+struct pointer_stride<T const volatile> : pointer_stride<T> {};
+
 template <typename T, size_t = (alignof(T) == sizeof(T)) * sizeof(T)>
 struct interpreted_type;
 template <typename T>
@@ -240,7 +255,8 @@ public:
     UTL_CONSTRAINT_CXX20(is_pointer_v<T>)
     UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) static inline value_type<T> fetch_add(
         T* ctx, ptrdiff_t offset) noexcept {
-        return __atomic_fetch_add(ctx, offset * sizeof(T), order);
+        return __atomic_fetch_add(
+            ctx, offset * pointer_stride<remove_pointer_t<T>>::value, order);
     }
 
     template <UTL_CONCEPT_CXX20(integral) T UTL_CONSTRAINT_CXX11(UTL_TRAIT_is_integral(T))>
@@ -253,7 +269,8 @@ public:
     UTL_CONSTRAINT_CXX20(is_pointer_v<T>)
     UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) static inline value_type<T> fetch_sub(
         T* ctx, ptrdiff_t offset) noexcept {
-        return __atomic_fetch_sub(ctx, offset * sizeof(T), order);
+        return __atomic_fetch_sub(
+            ctx, offset * pointer_stride<remove_pointer_t<T>>::value, order);
     }
 
     template <UTL_CONCEPT_CXX20(integral) T UTL_CONSTRAINT_CXX11(UTL_TRAIT_is_integral(T))>
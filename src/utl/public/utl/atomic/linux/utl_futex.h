@@ -12,15 +12,19 @@
 #  error Invalid Target
 #endif // UTL_TARGET_LINUX
 
+#include "utl/assert/utl_assert.h"
 #include "utl/memory/utl_addressof.h"
 #include "utl/system_error/utl_errc.h"
 #include "utl/system_error/utl_error_category.h"
 #include "utl/system_error/utl_error_code.h"
+#include "utl/tempus/utl_clock.h"
 #include "utl/tempus/utl_duration.h"
 #include "utl/type_traits/utl_is_trivially_copyable.h"
 
 #include <errno.h>
+#include <limits.h>
 #include <linux/futex.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <sys/syscall.h>
 #include <unistd.h>
@@ -105,6 +109,206 @@ UTL_ATTRIBUTE(_HIDE_FROM_ABI) inline auto notify_all(T* address) noexcept
     syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), op, wake_all);
 }
 
+/**
+ * Wakes up to `wake_count` threads waiting on `address` and moves up to `requeue_count` of the
+ * remaining waiters to wait on `target` without waking them, provided the value at `address` still
+ * equals `value`. Moving the waiters avoids waking threads that would immediately block on
+ * `target` again.
+ *
+ * @return success, or `resource_unavailable_try_again` if the value at `address` has changed
+ */
+template <UTL_CONCEPT_CXX20(waitable_type) T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline auto requeue(T* address, T const& value,
+    int wake_count, T* target, int requeue_count) noexcept
+    -> UTL_ENABLE_IF_CXX11(error_code, UTL_TRAIT_is_futex_waitable(T)) {
+    static constexpr uint32_t op = FUTEX_CMP_REQUEUE_PRIVATE;
+    uint32_t readable_value = 0;
+    __UTL_MEMCPY(&readable_value, __UTL addressof(value), sizeof(value));
+    // The requeue limit is passed in place of the timeout
+    if (syscall(SYS_futex, reinterpret_cast<uint32_t*>(address), op, wake_count,
+            static_cast<uintptr_t>(requeue_count), reinterpret_cast<uint32_t*>(target),
+            readable_value) >= 0) {
+        return error_code{};
+    }
+
+    return error_code{errno, system_category()};
+}
+
+namespace details {
+/**
+ * Wait operation with an absolute deadline against `CLOCK_MONOTONIC`, or against
+ * `CLOCK_REALTIME` if `realtime` is set; a null deadline waits indefinitely
+ */
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline error_code wait_bitset(
+    uint32_t* address, uint32_t value, uint32_t bitset, timespec const* deadline,
+    bool realtime) noexcept {
+    uint32_t const op = FUTEX_WAIT_BITSET_PRIVATE | (realtime ? FUTEX_CLOCK_REALTIME : 0);
+    if (!syscall(SYS_futex, address, op, value, deadline, nullptr, bitset)) {
+        return error_code{};
+    }
+
+    auto const error = errno;
+    if (error == EAGAIN) {
+        return error_code{};
+    }
+
+    return error_code{error, system_category()};
+}
+
+template <typename T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline uint32_t readable(T const& value) noexcept {
+    uint32_t result = 0;
+    __UTL_MEMCPY(&result, __UTL addressof(value), sizeof(value));
+    return result;
+}
+} // namespace details
+
+/**
+ * Waits until the value at `address` differs from `value`, the thread is notified or the deadline
+ * on the steady clock passes. An absolute deadline does not drift when a loop waits repeatedly.
+ *
+ * @return success, or `timed_out` once the deadline has passed
+ */
+template <UTL_CONCEPT_CXX20(waitable_type) T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline auto wait_until(T* address, T const& value,
+    __UTL tempus::time_point<__UTL tempus::steady_clock_t> const& deadline) noexcept
+    -> UTL_ENABLE_IF_CXX11(error_code, UTL_TRAIT_is_futex_waitable(T)) {
+    return details::wait_bitset(reinterpret_cast<uint32_t*>(address), details::readable(value),
+        FUTEX_BITSET_MATCH_ANY, &deadline.value(), false);
+}
+
+/**
+ * Waits until the value at `address` differs from `value`, the thread is notified or the deadline
+ * on the system clock passes, adjustments to the system clock move the deadline with it
+ */
+template <UTL_CONCEPT_CXX20(waitable_type) T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline auto wait_until(T* address, T const& value,
+    __UTL tempus::time_point<__UTL tempus::system_clock_t> const& deadline) noexcept
+    -> UTL_ENABLE_IF_CXX11(error_code, UTL_TRAIT_is_futex_waitable(T)) {
+    return details::wait_bitset(reinterpret_cast<uint32_t*>(address), details::readable(value),
+        FUTEX_BITSET_MATCH_ANY, &deadline.value(), true);
+}
+
+/**
+ * Waits on `address` as `wait` does, but can only be woken by a `wake_bitset` whose bitset
+ * intersects `bitset`. Giving each class of waiter its own bit lets a notifier wake a subset of
+ * the threads waiting on one word.
+ */
+template <UTL_CONCEPT_CXX20(waitable_type) T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline auto wait_bitset(
+    T* address, T const& value, uint32_t bitset) noexcept
+    -> UTL_ENABLE_IF_CXX11(error_code, UTL_TRAIT_is_futex_waitable(T)) {
+    return details::wait_bitset(
+        reinterpret_cast<uint32_t*>(address), details::readable(value), bitset, nullptr, false);
+}
+
+template <UTL_CONCEPT_CXX20(waitable_type) T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline auto wait_bitset(T* address, T const& value,
+    uint32_t bitset,
+    __UTL tempus::time_point<__UTL tempus::steady_clock_t> const& deadline) noexcept
+    -> UTL_ENABLE_IF_CXX11(error_code, UTL_TRAIT_is_futex_waitable(T)) {
+    return details::wait_bitset(reinterpret_cast<uint32_t*>(address), details::readable(value),
+        bitset, &deadline.value(), false);
+}
+
+template <UTL_CONCEPT_CXX20(waitable_type) T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline auto wait_bitset(T* address, T const& value,
+    uint32_t bitset,
+    __UTL tempus::time_point<__UTL tempus::system_clock_t> const& deadline) noexcept
+    -> UTL_ENABLE_IF_CXX11(error_code, UTL_TRAIT_is_futex_waitable(T)) {
+    return details::wait_bitset(reinterpret_cast<uint32_t*>(address), details::readable(value),
+        bitset, &deadline.value(), true);
+}
+
+/**
+ * Wakes up to `count` threads waiting on `address` whose bitset intersects `bitset`, threads in
+ * `wait` and `wait_until` match every bitset
+ *
+ * @return the number of threads woken
+ */
+template <UTL_CONCEPT_CXX20(waitable_type) T>
+UTL_ATTRIBUTE(_HIDE_FROM_ABI) inline auto wake_bitset(
+    T* address, uint32_t bitset, int count = INT_MAX) noexcept
+    -> UTL_ENABLE_IF_CXX11(int, UTL_TRAIT_is_futex_waitable(T)) {
+    static constexpr uint32_t op = FUTEX_WAKE_BITSET_PRIVATE;
+    auto const result = syscall(
+        SYS_futex, reinterpret_cast<uint32_t*>(address), op, count, nullptr, nullptr, bitset);
+    return result < 0 ? 0 : static_cast<int>(result);
+}
+
+/**
+ * One word of a multi-word wait, laid out as the kernel's `struct futex_waitv`
+ */
+class __UTL_ABI_PUBLIC waitv_entry {
+public:
+    template <UTL_CONCEPT_CXX20(waitable_type) T
+            UTL_CONSTRAINT_CXX11(UTL_TRAIT_is_futex_waitable(T))>
+    __UTL_HIDE_FROM_ABI waitv_entry(T* address, T const& value) noexcept
+        : value_(details::readable(value))
+        , address_(reinterpret_cast<uintptr_t>(address))
+        , flags_(size_u32 | FUTEX_PRIVATE_FLAG)
+        , reserved_(0) {}
+
+private:
+    static constexpr uint32_t size_u32 = 2;
+
+    uint64_t value_;
+    uint64_t address_;
+    uint32_t flags_;
+    uint32_t reserved_;
+};
+
+/**
+ * Maximum number of words in a multi-word wait
+ */
+UTL_INLINE_CXX17 constexpr size_t waitv_max = 128;
+
+namespace details {
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline error_code wait_any(waitv_entry const* entries,
+    size_t count, size_t& woken, timespec const* deadline, int clock) noexcept {
+#  if defined(SYS_futex_waitv)
+    static constexpr long op = SYS_futex_waitv;
+#  else
+    static constexpr long op = 449;
+#  endif
+    UTL_ASSERT(count <= waitv_max);
+    auto const result = syscall(op, entries, static_cast<unsigned int>(count), 0u, deadline, clock);
+    if (result >= 0) {
+        woken = static_cast<size_t>(result);
+        return error_code{};
+    }
+
+    return error_code{errno, system_category()};
+}
+} // namespace details
+
+/**
+ * Blocks until any of the words in `entries` is woken or no longer holds its value, so one thread
+ * can wait on many words without polling. Requires Linux 5.16.
+ *
+ * @param woken receives the index of a woken word
+ *
+ * @return success if a word was woken; `resource_unavailable_try_again` if a word no longer held
+ * its value, in which case `woken` is not set; `function_not_supported` if the kernel does not
+ * support multi-word waits
+ */
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline error_code wait_any(
+    waitv_entry const* entries, size_t count, size_t& woken) noexcept {
+    return details::wait_any(entries, count, woken, nullptr, CLOCK_MONOTONIC);
+}
+
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline error_code wait_any(waitv_entry const* entries,
+    size_t count, size_t& woken,
+    __UTL tempus::time_point<__UTL tempus::steady_clock_t> const& deadline) noexcept {
+    return details::wait_any(entries, count, woken, &deadline.value(), CLOCK_MONOTONIC);
+}
+
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, NODISCARD) inline error_code wait_any(waitv_entry const* entries,
+    size_t count, size_t& woken,
+    __UTL tempus::time_point<__UTL tempus::system_clock_t> const& deadline) noexcept {
+    return details::wait_any(entries, count, woken, &deadline.value(), CLOCK_REALTIME);
+}
+
 #undef UTL_TRAIT_is_futex_waitable
 } // namespace futex
 
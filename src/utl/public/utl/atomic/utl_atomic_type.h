@@ -0,0 +1,290 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/assert/utl_assert.h"
+#include "utl/atomic/utl_atomic.h"
+#include "utl/atomic/utl_atomic_wait.h"
+#include "utl/memory/utl_addressof.h"
+#include "utl/type_traits/utl_constants.h"
+#include "utl/type_traits/utl_is_nothrow_default_constructible.h"
+#include "utl/type_traits/utl_remove_cv.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace atomics {
+namespace details {
+/**
+ * Failure order paired with a single order passed to `compare_exchange`, as in the standard
+ */
+template <memory_order O>
+struct failure_order :
+    value_constant<memory_order,
+        O == memory_order::acq_rel       ? memory_order::acquire
+            : O == memory_order::release ? memory_order::relaxed
+                                         : O> {};
+
+template <memory_order O>
+using failure_t UTL_NODEBUG = compare_exchange_failure<failure_order<O>::value>;
+
+template <typename T>
+struct difference {
+    using type UTL_NODEBUG = T;
+};
+
+template <typename T>
+struct difference<T*> {
+    using type UTL_NODEBUG = ptrdiff_t;
+};
+
+/**
+ * Objects whose size is a power of two no larger than 16 bytes are aligned to their size so that
+ * they are accessed with a single instruction
+ */
+template <typename T>
+struct required_alignment :
+    size_constant<(sizeof(T) <= 16 && (sizeof(T) & (sizeof(T) - 1)) == 0 &&
+                      sizeof(T) > alignof(T))
+            ? sizeof(T)
+            : alignof(T)> {};
+
+/**
+ * Operations shared by `atomic` and `atomic_ref`, `Derived` provides the address of the object
+ *
+ * Every operation takes the memory order as a tag, `memory_order_seq_cst` unless specified, so
+ * an order that is invalid for the operation fails to compile.
+ */
+template <typename Derived, typename T>
+class __UTL_PUBLIC_TEMPLATE interface {
+public:
+    using value_type = remove_cv_t<T>;
+    using difference_type = typename difference<value_type>::type;
+
+    template <memory_order O = memory_order::seq_cst>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type load(
+        memory_order_type<O> = {}) const noexcept {
+        return atomic_operations<O>::load(address());
+    }
+
+    template <memory_order O = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void store(
+        value_type desired, memory_order_type<O> = {}) noexcept {
+        atomic_operations<O>::store(address(), desired);
+    }
+
+    template <memory_order O = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type exchange(
+        value_type desired, memory_order_type<O> = {}) noexcept {
+        return atomic_operations<O>::exchange(address(), desired);
+    }
+
+    template <memory_order S = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline bool compare_exchange_strong(
+        value_type& expected, value_type desired, memory_order_type<S> = {}) noexcept {
+        return atomic_operations<S>::compare_exchange_strong(
+            address(), __UTL addressof(expected), desired, failure_t<S>{});
+    }
+
+    template <memory_order S, memory_order F>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline bool compare_exchange_strong(
+        value_type& expected, value_type desired, memory_order_type<S>,
+        memory_order_type<F>) noexcept {
+        return atomic_operations<S>::compare_exchange_strong(
+            address(), __UTL addressof(expected), desired, compare_exchange_failure<F>{});
+    }
+
+    template <memory_order S = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline bool compare_exchange_weak(
+        value_type& expected, value_type desired, memory_order_type<S> = {}) noexcept {
+        return atomic_operations<S>::compare_exchange_weak(
+            address(), __UTL addressof(expected), desired, failure_t<S>{});
+    }
+
+    template <memory_order S, memory_order F>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline bool compare_exchange_weak(
+        value_type& expected, value_type desired, memory_order_type<S>,
+        memory_order_type<F>) noexcept {
+        return atomic_operations<S>::compare_exchange_weak(
+            address(), __UTL addressof(expected), desired, compare_exchange_failure<F>{});
+    }
+
+    /**
+     * Arithmetic and bitwise operations are only available for integral and pointer types,
+     * pointer arithmetic is scaled by the size of the pointee
+     */
+    template <memory_order O = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type fetch_add(
+        difference_type arg, memory_order_type<O> = {}) noexcept {
+        return atomic_operations<O>::fetch_add(address(), arg);
+    }
+
+    template <memory_order O = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type fetch_sub(
+        difference_type arg, memory_order_type<O> = {}) noexcept {
+        return atomic_operations<O>::fetch_sub(address(), arg);
+    }
+
+    template <memory_order O = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type fetch_and(
+        value_type arg, memory_order_type<O> = {}) noexcept {
+        return atomic_operations<O>::fetch_and(address(), arg);
+    }
+
+    template <memory_order O = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type fetch_or(
+        value_type arg, memory_order_type<O> = {}) noexcept {
+        return atomic_operations<O>::fetch_or(address(), arg);
+    }
+
+    template <memory_order O = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type fetch_xor(
+        value_type arg, memory_order_type<O> = {}) noexcept {
+        return atomic_operations<O>::fetch_xor(address(), arg);
+    }
+
+    /**
+     * Blocks until the value no longer compares bytewise equal to `old`, spinning briefly before
+     * the thread is parked
+     */
+    template <memory_order O = memory_order::seq_cst>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI) inline void wait(
+        value_type old, memory_order_type<O> order = {}) const noexcept {
+        __UTL atomics::wait(address(), old, order);
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI) inline void notify_one() noexcept {
+        __UTL atomics::notify_one(address());
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI) inline void notify_all() noexcept {
+        __UTL atomics::notify_all(address());
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline operator value_type() const noexcept {
+        return load();
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator=(
+        value_type desired) noexcept {
+        store(desired);
+        return desired;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator++() noexcept {
+        return fetch_add(1) + 1;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator++(int) noexcept {
+        return fetch_add(1);
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator--() noexcept {
+        return fetch_sub(1) - 1;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator--(int) noexcept {
+        return fetch_sub(1);
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator+=(
+        difference_type arg) noexcept {
+        return fetch_add(arg) + arg;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator-=(
+        difference_type arg) noexcept {
+        return fetch_sub(arg) - arg;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator&=(
+        value_type arg) noexcept {
+        return fetch_and(arg) & arg;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator|=(
+        value_type arg) noexcept {
+        return fetch_or(arg) | arg;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline value_type operator^=(
+        value_type arg) noexcept {
+        return fetch_xor(arg) ^ arg;
+    }
+
+protected:
+    __UTL_HIDE_FROM_ABI constexpr interface() noexcept = default;
+    __UTL_HIDE_FROM_ABI UTL_CONSTEXPR_CXX20 ~interface() noexcept = default;
+
+private:
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline T* address() const noexcept {
+        return static_cast<Derived const&>(*this).address();
+    }
+};
+} // namespace details
+} // namespace atomics
+
+/**
+ * Object whose every access is atomic
+ *
+ * `T` must be one of the types supported by `atomic_operations`: arithmetic types, pointers,
+ * enumerations and trivially copyable classes whose size and alignment are equal.
+ */
+template <typename T>
+class __UTL_PUBLIC_TEMPLATE atomic : public atomics::details::interface<atomic<T>, T> {
+    using base_type UTL_NODEBUG = atomics::details::interface<atomic<T>, T>;
+    friend base_type;
+
+public:
+    using typename base_type::difference_type;
+    using typename base_type::value_type;
+    using base_type::operator=;
+
+    __UTL_HIDE_FROM_ABI constexpr atomic() noexcept(UTL_TRAIT_is_nothrow_default_constructible(T))
+        : value_() {}
+    __UTL_HIDE_FROM_ABI constexpr atomic(value_type desired) noexcept : value_(desired) {}
+    atomic(atomic const&) = delete;
+    atomic& operator=(atomic const&) = delete;
+
+private:
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline T* address() const noexcept {
+        return const_cast<T*>(__UTL addressof(value_));
+    }
+
+    alignas(atomics::details::required_alignment<T>::value) T value_;
+};
+
+/**
+ * Applies atomic operations to an object it does not own, the object must outlive every
+ * `atomic_ref` to it and must only be accessed through `atomic_ref` while any exists
+ */
+template <typename T>
+class __UTL_PUBLIC_TEMPLATE atomic_ref : public atomics::details::interface<atomic_ref<T>, T> {
+    using base_type UTL_NODEBUG = atomics::details::interface<atomic_ref<T>, T>;
+    friend base_type;
+
+public:
+    using typename base_type::difference_type;
+    using typename base_type::value_type;
+    using base_type::operator=;
+
+    __UTL_HIDE_FROM_ABI explicit atomic_ref(T& object) noexcept : ptr_(__UTL addressof(object)) {
+        UTL_ASSERT(reinterpret_cast<uintptr_t>(ptr_) %
+                atomics::details::required_alignment<T>::value ==
+            0);
+    }
+    __UTL_HIDE_FROM_ABI constexpr atomic_ref(atomic_ref const&) noexcept = default;
+    atomic_ref& operator=(atomic_ref const&) = delete;
+
+private:
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline T* address() const noexcept {
+        return ptr_;
+    }
+
+    T* ptr_;
+};
+
+UTL_NAMESPACE_END
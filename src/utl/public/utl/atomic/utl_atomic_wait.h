@@ -0,0 +1,173 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/atomic/utl_futex.h"
+#include "utl/memory/utl_addressof.h"
+#include "utl/string/utl_libc.h"
+#include "utl/sync/utl_backoff.h"
+#include "utl/tempus/utl_duration.h"
+#include "utl/type_traits/utl_constants.h"
+#include "utl/type_traits/utl_remove_cv.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace atomics {
+/**
+ * Address-keyed table of waiter counts and wake-up words
+ *
+ * Addresses hash to one of a fixed number of cache line sized slots. Each slot counts the threads
+ * blocked on any address that hashes to it, so that notifying an address nobody waits on costs no
+ * system call, and holds a 32-bit epoch for values the platform futex cannot wait on directly:
+ * such waiters sleep on the epoch and notifiers advance it. Collisions only cause spurious
+ * wake-ups, waiters always re-check their own value.
+ */
+namespace parking {
+/**
+ * Registers the calling thread as a waiter on `address`, must be paired with `leave`
+ *
+ * Sequentially consistent with respect to `has_waiters`, a waiter that registers and then observes
+ * the old value cannot miss a notifier that changes the value and then checks for waiters.
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) void enter(void const* address) noexcept;
+UTL_ATTRIBUTES(_ABI_PUBLIC) void leave(void const* address) noexcept;
+/**
+ * @return the current epoch of the slot of `address`, read before the waited value is checked
+ */
+UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) uint32_t epoch(void const* address) noexcept;
+/**
+ * Blocks until the epoch of the slot of `address` differs from `epoch`, may return spuriously
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) void park(void const* address, uint32_t epoch) noexcept;
+/**
+ * @return true if any thread is registered on the slot of `address`
+ */
+UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) bool has_waiters(void const* address) noexcept;
+/**
+ * Advances the epoch of the slot of `address` and wakes every thread parked on it
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) void unpark_all(void const* address) noexcept;
+} // namespace parking
+
+namespace details {
+namespace waiting {
+template <typename T>
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool equals(T const& lhs, T const& rhs) noexcept {
+    return __UTL libc::unsafe::memcmp(
+               __UTL addressof(lhs), __UTL addressof(rhs), libc::element_count_t(1)) == 0;
+}
+
+template <memory_order O, typename T>
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool changed(
+    T const* ptr, remove_cv_t<T> const& old) noexcept {
+    return !equals(atomic_operations<O>::load(ptr), old);
+}
+
+template <memory_order O, typename T>
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool spin(
+    T const* ptr, remove_cv_t<T> const& old) noexcept {
+    return __UTL sync::details::spin_until([&]() { return changed<O>(ptr, old); });
+}
+
+template <memory_order O, typename T>
+__UTL_HIDE_FROM_ABI inline void park(T const* ptr, remove_cv_t<T> const& old, true_type) noexcept {
+    parking::enter(ptr);
+    while (!changed<O>(ptr, old)) {
+        (void)__UTL futex::wait(
+            const_cast<remove_cv_t<T>*>(ptr), old, __UTL tempus::duration::invalid());
+    }
+    parking::leave(ptr);
+}
+
+template <memory_order O, typename T>
+__UTL_HIDE_FROM_ABI inline void park(T const* ptr, remove_cv_t<T> const& old, false_type) noexcept {
+    parking::enter(ptr);
+    for (uint32_t epoch = parking::epoch(ptr); !changed<O>(ptr, old);
+         epoch = parking::epoch(ptr)) {
+        parking::park(ptr, epoch);
+    }
+    parking::leave(ptr);
+}
+
+template <typename T>
+using direct UTL_NODEBUG = bool_constant<__UTL futex::is_waitable<remove_cv_t<T>>::value>;
+
+template <typename T>
+__UTL_HIDE_FROM_ABI inline void wake_one(T const* ptr, true_type) noexcept {
+    __UTL futex::notify_one(const_cast<remove_cv_t<T>*>(ptr));
+}
+
+template <typename T>
+__UTL_HIDE_FROM_ABI inline void wake_all(T const* ptr, true_type) noexcept {
+    __UTL futex::notify_all(const_cast<remove_cv_t<T>*>(ptr));
+}
+
+/**
+ * Waiters on other values share the epoch of their slot, so every one of them is woken
+ */
+template <typename T>
+__UTL_HIDE_FROM_ABI inline void wake_one(T const* ptr, false_type) noexcept {
+    parking::unpark_all(ptr);
+}
+
+template <typename T>
+__UTL_HIDE_FROM_ABI inline void wake_all(T const* ptr, false_type) noexcept {
+    parking::unpark_all(ptr);
+}
+} // namespace waiting
+} // namespace details
+
+/**
+ * Blocks until the value at `ptr` no longer compares bytewise equal to `old`
+ *
+ * The waiter spins with exponential backoff for a bounded number of rounds before it parks. Values
+ * the platform futex supports, 32-bit values on every platform, are waited on directly; other
+ * values park on the slot of their address in the parking table. Spurious wake-ups are absorbed.
+ *
+ * @param order the order of the loads that observe the value
+ */
+template <memory_order O, typename T>
+__UTL_HIDE_FROM_ABI inline void wait(
+    T const* ptr, remove_cv_t<T> const& old, memory_order_type<O> order) noexcept {
+    (void)order;
+    if (!details::waiting::spin<O>(ptr, old)) {
+        details::waiting::park<O>(ptr, old, details::waiting::direct<T>{});
+    }
+}
+
+template <typename T>
+__UTL_HIDE_FROM_ABI inline void wait(T const* ptr, remove_cv_t<T> const& old) noexcept {
+    __UTL atomics::wait(ptr, old, memory_order_seq_cst);
+}
+
+/**
+ * Wakes at least one thread blocked in `wait` on `ptr`, the value must be modified beforehand
+ */
+template <typename T>
+__UTL_HIDE_FROM_ABI inline void notify_one(T const* ptr) noexcept {
+    if (!parking::has_waiters(ptr)) {
+        return;
+    }
+
+    details::waiting::wake_one(ptr, details::waiting::direct<T>{});
+}
+
+/**
+ * Wakes every thread blocked in `wait` on `ptr`, the value must be modified beforehand
+ */
+template <typename T>
+__UTL_HIDE_FROM_ABI inline void notify_all(T const* ptr) noexcept {
+    if (!parking::has_waiters(ptr)) {
+        return;
+    }
+
+    details::waiting::wake_all(ptr, details::waiting::direct<T>{});
+}
+} // namespace atomics
+
+UTL_NAMESPACE_END
@@ -45,6 +45,28 @@ namespace futex {
  * @return An integer representing the number of threads that were notified (0 or 1)
  *
  * int notify_all(type*) noexcept;
+ *
+ *
+ * Linux only:
+ *
+ * Waits as `wait` does until an absolute deadline on the steady or system clock.
+ *
+ * error_code wait_until(type*, type const&, tempus::time_point<clock> const&) noexcept;
+ *
+ *
+ * Waits as `wait` does, but is only woken by a `wake_bitset` whose bitset intersects `bitset`.
+ *
+ * error_code wait_bitset(type*, type const&, uint32_t bitset) noexcept;
+ * error_code wait_bitset(type*, type const&, uint32_t bitset,
+ *     tempus::time_point<clock> const&) noexcept;
+ * int wake_bitset(type*, uint32_t bitset, int count = INT_MAX) noexcept;
+ *
+ *
+ * Blocks until any of up to `waitv_max` words is woken or changed, `woken` receives its index.
+ *
+ * error_code wait_any(waitv_entry const*, size_t count, size_t& woken) noexcept;
+ * error_code wait_any(waitv_entry const*, size_t count, size_t& woken,
+ *     tempus::time_point<clock> const&) noexcept;
  */
 } // namespace futex
 
@@ -25,6 +25,7 @@
 #include "utl/type_traits/utl_is_trivially_copyable.h"
 #include "utl/type_traits/utl_make_unsigned.h"
 #include "utl/type_traits/utl_remove_cv.h"
+#include "utl/type_traits/utl_remove_pointer.h"
 #include "utl/type_traits/utl_underlying_type.h"
 #include "utl/utility/utl_to_underlying.h"
 
@@ -32,6 +33,20 @@ UTL_NAMESPACE_BEGIN
 
 namespace atomics {
 
+/**
+ * Bytes by which arithmetic on a pointer to `T` advances, pointers to void advance by bytes
+ */
+template <typename T>
+struct pointer_stride : size_constant<sizeof(T)> {};
+template <>
+struct pointer_stride<void> : size_constant<1> {};
+template <typename T>
+struct pointer_stride<T const> : pointer_stride<T> {};
+template <typename T>
+struct pointer_stride<T volatile> : pointer_stride<T> {};
+template <typename T>
+struct pointer_stride<T const volatile> : pointer_stride<T> {};
+
 template <typename T, size_t = (alignof(T) == sizeof(T)) * sizeof(T)>
 struct interpreted_type;
 template <typename T>
@@ -1231,7 +1246,7 @@ public:
         UTL_CONSTRAINT_CXX20(is_pointer_v<T>)
         UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) static inline value_type<T> fetch_add(
             T* ctx, ptrdiff_t value) noexcept {
-            static constexpr intptr_t stride = sizeof(T);
+            static constexpr intptr_t stride = pointer_stride<remove_pointer_t<T>>::value;
             using type UTL_NODEBUG = copy_cv_t<T, intptr_t>;
             return (value_type<T>)fetch_add((type*)ctx, (intptr_t)value * stride);
         }
@@ -1244,7 +1259,7 @@ public:
         UTL_CONSTRAINT_CXX20(is_pointer_v<T>)
         UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) static inline value_type<T> fetch_sub(
             T* ctx, ptrdiff_t value) noexcept {
-            static constexpr intptr_t stride = sizeof(T);
+            static constexpr intptr_t stride = pointer_stride<remove_pointer_t<T>>::value;
             using type UTL_NODEBUG = copy_cv_t<T, intptr_t>;
             return (value_type<T>)fetch_sub((type*)ctx, (intptr_t)value * stride);
         }
@@ -0,0 +1,6 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/benchmark/utl_benchmark.h"
+#include "utl/benchmark/utl_do_not_optimize.h"
@@ -0,0 +1,297 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/benchmark/utl_do_not_optimize.h"
+#include "utl/hardware/utl_instruction_barrier.h"
+#include "utl/preprocessor/utl_concatenation.h"
+#include "utl/tempus/utl_clock.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace benchmark {
+namespace details {
+
+#if UTL_ARCH_x86_64 || UTL_ARCH_AARCH64
+
+/**
+ * @return the hardware clock, fenced according to `o` so that the timed instructions do not
+ * migrate across the reading
+ */
+template <instruction_barrier O>
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline int64_t ticks(
+    instruction_barrier_type<O> o) noexcept {
+    return get_time(tempus::hardware_clock, o).time_since_epoch().value();
+}
+
+#else
+
+template <instruction_barrier O>
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline int64_t ticks(
+    instruction_barrier_type<O>) noexcept {
+    auto const now = get_time(tempus::steady_clock).time_since_epoch();
+    return static_cast<int64_t>(now.seconds()) * 1000000000 + now.nanoseconds();
+}
+
+#endif
+
+/**
+ * @return the length of a tick of `ticks` in nanoseconds, calibrated against the steady clock if
+ * the hardware does not report an invariant frequency
+ */
+UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) double nanoseconds_per_tick() noexcept;
+
+} // namespace details
+
+/**
+ * Timing state handed to a benchmark function
+ *
+ * A benchmark runs its operation once per element of the state, only the loop is timed:
+ *
+ *     void string_append(utl::benchmark::state& state) {
+ *         for (auto _ : state) {
+ *             utl::string s;
+ *             s.append("value");
+ *             utl::benchmark::do_not_optimize(s);
+ *         }
+ *     }
+ *     UTL_BENCHMARK(string_append);
+ */
+class __UTL_ABI_PUBLIC state {
+public:
+    /**
+     * Element of the loop, the user-provided destructor keeps unused loop variables from being
+     * diagnosed
+     */
+    struct value {
+        __UTL_HIDE_FROM_ABI inline ~value() noexcept {}
+    };
+
+    class iterator {
+    public:
+        __UTL_HIDE_FROM_ABI inline constexpr iterator(state* parent, uint64_t remaining) noexcept
+            : parent_(parent)
+            , remaining_(remaining) {}
+
+        UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline value
+        operator*() const noexcept {
+            return {};
+        }
+
+        UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline iterator& operator++() noexcept {
+            return *this;
+        }
+
+        /**
+         * Counts down the iterations, the end of the loop stops the timer
+         */
+        UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool operator!=(
+            iterator const&) noexcept {
+            if (remaining_ != 0) UTL_LIKELY {
+                --remaining_;
+                return true;
+            }
+
+            parent_->stop();
+            return false;
+        }
+
+    private:
+        state* parent_;
+        uint64_t remaining_;
+    };
+
+    __UTL_HIDE_FROM_ABI explicit inline constexpr state(uint64_t iterations) noexcept
+        : iterations_(iterations)
+        , items_(1)
+        , begin_(0)
+        , elapsed_(0) {}
+
+    state(state const&) = delete;
+    state& operator=(state const&) = delete;
+
+    /**
+     * Starts the timer
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline iterator begin() noexcept {
+        elapsed_ = 0;
+        begin_ = details::ticks(instruction_barrier_after);
+        return iterator(this, iterations_);
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline iterator end() noexcept {
+        return iterator(this, 0);
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline uint64_t
+    iterations() const noexcept {
+        return iterations_;
+    }
+
+    /**
+     * Sets the number of operations performed by one iteration, which scales the reported
+     * throughput
+     */
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void set_items_per_iteration(
+        uint64_t items) noexcept {
+        items_ = items;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline uint64_t
+    items_per_iteration() const noexcept {
+        return items_;
+    }
+
+    /**
+     * Excludes the work until `resume_timing` from the measurement, e.g. per-iteration setup
+     */
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void pause_timing() noexcept {
+        elapsed_ += details::ticks(instruction_barrier_before) - begin_;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void resume_timing() noexcept {
+        begin_ = details::ticks(instruction_barrier_after);
+    }
+
+    /**
+     * @return the ticks spent in the loop, excluding paused intervals
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline int64_t
+    elapsed_ticks() const noexcept {
+        return elapsed_;
+    }
+
+private:
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void stop() noexcept {
+        elapsed_ += details::ticks(instruction_barrier_before) - begin_;
+    }
+
+    uint64_t iterations_;
+    uint64_t items_;
+    int64_t begin_;
+    int64_t elapsed_;
+};
+
+using function_type = void (*)(state&);
+
+struct __UTL_ABI_PUBLIC options {
+    /**
+     * Number of timed samples
+     */
+    uint32_t repetitions = 15;
+    /**
+     * Minimum time spent running the benchmark before the first sample
+     */
+    uint64_t warmup_ns = 50000000;
+    /**
+     * Minimum duration of a sample, the iteration count is scaled until a sample takes this long
+     */
+    uint64_t min_sample_ns = 5000000;
+    /**
+     * Samples further than `outlier_fence` interquartile ranges outside of the quartiles are
+     * rejected, 0 keeps every sample
+     */
+    double outlier_fence = 1.5;
+};
+
+/**
+ * Statistics of one benchmark, times are nanoseconds per iteration over the retained samples
+ */
+struct __UTL_ABI_PUBLIC result {
+    char const* name;
+    uint64_t iterations;
+    uint32_t samples;
+    uint32_t outliers;
+    double min;
+    double median;
+    double mean;
+    double stddev;
+    double p90;
+    double p99;
+    double max;
+    double items_per_second;
+};
+
+enum class format {
+    console,
+    csv,
+    json
+};
+
+/**
+ * Benchmark registered for `run_all`, see `UTL_BENCHMARK`
+ */
+class __UTL_ABI_PUBLIC registration {
+public:
+    registration(char const* name, function_type function) noexcept;
+    registration(registration const&) = delete;
+    registration& operator=(registration const&) = delete;
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline char const*
+    name() const noexcept {
+        return name_;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline function_type
+    function() const noexcept {
+        return function_;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline registration const*
+    next() const noexcept {
+        return next_;
+    }
+
+    /**
+     * @return the first registered benchmark, benchmarks are listed in registration order
+     */
+    UTL_ATTRIBUTES(NODISCARD) static registration const* first() noexcept;
+
+private:
+    char const* name_;
+    function_type function_;
+    registration* next_;
+};
+
+/**
+ * Warms up, scales the iteration count until a sample lasts `min_sample_ns`, then takes
+ * `repetitions` samples and rejects outliers
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) result run(
+    char const* name, function_type function, options const& config) noexcept;
+
+/**
+ * Runs the registered benchmarks and writes their results to the standard output
+ *
+ * Arguments:
+ * - `--format=console|csv|json`
+ * - `--filter=<text>` runs the benchmarks whose name contains `text`
+ * - `--repetitions=<n>`, `--warmup-ms=<n>`, `--min-time-ms=<n>`, `--outlier-fence=<x>`
+ *
+ * @return 0 on success, 1 if the arguments are invalid
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) int run_all(int argc, char** argv) noexcept;
+
+} // namespace benchmark
+
+UTL_NAMESPACE_END
+
+/**
+ * Registers the function `FUNCTION`, taking a `utl::benchmark::state&`, under its own name
+ */
+#define UTL_BENCHMARK(FUNCTION)                                                     \
+    static __UTL benchmark::registration const UTL_CONCAT(__utl_benchmark_, FUNCTION) { \
+        #FUNCTION, &FUNCTION                                                        \
+    }
+
+/**
+ * Defines a `main` running every benchmark registered in the executable
+ */
+#define UTL_BENCHMARK_MAIN()                      \
+    int main(int argc, char** argv) {             \
+        return __UTL benchmark::run_all(argc, argv); \
+    }
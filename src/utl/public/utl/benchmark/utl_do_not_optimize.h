@@ -0,0 +1,66 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/memory/utl_addressof.h"
+
+UTL_NAMESPACE_BEGIN
+
+namespace benchmark {
+
+#if UTL_SUPPORTS_GNU_ASM
+
+/**
+ * Forces `value` to be materialised, so that the computation producing it is not removed
+ */
+template <typename T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void do_not_optimize(T const& value) noexcept {
+    __asm__ __volatile__("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Forces `value` to be materialised and assumes it is modified, so that later reads are not folded
+ * into the computation producing it
+ */
+template <typename T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void do_not_optimize(T& value) noexcept {
+#  if UTL_COMPILER_CLANG
+    __asm__ __volatile__("" : "+r,m"(value) : : "memory");
+#  else
+    __asm__ __volatile__("" : "+m,r"(value) : : "memory");
+#  endif
+}
+
+#else
+
+namespace details {
+UTL_ATTRIBUTES(_ABI_PUBLIC) void escape(void const volatile* ptr) noexcept;
+} // namespace details
+
+/**
+ * Forces `value` to be materialised, so that the computation producing it is not removed
+ *
+ * Without GNU inline assembly the address of `value` escapes to a function defined in another
+ * translation unit, which also forces `value` to memory.
+ */
+template <typename T>
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void do_not_optimize(T const& value) noexcept {
+    details::escape(__UTL addressof(value));
+    UTL_COMPILER_BARRIER();
+}
+
+#endif
+
+/**
+ * Forces pending writes to memory to be emitted before the barrier and memory to be reloaded after
+ * it, without emitting any instruction
+ */
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void clobber_memory() noexcept {
+    UTL_COMPILER_BARRIER();
+}
+
+} // namespace benchmark
+
+UTL_NAMESPACE_END
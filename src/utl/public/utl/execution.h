@@ -0,0 +1,6 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/execution/utl_thread_pool.h"
+#include "utl/execution/utl_wait_group.h"
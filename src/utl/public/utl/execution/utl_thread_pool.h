@@ -0,0 +1,209 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/exception.h"
+#include "utl/execution/utl_wait_group.h"
+#include "utl/memory/utl_addressof.h"
+#include "utl/memory/utl_pool_allocator.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/type_traits/utl_decay.h"
+#include "utl/type_traits/utl_remove_reference.h"
+#include "utl/utility/utl_forward.h"
+#include "utl/utility/utl_move.h"
+
+#include <new>
+#include <stddef.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace execution {
+namespace details {
+
+struct pool_state;
+
+/**
+ * Type-erased unit of work, `next` links tasks submitted from outside the pool
+ */
+struct task {
+    void (*run)(task*) noexcept;
+    task* next;
+};
+
+/**
+ * Task running a callable, allocated from the size-class pool so that submitting does not go
+ * through the global allocation functions
+ */
+template <typename F>
+class closure : private task {
+    using allocator_type = pool_allocator<closure>;
+
+public:
+    template <typename Fn>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) static inline task* make(Fn&& function) UTL_THROWS {
+        allocator_type alloc;
+        closure* const result = alloc.allocate(1);
+        UTL_TRY {
+            ::new (static_cast<void*>(result)) closure(__UTL forward<Fn>(function));
+        } UTL_CATCH(...) {
+            alloc.deallocate(result, 1);
+            UTL_RETHROW();
+        }
+
+        return result;
+    }
+
+private:
+    template <typename Fn>
+    __UTL_HIDE_FROM_ABI explicit inline closure(Fn&& function)
+        : task{&invoke, nullptr}
+        , function_(__UTL forward<Fn>(function)) {}
+
+    /**
+     * The block is released before the callable runs, so that tasks it spawns can reuse it
+     */
+    __UTL_HIDE_FROM_ABI static void invoke(task* base) noexcept {
+        closure* const self = static_cast<closure*>(base);
+        F function = __UTL move(self->function_);
+        self->~closure();
+        allocator_type().deallocate(self, 1);
+        function();
+    }
+
+    F function_;
+};
+
+template <typename F>
+struct grouped {
+    __UTL_HIDE_FROM_ABI inline void operator()() {
+        function();
+        group->done();
+    }
+
+    wait_group* group;
+    F function;
+};
+
+} // namespace details
+} // namespace execution
+
+/**
+ * Fixed-size pool of worker threads with work stealing
+ *
+ * Each worker owns a Chase-Lev deque: tasks submitted by a worker are pushed to and popped from the
+ * bottom of its own deque without contention, and idle workers steal from the top of the deque of
+ * a randomly chosen worker. Tasks submitted from other threads go through a shared queue. A worker
+ * that finds nothing to run spins briefly and then parks on an event count until work arrives.
+ *
+ * Tasks must not throw, an exception escaping a task terminates the program.
+ */
+class __UTL_ABI_PUBLIC thread_pool {
+public:
+    /**
+     * @param workers number of worker threads, 0 selects one per hardware thread
+     */
+    explicit thread_pool(size_t workers = 0) UTL_THROWS;
+    thread_pool(thread_pool const&) = delete;
+    thread_pool& operator=(thread_pool const&) = delete;
+    /**
+     * Runs every submitted task, then joins the workers
+     */
+    ~thread_pool() noexcept;
+
+    UTL_ATTRIBUTES(NODISCARD) size_t size() const noexcept;
+
+    template <typename F>
+    __UTL_HIDE_FROM_ABI inline void submit(F&& function) UTL_THROWS {
+        schedule(execution::details::closure<decay_t<F>>::make(__UTL forward<F>(function)));
+    }
+
+    /**
+     * Submits a task that is counted by `group`
+     */
+    template <typename F>
+    __UTL_HIDE_FROM_ABI inline void submit(wait_group& group, F&& function) UTL_THROWS {
+        group.add(1);
+        UTL_TRY {
+            submit(execution::details::grouped<decay_t<F>>{
+                __UTL addressof(group), __UTL forward<F>(function)});
+        } UTL_CATCH(...) {
+            group.done();
+            UTL_RETHROW();
+        }
+    }
+
+    /**
+     * Calls `function(first, last)` on disjoint subranges covering [first, last), each at most
+     * `grain` long, and returns once all of them have completed
+     *
+     * The range is split in halves recursively so that stealing a task takes a large share of the
+     * remaining work. The calling thread runs part of the range and helps with queued tasks while
+     * waiting, so this may be called from inside a task. If splitting the range or a call on the
+     * calling thread throws, the exception propagates once the subranges already handed out have
+     * completed.
+     */
+    template <typename F>
+    __UTL_HIDE_FROM_ABI inline void parallel_for(
+        size_t first, size_t last, size_t grain, F&& function) {
+        if (first >= last) {
+            return;
+        }
+
+        wait_group group;
+        group.add(1);
+        UTL_TRY {
+            range_task<remove_reference_t<F>>{this, __UTL addressof(group),
+                __UTL addressof(function), first, last, __UTL numeric::max(grain, size_t(1))}();
+        } UTL_CATCH(...) {
+            // Subtasks already submitted refer to `group` and `function`, they must finish before
+            // either goes out of scope
+            group.done();
+            wait(group);
+            UTL_RETHROW();
+        }
+
+        wait(group);
+    }
+
+    /**
+     * Runs queued tasks on the calling thread until `group` completes, blocking only when there is
+     * nothing left to run
+     */
+    void wait(wait_group& group) noexcept;
+
+private:
+    template <typename F>
+    struct range_task {
+        __UTL_HIDE_FROM_ABI inline void operator()() {
+            while (last - first > grain) {
+                size_t const middle = first + (last - first) / 2;
+                group->add(1);
+                UTL_TRY {
+                    pool->submit(range_task{pool, group, function, middle, last, grain});
+                } UTL_CATCH(...) {
+                    group->done();
+                    UTL_RETHROW();
+                }
+                last = middle;
+            }
+
+            (*function)(first, last);
+            group->done();
+        }
+
+        thread_pool* pool;
+        wait_group* group;
+        F* function;
+        size_t first;
+        size_t last;
+        size_t grain;
+    };
+
+    void schedule(execution::details::task* task) noexcept;
+
+    execution::details::pool_state* state_;
+};
+
+UTL_NAMESPACE_END
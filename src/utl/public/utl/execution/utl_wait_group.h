@@ -0,0 +1,73 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/assert/utl_assert.h"
+#include "utl/atomic/utl_atomic.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Reusable counter of outstanding work occupying a single 32-bit word
+ *
+ * `add` registers work before it is handed out and `done` retires it; `wait` blocks until the
+ * count drops to zero. The top bit records blocked waiters so that `done` only makes a system call
+ * when someone is waiting. Inside a `thread_pool`, prefer `thread_pool::wait`, which runs queued
+ * tasks instead of blocking.
+ */
+class __UTL_ABI_PUBLIC wait_group {
+public:
+    __UTL_HIDE_FROM_ABI constexpr wait_group() noexcept : state_(0) {}
+    wait_group(wait_group const&) = delete;
+    wait_group& operator=(wait_group const&) = delete;
+    __UTL_HIDE_FROM_ABI ~wait_group() noexcept = default;
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void add(uint32_t n = 1) noexcept {
+        uint32_t const previous = atomic_relaxed::fetch_add(&state_, n);
+        UTL_ASSERT(((previous & count_mask) + n) <= count_mask);
+        (void)previous;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void done() noexcept {
+        uint32_t previous = atomic_relaxed::load(&state_);
+        while (true) {
+            UTL_ASSERT((previous & count_mask) != 0);
+            // The last unit clears the waiting bit in the same step, a waiter may return and
+            // destroy the group as soon as the count is zero
+            uint32_t const next = (previous & count_mask) == 1 ? 0 : previous - 1;
+            if (atomic_acq_rel::compare_exchange_weak(
+                    &state_, &previous, next, atomics::relaxed_failure)) {
+                break;
+            }
+        }
+
+        if (previous == (waiting | 1)) {
+            wake();
+        }
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool try_wait() const noexcept {
+        return (atomic_acquire::load(&state_) & count_mask) == 0;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void wait() noexcept {
+        if (!try_wait()) {
+            wait_contended();
+        }
+    }
+
+private:
+    static constexpr uint32_t waiting = uint32_t(1) << 31;
+    static constexpr uint32_t count_mask = waiting - 1;
+
+    void wait_contended() noexcept;
+    void wake() noexcept;
+
+    uint32_t state_;
+};
+
+UTL_NAMESPACE_END
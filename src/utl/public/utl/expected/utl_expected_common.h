@@ -5,12 +5,20 @@
 #include "utl/utl_config.h"
 
 #include "utl/type_traits/utl_constants.h"
+#include "utl/type_traits/utl_is_trivially_relocatable.h"
+#include "utl/type_traits/utl_is_void.h"
+#include "utl/type_traits/utl_logical_traits.h"
 
 UTL_NAMESPACE_BEGIN
 
 template <typename T, typename E>
 class __UTL_PUBLIC_TEMPLATE expected;
 
+template <typename T, typename E>
+struct __UTL_PUBLIC_TEMPLATE is_trivially_relocatable<expected<T, E>> :
+    conjunction<disjunction<is_void<T>, is_trivially_relocatable<T>>,
+        is_trivially_relocatable<E>> {};
+
 namespace details {
 template <typename T>
 struct __UTL_PUBLIC_TEMPLATE is_expected_type : false_type {};
@@ -57,7 +57,7 @@ UTL_ATTRIBUTES(ALWAYS_INLINE, MAYBE_UNUSED) inline uint64_t cntvct(
 UTL_ATTRIBUTES(ALWAYS_INLINE, MAYBE_UNUSED) inline uint64_t cntvct(
     decltype(instruction_barrier_none)) noexcept {
     uint64_t res;
-    __asm__("mrs %0, CNTVCT_EL0\n\t" : "=r"(res) : :);
+    __asm__ __volatile__("mrs %0, CNTVCT_EL0\n\t" : "=r"(res) : :);
     return res;
 }
 
@@ -0,0 +1,30 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/hardware/x86/utl_pause.h"
+
+#define UTL_PLATFORM_PAUSE_PRIVATE_HEADER_GUARD
+#include "utl/hardware/arm/utl_yield.h"
+#undef UTL_PLATFORM_PAUSE_PRIVATE_HEADER_GUARD
+
+UTL_NAMESPACE_BEGIN
+
+namespace hardware {
+/**
+ * Hints to the processor that the calling thread is in a spin-wait loop, which lowers the power
+ * consumed by the loop and yields pipeline resources to a sibling hardware thread. Resolves to
+ * no-op on architectures without such a hint.
+ */
+UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void pause() noexcept {
+#if UTL_ARCH_x86
+    __UTL x86::pause();
+#elif UTL_ARCH_ARM
+    __UTL arm::yield();
+#endif
+}
+} // namespace hardware
+
+UTL_NAMESPACE_END
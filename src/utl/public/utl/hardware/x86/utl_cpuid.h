@@ -14,7 +14,9 @@
 
 #  if UTL_COMPILER_MSVC
 extern "C" void __cpuid(int*, int);
+extern "C" void __cpuidex(int*, int, int);
 #    pragma intrinsic(__cpuid)
+#    pragma intrinsic(__cpuidex)
 #  endif
 
 UTL_NAMESPACE_BEGIN
@@ -30,23 +32,24 @@ struct cpuid_t {
 
 #  if UTL_SUPPORTS_GNU_ASM
 
-template <uint32_t Arg>
+template <uint32_t Arg, uint32_t Subleaf = 0>
 UTL_ATTRIBUTE(ALWAYS_INLINE) inline cpuid_t cpuid() noexcept {
     cpuid_t result;
     result.eax = Arg;
+    result.ecx = Subleaf;
     __asm__ volatile("cpuid"
                      : "=a"(result.eax), "=b"(result.ebx), "=c"(result.ecx), "=d"(result.edx)
-                     : "a"(result.eax)
+                     : "a"(result.eax), "c"(result.ecx)
                      : "memory");
     return result;
 }
 
 #  elif UTL_COMPILER_MSVC // UTL_SUPPORTS_GNU_ASM
 
-template <uint32_t Arg>
+template <uint32_t Arg, uint32_t Subleaf = 0>
 UTL_ATTRIBUTE(ALWAYS_INLINE) inline cpuid_t cpuid() noexcept {
     cpuid_t result;
-    __cpuid(reinterpret_cast<uint32_t*>(&result), Arg);
+    __cpuidex(reinterpret_cast<int*>(&result), Arg, Subleaf);
     return result;
 }
 
@@ -54,7 +57,7 @@ UTL_ATTRIBUTE(ALWAYS_INLINE) inline cpuid_t cpuid() noexcept {
 
 UTL_PRAGMA_WARN("Unrecognized target/compiler");
 
-template <int Arg>
+template <int Arg, int Subleaf = 0>
 UTL_ATTRIBUTE(NORETURN) cpuid_t cpuid() noexcept {
     static_assert(always_false<value_constant<Arg>>(), "Unrecognized target/compiler");
     UTL_BUILTIN_unreachable();
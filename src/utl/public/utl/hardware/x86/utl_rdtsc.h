@@ -39,14 +39,13 @@ namespace {
 UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t rdtsc(decltype(instruction_barrier_none)) noexcept {
     uint64_t high;
     uint64_t low;
-    __asm__("rdtsc" : "=a"(low), "=d"(high) : :);
+    __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high) : :);
     return (high << 32) | low;
 }
 
 UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t rdtsc(decltype(instruction_barrier_after)) noexcept {
     uint64_t high;
     uint64_t low;
-    uint32_t aux;
     __asm__("rdtsc\n\t"
             "lfence"
             : "=a"(low), "=d"(high)
@@ -59,7 +58,6 @@ UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t rdtsc(decltype(instruction_barrier_
 UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t rdtsc(decltype(instruction_barrier_before)) noexcept {
     uint64_t high;
     uint64_t low;
-    uint32_t aux;
     __asm__("mfence\n\t"
             "lfence\n\t"
             "rdtsc"
@@ -72,7 +70,6 @@ UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t rdtsc(decltype(instruction_barrier_
 UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t rdtsc(decltype(instruction_barrier_enclose)) noexcept {
     uint64_t high;
     uint64_t low;
-    uint32_t aux;
     __asm__("mfence\n\t"
             "lfence\n\t"
             "rdtsc\n\t"
@@ -0,0 +1,69 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#if UTL_ARCH_x86
+
+#  include "utl/configuration/utl_pragma.h"
+
+#  include "utl/type_traits/utl_constants.h"
+
+#  include <stdint.h>
+
+#  if UTL_COMPILER_MSVC
+
+UTL_EXTERN_C_BEGIN
+unsigned __int64 _xgetbv(unsigned int);
+UTL_EXTERN_C_END
+
+#    pragma intrinsic(_xgetbv)
+
+#  endif
+
+UTL_NAMESPACE_BEGIN
+
+namespace x86 {
+namespace {
+
+/**
+ * Reads an extended control register
+ *
+ * Must only be executed if CPUID.1:ECX.OSXSAVE[bit 27] is set
+ */
+#  if UTL_SUPPORTS_GNU_ASM
+
+template <uint32_t Register>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t xgetbv() noexcept {
+    uint32_t high;
+    uint32_t low;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(Register));
+    return ((uint64_t)high << 32) | low;
+}
+
+#  elif UTL_COMPILER_MSVC // UTL_SUPPORTS_GNU_ASM
+
+template <uint32_t Register>
+UTL_ATTRIBUTE(ALWAYS_INLINE) inline uint64_t xgetbv() noexcept {
+    return _xgetbv(Register);
+}
+
+#  else
+
+UTL_PRAGMA_WARN("Unrecognized target/compiler");
+
+template <uint32_t Register>
+UTL_ATTRIBUTE(NORETURN) uint64_t xgetbv() noexcept {
+    static_assert(always_false<value_constant<Register>>(), "Unrecognized target/compiler");
+    UTL_BUILTIN_unreachable();
+}
+
+#  endif // UTL_SUPPORTS_GNU_ASM
+
+} // namespace
+} // namespace x86
+
+UTL_NAMESPACE_END
+
+#endif // UTL_ARCH_x86
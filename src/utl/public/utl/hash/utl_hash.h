@@ -0,0 +1,135 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/hash/utl_hash_fwd.h"
+#include "utl/span/utl_span_fwd.h"
+#include "utl/string/utl_string_fwd.h"
+
+#include "utl/byte/utl_byte.h"
+#include "utl/hash/utl_hash_accelerated.h"
+#include "utl/hash/utl_wyhash.h"
+#include "utl/string/utl_basic_string_view.h"
+
+#include <stdint.h>
+
+#define __UTL_ATTRIBUTE_HASH_PURE (PURE)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_HASH_PURE
+
+UTL_NAMESPACE_BEGIN
+
+namespace details {
+namespace hashing {
+/**
+ * Common base of the seeded hashers, hashers constructed with different seeds produce unrelated
+ * hashes for the same key
+ */
+class seeded {
+public:
+    __UTL_HIDE_FROM_ABI inline constexpr seeded() noexcept : seed_(__UTL hashing::default_seed) {}
+    __UTL_HIDE_FROM_ABI explicit inline constexpr seeded(uint64_t seed) noexcept : seed_(seed) {}
+
+    UTL_ATTRIBUTE(HASH_PURE) inline constexpr uint64_t seed() const noexcept { return seed_; }
+
+protected:
+    uint64_t seed_;
+};
+} // namespace hashing
+} // namespace details
+
+/**
+ * Strings are hashed with `hashing::wyhash`, which is usable in constant expressions so hashes of
+ * literals can be computed at compile time
+ */
+template <typename CharType, typename Traits>
+struct __UTL_PUBLIC_TEMPLATE hash<basic_string_view<CharType, Traits>> :
+    details::hashing::seeded {
+    using details::hashing::seeded::seeded;
+
+    UTL_ATTRIBUTE(HASH_PURE) inline UTL_CONSTEXPR_CXX14 size_t operator()(
+        basic_string_view<CharType, Traits> str) const noexcept {
+        return static_cast<size_t>(hashing::wyhash(str.data(), str.size(), seed_));
+    }
+};
+
+template <typename CharType, typename Traits>
+struct __UTL_PUBLIC_TEMPLATE hash<basic_zstring_view<CharType, Traits>> :
+    hash<basic_string_view<CharType, Traits>> {
+    using hash<basic_string_view<CharType, Traits>>::hash;
+};
+
+template <typename CharType, size_t N, typename Traits, typename Alloc, typename Growth>
+struct __UTL_PUBLIC_TEMPLATE hash<basic_short_string<CharType, N, Traits, Alloc, Growth>> :
+    hash<basic_string_view<CharType, Traits>> {
+    using hash<basic_string_view<CharType, Traits>>::hash;
+
+    UTL_ATTRIBUTE(HASH_PURE) inline UTL_CONSTEXPR_CXX14 size_t operator()(
+        basic_short_string<CharType, N, Traits, Alloc, Growth> const& str) const noexcept {
+        return static_cast<size_t>(hashing::wyhash(str.data(), str.size(), this->seed_));
+    }
+};
+
+template <size_t E>
+struct __UTL_PUBLIC_TEMPLATE hash<span<byte const, E>> : details::hashing::seeded {
+    using details::hashing::seeded::seeded;
+
+    UTL_ATTRIBUTE(HASH_PURE) inline UTL_CONSTEXPR_CXX14 size_t operator()(
+        span<byte const, E> bytes) const noexcept {
+        return static_cast<size_t>(hashing::wyhash(bytes.data(), bytes.size(), seed_));
+    }
+};
+
+template <size_t E>
+struct __UTL_PUBLIC_TEMPLATE hash<span<byte, E>> : details::hashing::seeded {
+    using details::hashing::seeded::seeded;
+
+    UTL_ATTRIBUTE(HASH_PURE) inline UTL_CONSTEXPR_CXX14 size_t operator()(
+        span<byte, E> bytes) const noexcept {
+        return static_cast<size_t>(hashing::wyhash(bytes.data(), bytes.size(), seed_));
+    }
+};
+
+namespace hashing {
+
+/**
+ * Transparent string hasher, any string type convertible to `basic_string_view` hashes to the
+ * same value as its view which allows heterogeneous lookup
+ */
+template <typename CharType, typename Traits = char_traits<CharType>>
+struct __UTL_PUBLIC_TEMPLATE basic_string_hash : hash<basic_string_view<CharType, Traits>> {
+    using is_transparent = void;
+    using hash<basic_string_view<CharType, Traits>>::hash;
+};
+
+/**
+ * Transparent string hasher using the fastest kernel in `hashing::accelerated`
+ *
+ * Not usable in constant expressions and the hashes differ between CPUs, see
+ * `hashing::accelerated::hash`.
+ */
+template <typename CharType, typename Traits = char_traits<CharType>>
+struct __UTL_PUBLIC_TEMPLATE basic_accelerated_string_hash : details::hashing::seeded {
+    using is_transparent = void;
+    using details::hashing::seeded::seeded;
+
+    UTL_ATTRIBUTE(HASH_PURE) inline size_t operator()(
+        basic_string_view<CharType, Traits> str) const noexcept {
+        return static_cast<size_t>(
+            accelerated::hash(str.data(), str.size() * sizeof(CharType), seed_));
+    }
+};
+
+using string_hash = basic_string_hash<char>;
+using wstring_hash = basic_string_hash<wchar_t>;
+using u16string_hash = basic_string_hash<char16_t>;
+using u32string_hash = basic_string_hash<char32_t>;
+using accelerated_string_hash = basic_accelerated_string_hash<char>;
+
+} // namespace hashing
+
+UTL_NAMESPACE_END
+
+#undef __UTL_ATTRIBUTE_HASH_PURE
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_HASH_PURE
@@ -0,0 +1,41 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+#define __UTL_ATTRIBUTE_HASH_ACCELERATED (PURE)(NODISCARD) __UTL_ATTRIBUTE__ABI_PUBLIC
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_HASH_ACCELERATED
+
+namespace hashing {
+/**
+ * Hardware accelerated hash kernels
+ *
+ * The AES kernel requires AES-NI and the CRC32C kernel SSE4.2 on x86-64; if the executing CPU
+ * lacks the instructions, or on other targets, they fall back to `wyhash`. The result therefore
+ * depends on the executing CPU and must not be persisted or compared across processes, use
+ * `wyhash` for stable hashes.
+ */
+namespace accelerated {
+
+/**
+ * Hashes with the fastest kernel supported by the executing CPU, selected once on first use
+ */
+UTL_ATTRIBUTE(HASH_ACCELERATED) uint64_t hash(
+    void const* data, size_t bytes, uint64_t seed) noexcept;
+UTL_ATTRIBUTE(HASH_ACCELERATED) uint64_t aes(
+    void const* data, size_t bytes, uint64_t seed) noexcept;
+UTL_ATTRIBUTE(HASH_ACCELERATED) uint64_t crc32c(
+    void const* data, size_t bytes, uint64_t seed) noexcept;
+
+} // namespace accelerated
+} // namespace hashing
+
+#undef __UTL_ATTRIBUTE_HASH_ACCELERATED
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_HASH_ACCELERATED
+
+UTL_NAMESPACE_END
@@ -0,0 +1,12 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+UTL_NAMESPACE_BEGIN
+
+template <typename>
+struct __UTL_PUBLIC_TEMPLATE hash;
+
+UTL_NAMESPACE_END
@@ -0,0 +1,223 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/bit/utl_endian.h"
+#include "utl/utility/utl_constant_p.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#define __UTL_ATTRIBUTE_HASH_PURE (PURE)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_HASH_PURE
+#define __UTL_ATTRIBUTE_HASH_INLINE (ALWAYS_INLINE) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_HASH_INLINE
+
+UTL_NAMESPACE_BEGIN
+
+namespace hashing {
+UTL_INLINE_CXX17 constexpr uint64_t default_seed = 0x9e3779b97f4a7c15;
+} // namespace hashing
+
+namespace details {
+namespace hashing {
+
+UTL_INLINE_CXX17 constexpr uint64_t secret[4] = {
+    0x2d358dccaa6c78a5, 0x8bb84b93962eacc9, 0x4b33a62ed433d4a3, 0x4d5a2da51de1aa47};
+
+/**
+ * Full 64x64 bit multiplication, `a` receives the low half and `b` the high half
+ */
+UTL_ATTRIBUTE(HASH_INLINE) inline UTL_CONSTEXPR_CXX14 void multiply(
+    uint64_t& a, uint64_t& b) noexcept {
+#if UTL_SUPPORTS_INT128
+    __uint128_t const product = __uint128_t(a) * b;
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+#else
+    uint64_t const ha = a >> 32;
+    uint64_t const hb = b >> 32;
+    uint64_t const la = static_cast<uint32_t>(a);
+    uint64_t const lb = static_cast<uint32_t>(b);
+    uint64_t const hi = ha * hb;
+    uint64_t const mid0 = ha * lb;
+    uint64_t const mid1 = hb * la;
+    uint64_t const lo = la * lb;
+    uint64_t const t = lo + (mid0 << 32);
+    uint64_t carry = t < lo;
+    a = t + (mid1 << 32);
+    carry += a < t;
+    b = hi + (mid0 >> 32) + (mid1 >> 32) + carry;
+#endif
+}
+
+UTL_ATTRIBUTE(HASH_INLINE) inline UTL_CONSTEXPR_CXX14 uint64_t mix(
+    uint64_t a, uint64_t b) noexcept {
+    multiply(a, b);
+    return a ^ b;
+}
+
+/**
+ * Reads the little-endian byte representation of an array of integral elements in a constant
+ * expression, element `i` occupies bytes `[i * sizeof(T), (i + 1) * sizeof(T))`
+ */
+template <typename T>
+struct compile_time_reader {
+    T const* data;
+
+    UTL_ATTRIBUTE(HASH_PURE) inline constexpr uint64_t byte(size_t idx) const noexcept {
+        return (static_cast<uint64_t>(data[idx / sizeof(T)]) >> (8 * (idx % sizeof(T)))) & 0xFF;
+    }
+
+    UTL_ATTRIBUTE(HASH_PURE) inline UTL_CONSTEXPR_CXX14 uint64_t read(
+        size_t idx, size_t count) const noexcept {
+        uint64_t result = 0;
+        for (size_t i = 0; i < count; ++i) {
+            result |= byte(idx + i) << (8 * i);
+        }
+
+        return result;
+    }
+
+    UTL_ATTRIBUTE(HASH_PURE) inline UTL_CONSTEXPR_CXX14 uint64_t read8(size_t idx) const noexcept {
+        return read(idx, 8);
+    }
+
+    UTL_ATTRIBUTE(HASH_PURE) inline UTL_CONSTEXPR_CXX14 uint64_t read4(size_t idx) const noexcept {
+        return read(idx, 4);
+    }
+};
+
+/**
+ * Reads unaligned little-endian words from memory
+ */
+struct runtime_reader {
+    unsigned char const* data;
+
+    UTL_ATTRIBUTE(HASH_PURE) inline uint64_t byte(size_t idx) const noexcept { return data[idx]; }
+
+    UTL_ATTRIBUTE(HASH_PURE) inline uint64_t read8(size_t idx) const noexcept {
+        uint64_t value;
+        ::memcpy(&value, data + idx, sizeof(value));
+        return endian::native == endian::little ? value : swap(value);
+    }
+
+    UTL_ATTRIBUTE(HASH_PURE) inline uint64_t read4(size_t idx) const noexcept {
+        uint32_t value;
+        ::memcpy(&value, data + idx, sizeof(value));
+        return endian::native == endian::little ? value : swap(value) >> 32;
+    }
+
+private:
+    UTL_ATTRIBUTE(HASH_PURE) static inline uint64_t swap(uint64_t value) noexcept {
+        value = ((value & 0x00FF00FF00FF00FF) << 8) | ((value >> 8) & 0x00FF00FF00FF00FF);
+        value = ((value & 0x0000FFFF0000FFFF) << 16) | ((value >> 16) & 0x0000FFFF0000FFFF);
+        return (value << 32) | (value >> 32);
+    }
+};
+
+/**
+ * Reads between 1 and 3 bytes starting at `idx`
+ */
+template <typename Reader>
+UTL_ATTRIBUTE(HASH_INLINE) inline constexpr uint64_t read_small(
+    Reader const& reader, size_t idx, size_t count) noexcept {
+    return (reader.byte(idx) << 16) | (reader.byte(idx + (count >> 1)) << 8) |
+        reader.byte(idx + count - 1);
+}
+
+/**
+ * Hashes `length` bytes with the final version of wyhash
+ *
+ * Keys up to 16 bytes take a single multiplication, longer keys are consumed 48 bytes at a time
+ * in three independent lanes.
+ */
+template <typename Reader>
+UTL_ATTRIBUTE(HASH_PURE) inline UTL_CONSTEXPR_CXX14 uint64_t wyhash(
+    Reader const& reader, size_t length, uint64_t seed) noexcept {
+    seed ^= mix(seed ^ secret[0], secret[1]);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t const offset = (length >> 3) << 2;
+            a = (reader.read4(0) << 32) | reader.read4(offset);
+            b = (reader.read4(length - 4) << 32) | reader.read4(length - 4 - offset);
+        } else if (length > 0) {
+            a = read_small(reader, 0, length);
+        }
+    } else {
+        size_t idx = 0;
+        size_t remaining = length;
+        if (remaining > 48) {
+            uint64_t lane1 = seed;
+            uint64_t lane2 = seed;
+            do {
+                seed = mix(reader.read8(idx) ^ secret[1], reader.read8(idx + 8) ^ seed);
+                lane1 = mix(reader.read8(idx + 16) ^ secret[2], reader.read8(idx + 24) ^ lane1);
+                lane2 = mix(reader.read8(idx + 32) ^ secret[3], reader.read8(idx + 40) ^ lane2);
+                idx += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= lane1 ^ lane2;
+        }
+
+        while (remaining > 16) {
+            seed = mix(reader.read8(idx) ^ secret[1], reader.read8(idx + 8) ^ seed);
+            idx += 16;
+            remaining -= 16;
+        }
+
+        a = reader.read8(idx + remaining - 16);
+        b = reader.read8(idx + remaining - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    multiply(a, b);
+    return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+} // namespace hashing
+} // namespace details
+
+namespace hashing {
+
+/**
+ * Hashes the byte representation of `count` elements
+ *
+ * Usable in constant expressions, where the bytes of each element are taken in little-endian
+ * order. Runtime results match on little-endian targets, and for single byte elements on all
+ * targets.
+ */
+template <typename T>
+UTL_ATTRIBUTE(HASH_PURE) inline UTL_CONSTEXPR_CXX14 uint64_t wyhash(
+    T const* data, size_t count, uint64_t seed = default_seed) noexcept {
+    return UTL_CONSTANT_P(details::hashing::wyhash(
+               details::hashing::compile_time_reader<T>{data}, count * sizeof(T), seed))
+        ? details::hashing::wyhash(
+              details::hashing::compile_time_reader<T>{data}, count * sizeof(T), seed)
+        : details::hashing::wyhash(
+              details::hashing::runtime_reader{reinterpret_cast<unsigned char const*>(data)},
+              count * sizeof(T), seed);
+}
+
+/**
+ * Hashes `bytes` bytes of memory, not usable in constant expressions
+ */
+UTL_ATTRIBUTE(HASH_PURE) inline uint64_t wyhash_bytes(
+    void const* data, size_t bytes, uint64_t seed = default_seed) noexcept {
+    return details::hashing::wyhash(
+        details::hashing::runtime_reader{static_cast<unsigned char const*>(data)}, bytes, seed);
+}
+
+} // namespace hashing
+
+UTL_NAMESPACE_END
+
+#undef __UTL_ATTRIBUTE_HASH_PURE
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_HASH_PURE
+#undef __UTL_ATTRIBUTE_HASH_INLINE
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_HASH_INLINE
@@ -17,6 +17,16 @@ class __UTL_PUBLIC_TEMPLATE allocator;
 template <typename>
 struct __UTL_PUBLIC_TEMPLATE allocator_traits;
 
+class monotonic_arena;
+template <typename>
+class __UTL_PUBLIC_TEMPLATE arena_allocator;
+template <typename>
+class __UTL_PUBLIC_TEMPLATE pool_allocator;
+template <typename>
+class __UTL_PUBLIC_TEMPLATE malloc_allocator;
+template <typename>
+class __UTL_PUBLIC_TEMPLATE page_allocator;
+
 template <typename pointer, typename size_type>
 struct __UTL_PUBLIC_TEMPLATE allocation_result {
     pointer ptr;
@@ -6,6 +6,7 @@
 
 #include "utl/compare/utl_compare_traits.h"
 #include "utl/memory/utl_pointer_traits.h"
+#include "utl/memory/utl_relocate.h"
 #include "utl/memory/utl_to_address.h"
 #include "utl/numeric/utl_limits.h"
 #include "utl/string/utl_libc.h"
@@ -18,8 +19,10 @@
 #include "utl/type_traits/utl_is_pointer.h"
 #include "utl/type_traits/utl_is_same.h"
 #include "utl/type_traits/utl_is_swappable.h"
+#include "utl/type_traits/utl_is_trivially_relocatable.h"
 #include "utl/type_traits/utl_logical_traits.h"
 #include "utl/type_traits/utl_make_unsigned.h"
+#include "utl/type_traits/utl_remove_pointer.h"
 #include "utl/type_traits/utl_void_t.h"
 #include "utl/utility/utl_forward.h"
 #include "utl/utility/utl_move.h"
@@ -167,9 +170,21 @@ __UTL_HIDE_FROM_ABI UTL_CONSTEXPR_CXX20 pointer_t<T> fallback_reallocate(
     T& allocator, result_type_t<T> arg, size_type_t<T> size) {
     static_assert(
         is_pointer<pointer_t<T>>::value, "Only raw pointers can use the fallback reallocation");
+    // The whole allocation is moved without knowing which elements are alive
+    static_assert(is_trivially_relocatable<remove_pointer_t<pointer_t<T>>>::value,
+        "Only trivially relocatable types can use the fallback reallocation");
     auto dst = allocator.allocate(size);
-    auto blessed = libc::unsafe::memcpy(
-        __UTL to_address(dst), __UTL to_address(arg.ptr), libc::element_count_t(arg.size));
+    // Only the elements that fit are preserved when shrinking
+    auto const count = arg.size < size ? arg.size : size;
+    pointer_t<T> blessed;
+#if UTL_CXX20
+    if (UTL_BUILTIN_is_constant_evaluated()) {
+        blessed = libc::unsafe::memcpy(dst, arg.ptr, libc::element_count_t(count));
+    } else
+#endif
+    {
+        blessed = __UTL uninitialized_relocate(arg.ptr, arg.ptr + count, dst) - count;
+    }
     allocator.deallocate(arg.ptr, arg.size);
     return blessed;
 }
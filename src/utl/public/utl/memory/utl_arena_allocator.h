@@ -0,0 +1,156 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/memory/utl_allocator_fwd.h"
+
+#include "utl/exception/utl_program_exception.h"
+#include "utl/memory/utl_allocator_decl.h"
+#include "utl/memory/utl_monotonic_arena.h"
+#include "utl/memory/utl_relocate.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/type_traits/utl_constants.h"
+#include "utl/type_traits/utl_is_trivially_relocatable.h"
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Allocator that obtains memory from a `monotonic_arena`
+ *
+ * Deallocation only reclaims memory when it undoes the most recent allocation of the arena, the
+ * rest is reclaimed when the arena is reset or destroyed. `allocate_at_least` hands out the
+ * alignment padding that would otherwise be wasted, and `reallocate` grows the most recent
+ * allocation in place; otherwise the elements are relocated bytewise like
+ * `allocator_traits::reallocate`. Only trivially relocatable types can be reallocated.
+ *
+ * Copies and rebound copies share the arena, which must outlive every allocation.
+ */
+template <typename T>
+class __UTL_PUBLIC_TEMPLATE arena_allocator {
+    template <typename>
+    friend class arena_allocator;
+
+    /**
+     * Allocations are rounded up to this many bytes, the granularity of the default alignment
+     */
+    static constexpr size_t granularity = memory::details::default_new_alignment;
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = decltype((char*)(0) - (char*)(0));
+    using propagate_on_container_copy_assignment = true_type;
+    using propagate_on_container_move_assignment = true_type;
+    using propagate_on_container_swap = true_type;
+    using is_always_equal = false_type;
+
+private:
+    using pointer UTL_NODEBUG = value_type*;
+    using result_type UTL_NODEBUG = allocation_result<pointer, size_t>;
+
+public:
+    __UTL_HIDE_FROM_ABI explicit constexpr arena_allocator(monotonic_arena& arena) noexcept
+        : arena_(&arena) {}
+    __UTL_HIDE_FROM_ABI constexpr arena_allocator(arena_allocator const&) noexcept = default;
+    __UTL_HIDE_FROM_ABI UTL_CONSTEXPR_CXX14 arena_allocator& operator=(
+        arena_allocator const&) noexcept = default;
+
+    template <typename U>
+    __UTL_HIDE_FROM_ABI constexpr arena_allocator(arena_allocator<U> const& other) noexcept
+        : arena_(other.arena_) {}
+
+    __UTL_HIDE_FROM_ABI inline constexpr monotonic_arena* arena() const noexcept {
+        return arena_;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline pointer allocate(size_type count) UTL_THROWS {
+        check_count(count);
+        return static_cast<pointer>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline result_type allocate_at_least(
+        size_type count) UTL_THROWS {
+        check_count(count);
+        size_type const rounded = round(count);
+        return {static_cast<pointer>(arena_->allocate(rounded * sizeof(T), alignof(T))), rounded};
+    }
+
+    __UTL_HIDE_FROM_ABI inline void deallocate(pointer ptr, size_type count) noexcept {
+        arena_->deallocate(ptr, count * sizeof(T));
+    }
+
+    template <typename U = T UTL_CONSTRAINT_CXX11(is_trivially_relocatable<U>::value)>
+    UTL_CONSTRAINT_CXX20(is_trivially_relocatable_v<U>)
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline pointer reallocate(
+        result_type arg, size_type count) UTL_THROWS {
+        check_count(count);
+        if (arena_->extend(arg.ptr, arg.size * sizeof(T), count * sizeof(T))) {
+            return arg.ptr;
+        }
+
+        pointer const result = allocate(count);
+        if (arg.ptr != nullptr) {
+            size_type const preserved = __UTL numeric::min(arg.size, count);
+            return __UTL uninitialized_relocate(arg.ptr, arg.ptr + preserved, result) - preserved;
+        }
+        return result;
+    }
+
+    template <typename U = T UTL_CONSTRAINT_CXX11(is_trivially_relocatable<U>::value)>
+    UTL_CONSTRAINT_CXX20(is_trivially_relocatable_v<U>)
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline result_type reallocate_at_least(
+        result_type arg, size_type count) UTL_THROWS {
+        check_count(count);
+        size_type const rounded = round(count);
+        return {reallocate(arg, rounded), rounded};
+    }
+
+    template <typename U>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) friend inline constexpr bool operator==(
+        arena_allocator const& left, arena_allocator<U> const& right) noexcept {
+        return left.arena_ == right.arena();
+    }
+
+#if !UTL_CXX20
+    template <typename U>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) friend inline constexpr bool operator!=(
+        arena_allocator const& left, arena_allocator<U> const& right) noexcept {
+        return left.arena_ != right.arena();
+    }
+#endif
+
+private:
+    __UTL_HIDE_FROM_ABI static inline void check_count(size_type count) UTL_THROWS {
+        UTL_THROW_IF(count > memory::max_size<T>::value,
+            bad_array_new_length(
+                UTL_MESSAGE_FORMAT("[UTL] allocation operation failed, Reason=[element count "
+                                   "limit exceeded], count=[%zu], limit=[%zu]"),
+                count, memory::max_size<T>::value));
+    }
+
+    /**
+     * @return the largest element count whose size does not exceed `count` elements rounded up
+     * to the allocation granularity
+     */
+    UTL_ATTRIBUTES(NODISCARD, CONST, _HIDE_FROM_ABI) static inline constexpr size_type round(
+        size_type count) noexcept {
+        return ((count * sizeof(T) + granularity - 1) & ~(granularity - 1)) / sizeof(T);
+    }
+
+    monotonic_arena* arena_;
+};
+
+UTL_NAMESPACE_END
+
+#if !UTL_CXX17
+
+UTL_NAMESPACE_BEGIN
+
+template <typename T>
+__UTL_ABI_PUBLIC constexpr size_t arena_allocator<T>::granularity;
+
+UTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,205 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/assert/utl_assert.h"
+#include "utl/atomic/utl_atomic.h"
+#include "utl/memory/utl_retired.h"
+#include "utl/type_traits/utl_decay.h"
+#include "utl/utility/utl_forward.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace memory {
+namespace details {
+namespace epoch {
+
+UTL_INLINE_CXX17 constexpr size_t cache_line = 64;
+
+/**
+ * Announcement slot of a participant, records are reused by later participants and only freed
+ * with their domain so that a scan of the list never reads freed memory
+ */
+struct alignas(cache_line) record {
+    /**
+     * 0 while the owner is outside of a critical section, `epoch << 1 | 1` otherwise
+     */
+    uint64_t state;
+    record* next;
+    uint32_t in_use;
+};
+
+} // namespace epoch
+} // namespace details
+} // namespace memory
+
+/**
+ * Epoch-based memory reclamation domain
+ *
+ * Threads read shared lock-free structures inside critical sections. Entering a critical section
+ * announces the current global epoch in a slot owned by the thread, so readers never write to
+ * memory shared with other threads. An object unlinked from a structure is retired and reclaimed
+ * once the global epoch has advanced twice, at which point every critical section that could have
+ * observed it has ended. The epoch advances when every thread inside a critical section has
+ * announced the current epoch, so a thread stalled inside a critical section delays reclamation
+ * of every object in the domain; hazard pointers bound the memory held back in that case.
+ *
+ * Each thread accesses a domain through its own `participant`.
+ */
+class __UTL_ABI_PUBLIC epoch_domain {
+    using record = memory::details::epoch::record;
+    using retired = memory::details::retired;
+
+public:
+    class participant;
+    class guard;
+
+    epoch_domain() noexcept;
+    epoch_domain(epoch_domain const&) = delete;
+    epoch_domain& operator=(epoch_domain const&) = delete;
+    /**
+     * Reclaims every object retired to the domain, all participants must have been destroyed
+     */
+    ~epoch_domain() noexcept;
+
+    /**
+     * @return the process-wide domain, which is never destroyed
+     */
+    UTL_ATTRIBUTES(NODISCARD) static epoch_domain& global() noexcept;
+
+    /**
+     * @return the participant of the calling thread in the global domain, created on first use
+     * and destroyed when the thread exits
+     */
+    UTL_ATTRIBUTES(NODISCARD) static participant& local() UTL_THROWS;
+
+private:
+    record* acquire() UTL_THROWS;
+    void abandon(retired* head, retired* tail) noexcept;
+    retired* adopt() noexcept;
+    uint64_t advance() noexcept;
+
+    alignas(memory::details::epoch::cache_line) uint64_t epoch_;
+    alignas(memory::details::epoch::cache_line) record* records_;
+    /**
+     * Objects left by destroyed participants
+     */
+    retired* orphans_;
+};
+
+/**
+ * Registration of one thread with an epoch domain
+ *
+ * A participant must only be used by one thread at a time. Its retired objects are reclaimed by
+ * the participant itself, objects that are still pending when it is destroyed are handed to the
+ * domain and reclaimed by another participant.
+ */
+class __UTL_ABI_PUBLIC epoch_domain::participant {
+public:
+    /**
+     * Number of retired objects after which `retire` attempts to reclaim
+     */
+    static constexpr size_t collect_threshold = 64;
+
+    explicit participant(epoch_domain& domain) UTL_THROWS;
+    participant(participant const&) = delete;
+    participant& operator=(participant const&) = delete;
+    /**
+     * Must not be called inside of a critical section
+     */
+    ~participant() noexcept;
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline epoch_domain&
+    domain() const noexcept {
+        return *domain_;
+    }
+
+    /**
+     * Enters a critical section, critical sections nest
+     */
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void enter() noexcept {
+        if (nesting_++ == 0) {
+            uint64_t const epoch = atomic_acquire::load(&domain_->epoch_);
+            atomic_relaxed::store(&record_->state, (epoch << 1) | 1);
+            // Order the announcement before every load of a shared pointer
+            atomic_seq_cst::thread_fence();
+        }
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void leave() noexcept {
+        UTL_ASSERT(nesting_ != 0);
+        if (--nesting_ == 0) {
+            atomic_release::store(&record_->state, uint64_t(0));
+        }
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool
+    in_critical_section() const noexcept {
+        return nesting_ != 0;
+    }
+
+    /**
+     * Retires an object that has been unlinked from every shared structure, `deleter(ptr)` is
+     * called once no critical section can still be accessing it
+     *
+     * If allocating the retired node throws, the object is not retired.
+     */
+    template <typename T, typename D = memory::retire_delete>
+    __UTL_HIDE_FROM_ABI inline void retire(T* ptr, D&& deleter = D()) UTL_THROWS {
+        push(memory::details::retired_object<T, decay_t<D>>::make(ptr, __UTL forward<D>(deleter)));
+    }
+
+    /**
+     * Attempts to advance the epoch and reclaims every object of this participant, and objects
+     * abandoned to the domain, whose grace period has ended
+     */
+    void collect() noexcept;
+
+private:
+    void push(retired* node) noexcept;
+
+    record* record_;
+    epoch_domain* domain_;
+    uint32_t nesting_;
+    /**
+     * Retired objects, oldest first
+     */
+    retired* head_;
+    retired* tail_;
+    size_t pending_;
+};
+
+/**
+ * Scoped critical section
+ */
+class __UTL_ABI_PUBLIC epoch_domain::guard {
+public:
+    /**
+     * Enters a critical section of the calling thread in the global domain
+     */
+    __UTL_HIDE_FROM_ABI inline guard() UTL_THROWS : guard(epoch_domain::local()) {}
+
+    __UTL_HIDE_FROM_ABI explicit inline guard(participant& owner) noexcept : owner_(owner) {
+        owner_.enter();
+    }
+
+    guard(guard const&) = delete;
+    guard& operator=(guard const&) = delete;
+
+    __UTL_HIDE_FROM_ABI inline ~guard() noexcept { owner_.leave(); }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline participant&
+    owner() const noexcept {
+        return owner_;
+    }
+
+private:
+    participant& owner_;
+};
+
+UTL_NAMESPACE_END
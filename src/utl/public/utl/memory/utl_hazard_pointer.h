@@ -0,0 +1,223 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/assert/utl_assert.h"
+#include "utl/atomic/utl_atomic.h"
+#include "utl/memory/utl_retired.h"
+#include "utl/type_traits/utl_decay.h"
+#include "utl/utility/utl_forward.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace memory {
+namespace details {
+namespace hazard {
+
+UTL_INLINE_CXX17 constexpr size_t cache_line = 64;
+
+/**
+ * Hazard slot, records are reused by later hazard pointers and only freed with their domain so
+ * that a scan of the list never reads freed memory
+ */
+struct alignas(cache_line) record {
+    void const* pointer;
+    record* next;
+    uint32_t in_use;
+};
+
+} // namespace hazard
+} // namespace details
+} // namespace memory
+
+class hazard_pointer;
+
+/**
+ * Hazard pointer memory reclamation domain
+ *
+ * A reader publishes the address of an object in a hazard slot before dereferencing it, and a
+ * retired object is only reclaimed once no slot holds its address. Unlike epoch-based
+ * reclamation, a stalled reader only holds back the objects it protects.
+ *
+ * Retired objects are kept on a list shared by all threads of the domain. Once the list grows past
+ * twice the number of hazard slots, the retiring thread takes the whole list, snapshots the slots
+ * and reclaims every object that is not protected.
+ */
+class __UTL_ABI_PUBLIC hazard_domain {
+    using record = memory::details::hazard::record;
+    using retired = memory::details::retired;
+
+public:
+    /**
+     * Smallest number of retired objects that triggers a reclamation
+     */
+    static constexpr size_t collect_threshold = 64;
+
+    hazard_domain() noexcept;
+    hazard_domain(hazard_domain const&) = delete;
+    hazard_domain& operator=(hazard_domain const&) = delete;
+    /**
+     * Reclaims every object retired to the domain, all hazard pointers must have been destroyed
+     */
+    ~hazard_domain() noexcept;
+
+    /**
+     * @return the process-wide domain, which is never destroyed
+     */
+    UTL_ATTRIBUTES(NODISCARD) static hazard_domain& global() noexcept;
+
+    /**
+     * Retires an object that has been unlinked from every shared structure, `deleter(ptr)` is
+     * called once no hazard pointer protects it
+     *
+     * If allocating the retired node throws, the object is not retired.
+     */
+    template <typename T, typename D = memory::retire_delete>
+    __UTL_HIDE_FROM_ABI inline void retire(T* ptr, D&& deleter = D()) UTL_THROWS {
+        push(memory::details::retired_object<T, decay_t<D>>::make(ptr, __UTL forward<D>(deleter)));
+    }
+
+    /**
+     * Reclaims every retired object that is not protected
+     */
+    void collect() noexcept;
+
+private:
+    friend hazard_pointer make_hazard_pointer(hazard_domain&) UTL_THROWS;
+
+    record* acquire() UTL_THROWS;
+    void push(retired* node) noexcept;
+    void requeue(retired* head, retired* tail, size_t count) noexcept;
+
+    alignas(memory::details::hazard::cache_line) record* records_;
+    size_t record_count_;
+    alignas(memory::details::hazard::cache_line) retired* retired_;
+    size_t retired_count_;
+};
+
+/**
+ * Owner of one hazard slot, obtained with `make_hazard_pointer`
+ *
+ * Acquiring a slot scans the slots of the domain, so a reader should keep its hazard pointers
+ * across operations rather than making one per access; protecting an object then only writes to
+ * the slot owned by the reader.
+ */
+class __UTL_ABI_PUBLIC hazard_pointer {
+    using record = memory::details::hazard::record;
+
+public:
+    /**
+     * Constructs an empty hazard pointer
+     */
+    __UTL_HIDE_FROM_ABI inline constexpr hazard_pointer() noexcept : record_(nullptr) {}
+
+    __UTL_HIDE_FROM_ABI inline hazard_pointer(hazard_pointer&& other) noexcept
+        : record_(other.record_) {
+        other.record_ = nullptr;
+    }
+
+    __UTL_HIDE_FROM_ABI inline hazard_pointer& operator=(hazard_pointer&& other) noexcept {
+        if (this != &other) {
+            release();
+            record_ = other.record_;
+            other.record_ = nullptr;
+        }
+
+        return *this;
+    }
+
+    __UTL_HIDE_FROM_ABI inline ~hazard_pointer() noexcept { release(); }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool empty() const noexcept {
+        return record_ == nullptr;
+    }
+
+    /**
+     * Protects the object `src` points to at the time of the call
+     *
+     * @return the protected pointer
+     */
+    template <typename T>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline T* protect(T* const& src) noexcept {
+        T* ptr = atomic_relaxed::load(&src);
+        while (!try_protect(ptr, src)) {}
+        return ptr;
+    }
+
+    /**
+     * Protects `ptr` if `src` still points to it after the protection is published
+     *
+     * @return true on success, otherwise the protection is cleared and `ptr` holds the current
+     * value of `src`
+     */
+    template <typename T>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool try_protect(
+        T*& ptr, T* const& src) noexcept {
+        UTL_ASSERT(record_ != nullptr);
+        T* const expected = ptr;
+        atomic_relaxed::store(&record_->pointer, static_cast<void const*>(expected));
+        // Order the publication before the validating load, pairs with `hazard_domain::collect`
+        atomic_seq_cst::thread_fence();
+        ptr = atomic_acquire::load(&src);
+        if (ptr != expected) {
+            reset_protection();
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Protects `ptr`, which the caller must know has not been retired
+     */
+    template <typename T>
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void reset_protection(
+        T const* ptr) noexcept {
+        UTL_ASSERT(record_ != nullptr);
+        atomic_release::store(&record_->pointer, static_cast<void const*>(ptr));
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void reset_protection() noexcept {
+        UTL_ASSERT(record_ != nullptr);
+        atomic_release::store(&record_->pointer, static_cast<void const*>(nullptr));
+    }
+
+    __UTL_HIDE_FROM_ABI inline void swap(hazard_pointer& other) noexcept {
+        record* const tmp = record_;
+        record_ = other.record_;
+        other.record_ = tmp;
+    }
+
+private:
+    friend hazard_pointer make_hazard_pointer(hazard_domain&) UTL_THROWS;
+
+    __UTL_HIDE_FROM_ABI explicit inline constexpr hazard_pointer(record* slot) noexcept
+        : record_(slot) {}
+
+    __UTL_HIDE_FROM_ABI inline void release() noexcept {
+        if (record_ != nullptr) {
+            atomic_relaxed::store(&record_->pointer, static_cast<void const*>(nullptr));
+            atomic_release::store(&record_->in_use, uint32_t(0));
+            record_ = nullptr;
+        }
+    }
+
+    record* record_;
+};
+
+/**
+ * @return a hazard pointer owning a slot of `domain`
+ */
+UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) hazard_pointer make_hazard_pointer(
+    hazard_domain& domain = hazard_domain::global()) UTL_THROWS;
+
+__UTL_HIDE_FROM_ABI inline void swap(hazard_pointer& left, hazard_pointer& right) noexcept {
+    left.swap(right);
+}
+
+UTL_NAMESPACE_END
@@ -10,6 +10,7 @@
 #include "utl/memory/utl_addressof.h"
 #include "utl/memory/utl_reference_counter.h"
 #include "utl/type_traits/declval.h"
+#include "utl/type_traits/utl_is_trivially_relocatable.h"
 #include "utl/utility/utl_exchange.h"
 #include "utl/utility/utl_forward.h"
 
@@ -241,6 +242,12 @@ private:
     T* resource_;
 };
 
+/**
+ * An intrusive_ptr only holds a pointer, so relocating it does not touch the reference count.
+ */
+template <typename T>
+struct __UTL_PUBLIC_TEMPLATE is_trivially_relocatable<intrusive_ptr<T>> : true_type {};
+
 /**
  * Specialization of intrusive_ptr for managing const-qualified objects.
  *
@@ -0,0 +1,174 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/memory/utl_allocator_fwd.h"
+
+#include "utl/exception/utl_program_exception.h"
+#include "utl/memory/utl_allocator_decl.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/string/utl_libc.h"
+#include "utl/type_traits/utl_constants.h"
+#include "utl/type_traits/utl_is_trivially_relocatable.h"
+
+#if UTL_TARGET_MICROSOFT
+#  include <malloc.h>
+#endif
+#include <stdlib.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace memory {
+namespace details {
+/**
+ * Alignment guaranteed by `malloc` and `realloc`
+ */
+UTL_INLINE_CXX17 constexpr size_t c_heap_alignment = alignof(max_align_t);
+
+/**
+ * @return `bytes` bytes from the C heap aligned to `alignment`, or null on failure
+ */
+UTL_ATTRIBUTES(NODISCARD, MALLOC, _HIDE_FROM_ABI) inline void* c_allocate(
+    size_t bytes, size_t alignment) noexcept {
+    bytes = __UTL numeric::max(bytes, size_t(1));
+    if (alignment <= c_heap_alignment) {
+        return ::malloc(bytes);
+    }
+
+#if UTL_TARGET_MICROSOFT
+    return ::_aligned_malloc(bytes, alignment);
+#else
+    void* result = nullptr;
+    return ::posix_memalign(&result, alignment, bytes) == 0 ? result : nullptr;
+#endif
+}
+
+__UTL_HIDE_FROM_ABI inline void c_deallocate(void* ptr, size_t alignment) noexcept {
+#if UTL_TARGET_MICROSOFT
+    if (alignment > c_heap_alignment) {
+        ::_aligned_free(ptr);
+        return;
+    }
+#endif
+    (void)alignment;
+    ::free(ptr);
+}
+
+/**
+ * Resizes a block obtained from `c_allocate`, in place or by remapping its pages where the C
+ * library supports it; glibc and musl serve large blocks with `mmap` and grow them with `mremap`
+ *
+ * @return the resized block or null on failure, in which case `ptr` is left untouched
+ */
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline void* c_reallocate(
+    void* ptr, size_t bytes, size_t new_bytes, size_t alignment) noexcept {
+    new_bytes = __UTL numeric::max(new_bytes, size_t(1));
+    if (alignment <= c_heap_alignment) {
+        return ::realloc(ptr, new_bytes);
+    }
+
+#if UTL_TARGET_MICROSOFT
+    (void)bytes;
+    return ::_aligned_realloc(ptr, new_bytes, alignment);
+#else
+    void* const result = c_allocate(new_bytes, alignment);
+    if (result != nullptr && ptr != nullptr) {
+        __UTL libc::unsafe::memcpy(static_cast<unsigned char*>(result),
+            static_cast<unsigned char const*>(ptr),
+            libc::element_count_t(__UTL numeric::min(bytes, new_bytes)));
+        ::free(ptr);
+    }
+    return result;
+#endif
+}
+} // namespace details
+} // namespace memory
+
+/**
+ * Stateless allocator backed by the C heap
+ *
+ * For trivially relocatable types `reallocate` is implemented with `realloc`, which can grow a
+ * block in place and, for the large blocks that the C library maps directly, remap the pages
+ * instead of copying them. Memory from this allocator must not be passed to any other allocator.
+ */
+template <typename T>
+class __UTL_PUBLIC_TEMPLATE malloc_allocator {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = decltype((char*)(0) - (char*)(0));
+    using propagate_on_container_move_assignment = true_type;
+    using is_always_equal = true_type;
+
+private:
+    using pointer UTL_NODEBUG = value_type*;
+    using result_type UTL_NODEBUG = allocation_result<pointer, size_t>;
+
+public:
+    __UTL_HIDE_FROM_ABI constexpr malloc_allocator() noexcept = default;
+    __UTL_HIDE_FROM_ABI constexpr malloc_allocator(malloc_allocator const&) noexcept = default;
+    __UTL_HIDE_FROM_ABI UTL_CONSTEXPR_CXX14 malloc_allocator& operator=(
+        malloc_allocator const&) noexcept = default;
+
+    template <typename U>
+    __UTL_HIDE_FROM_ABI constexpr malloc_allocator(malloc_allocator<U> const&) noexcept {}
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline pointer allocate(size_type count) UTL_THROWS {
+        check_count(count);
+        return check_result(memory::details::c_allocate(count * sizeof(T), alignof(T)), count);
+    }
+
+    __UTL_HIDE_FROM_ABI inline void deallocate(pointer ptr, size_type) noexcept {
+        memory::details::c_deallocate(ptr, alignof(T));
+    }
+
+    /**
+     * Resizes the allocation with `realloc`, the elements that fit are preserved and `arg` remains
+     * valid if an exception is thrown
+     */
+    template <typename U = T UTL_CONSTRAINT_CXX11(is_trivially_relocatable<U>::value)>
+    UTL_CONSTRAINT_CXX20(is_trivially_relocatable_v<U>)
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline pointer reallocate(
+        result_type arg, size_type count) UTL_THROWS {
+        check_count(count);
+        return check_result(memory::details::c_reallocate(arg.ptr, arg.size * sizeof(T),
+                                count * sizeof(T), alignof(T)),
+            count);
+    }
+
+    template <typename U>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) friend inline constexpr bool operator==(
+        malloc_allocator const&, malloc_allocator<U> const&) noexcept {
+        return true;
+    }
+
+#if !UTL_CXX20
+    template <typename U>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) friend inline constexpr bool operator!=(
+        malloc_allocator const&, malloc_allocator<U> const&) noexcept {
+        return false;
+    }
+#endif
+
+private:
+    __UTL_HIDE_FROM_ABI static inline void check_count(size_type count) UTL_THROWS {
+        UTL_THROW_IF(count > memory::max_size<T>::value,
+            bad_array_new_length(
+                UTL_MESSAGE_FORMAT("[UTL] allocation operation failed, Reason=[element count "
+                                   "limit exceeded], count=[%zu], limit=[%zu]"),
+                count, memory::max_size<T>::value));
+    }
+
+    __UTL_HIDE_FROM_ABI static inline pointer check_result(void* ptr, size_type count) UTL_THROWS {
+        UTL_THROW_IF(ptr == nullptr,
+            bad_alloc(UTL_MESSAGE_FORMAT("[UTL] allocation operation failed, "
+                                         "Reason=[out of memory], count=[%zu]"),
+                count));
+        return static_cast<pointer>(ptr);
+    }
+};
+
+UTL_NAMESPACE_END
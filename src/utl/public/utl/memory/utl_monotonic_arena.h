@@ -0,0 +1,241 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/memory/utl_allocator_fwd.h"
+
+#include "utl/assert/utl_assert.h"
+#include "utl/memory/utl_allocator_decl.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/utility/utl_exchange.h"
+
+#include <stdint.h>
+
+#define __UTL_ATTRIBUTE_ARENA_PURE (PURE)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_ARENA_PURE
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Monotonic bump allocator for allocations that die together
+ *
+ * Memory is carved out of blocks obtained from the global allocation functions, block sizes
+ * double until `max_block_bytes`. Deallocation is a no-op except for the most recent allocation,
+ * which is rolled back, and the most recent allocation may also be resized in place with
+ * `extend`. `reset` discards every allocation in constant time while keeping the blocks for reuse,
+ * `release` returns the blocks upstream.
+ *
+ * An optional initial buffer supplied by the caller is used before any block is allocated and is
+ * never freed by the arena. The arena is neither copyable nor movable since allocators refer to it
+ * by address.
+ */
+class __UTL_ABI_PUBLIC monotonic_arena {
+    /**
+     * Header at the start of every upstream block, the blocks form a singly linked list in the
+     * order they are used
+     */
+    struct block {
+        block* next;
+        size_t bytes;
+    };
+
+    static constexpr size_t block_alignment = memory::details::default_new_alignment;
+    static constexpr size_t header_bytes =
+        (sizeof(block) + block_alignment - 1) & ~(block_alignment - 1);
+
+public:
+    static constexpr size_t default_block_bytes = 4096;
+    static constexpr size_t max_block_bytes = 1024 * 1024;
+
+    __UTL_HIDE_FROM_ABI inline monotonic_arena() noexcept
+        : monotonic_arena(default_block_bytes) {}
+
+    /**
+     * @param block_bytes - size of the first upstream block, including its header
+     */
+    __UTL_HIDE_FROM_ABI explicit inline monotonic_arena(size_t block_bytes) noexcept
+        : cursor_(nullptr)
+        , end_(nullptr)
+        , current_(nullptr)
+        , head_(nullptr)
+        , buffer_(nullptr)
+        , buffer_bytes_(0)
+        , next_block_bytes_(__UTL numeric::max(block_bytes, header_bytes * 2))
+        , reserved_bytes_(0) {}
+
+    /**
+     * @param buffer - caller owned memory used before any upstream block
+     * @param bytes - size of `buffer`
+     */
+    __UTL_HIDE_FROM_ABI inline monotonic_arena(void* buffer, size_t bytes) noexcept
+        : cursor_(static_cast<unsigned char*>(buffer))
+        , end_(static_cast<unsigned char*>(buffer) + bytes)
+        , current_(nullptr)
+        , head_(nullptr)
+        , buffer_(static_cast<unsigned char*>(buffer))
+        , buffer_bytes_(bytes)
+        , next_block_bytes_(__UTL numeric::max(size_t(default_block_bytes), bytes * 2))
+        , reserved_bytes_(0) {}
+
+    monotonic_arena(monotonic_arena const&) = delete;
+    monotonic_arena& operator=(monotonic_arena const&) = delete;
+    monotonic_arena(monotonic_arena&&) = delete;
+    monotonic_arena& operator=(monotonic_arena&&) = delete;
+
+    __UTL_HIDE_FROM_ABI inline ~monotonic_arena() noexcept { release(); }
+
+    /**
+     * @param alignment - power of two alignment of the returned pointer
+     *
+     * @return pointer to `bytes` bytes of uninitialized memory
+     */
+    UTL_ATTRIBUTES(NODISCARD, MALLOC, _HIDE_FROM_ABI) inline void* allocate(
+        size_t bytes, size_t alignment = block_alignment) UTL_THROWS {
+        UTL_ASSERT((alignment & (alignment - 1)) == 0);
+        unsigned char* result = align_up(cursor_, alignment);
+        if (result == nullptr || result > end_ || static_cast<size_t>(end_ - result) < bytes) {
+            result = refill(bytes, alignment);
+        }
+
+        cursor_ = result + bytes;
+        return result;
+    }
+
+    /**
+     * Resizes the allocation at `ptr` from `bytes` to `new_bytes` without moving it, which is
+     * only possible for the most recent allocation
+     *
+     * @return true if the allocation was resized
+     */
+    __UTL_HIDE_FROM_ABI inline bool extend(void* ptr, size_t bytes, size_t new_bytes) noexcept {
+        auto const first = static_cast<unsigned char*>(ptr);
+        if (first == nullptr || first + bytes != cursor_ ||
+            static_cast<size_t>(end_ - first) < new_bytes) {
+            return false;
+        }
+
+        cursor_ = first + new_bytes;
+        return true;
+    }
+
+    /**
+     * Rolls back the allocation at `ptr` if it is the most recent one, otherwise does nothing
+     */
+    __UTL_HIDE_FROM_ABI inline void deallocate(void* ptr, size_t bytes) noexcept {
+        auto const first = static_cast<unsigned char*>(ptr);
+        if (first != nullptr && first + bytes == cursor_) {
+            cursor_ = first;
+        }
+    }
+
+    /**
+     * Discards every allocation in constant time, the upstream blocks are kept and reused in the
+     * same order
+     */
+    __UTL_HIDE_FROM_ABI inline void reset() noexcept {
+        if (buffer_ != nullptr) {
+            current_ = nullptr;
+            cursor_ = buffer_;
+            end_ = buffer_ + buffer_bytes_;
+        } else if (head_ != nullptr) {
+            use(head_);
+        }
+    }
+
+    /**
+     * Discards every allocation and returns the upstream blocks
+     */
+    __UTL_HIDE_FROM_ABI inline void release() noexcept {
+        block* head = __UTL exchange(head_, nullptr);
+        while (head != nullptr) {
+            block* const next = head->next;
+            memory::details::deallocate(head, head->bytes);
+            head = next;
+        }
+
+        current_ = nullptr;
+        cursor_ = buffer_;
+        end_ = buffer_ != nullptr ? buffer_ + buffer_bytes_ : nullptr;
+        reserved_bytes_ = 0;
+    }
+
+    /**
+     * @return total size of the upstream blocks
+     */
+    UTL_ATTRIBUTE(ARENA_PURE) inline size_t reserved_bytes() const noexcept {
+        return reserved_bytes_;
+    }
+
+    /**
+     * @return number of bytes that can be allocated without alignment padding before the arena
+     * moves on to another block
+     */
+    UTL_ATTRIBUTE(ARENA_PURE) inline size_t remaining_bytes() const noexcept {
+        return static_cast<size_t>(end_ - cursor_);
+    }
+
+private:
+    UTL_ATTRIBUTE(ARENA_PURE) static inline unsigned char* align_up(
+        unsigned char* ptr, size_t alignment) noexcept {
+        auto const address = reinterpret_cast<uintptr_t>(ptr);
+        return ptr + (((address + alignment - 1) & ~uintptr_t(alignment - 1)) - address);
+    }
+
+    UTL_ATTRIBUTE(ARENA_PURE) static inline unsigned char* data(block* ptr) noexcept {
+        return reinterpret_cast<unsigned char*>(ptr) + header_bytes;
+    }
+
+    __UTL_HIDE_FROM_ABI inline void use(block* ptr) noexcept {
+        current_ = ptr;
+        cursor_ = data(ptr);
+        end_ = reinterpret_cast<unsigned char*>(ptr) + ptr->bytes;
+    }
+
+    /**
+     * Moves to the next retained block that can hold the request, or links a new block after the
+     * current one
+     *
+     * @return aligned pointer to `bytes` bytes in the new current block
+     */
+    __UTL_HIDE_FROM_ABI inline unsigned char* refill(size_t bytes, size_t alignment) UTL_THROWS {
+        size_t const padding = alignment > block_alignment ? alignment - block_alignment : 0;
+        size_t const required = header_bytes + padding + bytes;
+        block* next = current_ != nullptr ? current_->next : head_;
+        if (next == nullptr || next->bytes < required) {
+            size_t const size = __UTL numeric::max(required, next_block_bytes_);
+            auto const fresh = ::new (memory::details::allocate(size)) block{next, size};
+            if (current_ != nullptr) {
+                current_->next = fresh;
+            } else {
+                head_ = fresh;
+            }
+
+            reserved_bytes_ += size;
+            next_block_bytes_ = __UTL numeric::min(next_block_bytes_ * 2, size_t(max_block_bytes));
+            next = fresh;
+        }
+
+        use(next);
+        return align_up(cursor_, alignment);
+    }
+
+    unsigned char* cursor_;
+    unsigned char* end_;
+    /**
+     * Block containing the cursor, null while allocating from the initial buffer
+     */
+    block* current_;
+    block* head_;
+    unsigned char* buffer_;
+    size_t buffer_bytes_;
+    size_t next_block_bytes_;
+    size_t reserved_bytes_;
+};
+
+UTL_NAMESPACE_END
+
+#undef __UTL_ATTRIBUTE_ARENA_PURE
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_ARENA_PURE
@@ -0,0 +1,180 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/memory/utl_allocator_fwd.h"
+
+#include "utl/exception/utl_program_exception.h"
+#include "utl/memory/utl_allocator_decl.h"
+#include "utl/type_traits/utl_constants.h"
+
+#define __UTL_ATTRIBUTE_PAGES_PURE (PURE)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_PAGES_PURE
+
+UTL_NAMESPACE_BEGIN
+
+namespace memory {
+/**
+ * Memory mapped directly from the operating system in whole pages
+ */
+namespace pages {
+
+enum class huge_pages : unsigned char {
+    /**
+     * Base pages only
+     */
+    none,
+    /**
+     * Huge page aligned mappings advised for transparent huge pages where supported
+     */
+    transparent,
+    /**
+     * Huge pages from the pool reserved by the administrator (`MAP_HUGETLB`, `MEM_LARGE_PAGES`),
+     * falls back to `transparent` when none are available
+     */
+    reserved
+};
+
+/**
+ * Placement of a mapping, hints the system cannot honour are ignored
+ */
+struct options {
+    huge_pages huge;
+    /**
+     * NUMA node the pages are preferably taken from, or negative for the default policy of the
+     * calling thread
+     */
+    int node;
+};
+
+/**
+ * @return size of a base page
+ */
+UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) size_t size() noexcept;
+/**
+ * @return size of a huge page, or of a base page if the system has no huge pages
+ */
+UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) size_t huge_size() noexcept;
+
+/**
+ * @return the size mappings made with `huge` are rounded to
+ */
+UTL_ATTRIBUTE(PAGES_PURE) inline size_t granularity(huge_pages huge) noexcept {
+    return huge == huge_pages::none ? size() : huge_size();
+}
+
+/**
+ * @param bytes - size of the mapping, a multiple of `granularity(opts.huge)`
+ *
+ * @return zero-filled mapping of `bytes` bytes aligned to `granularity(opts.huge)`
+ */
+UTL_ATTRIBUTES(MALLOC, NODISCARD, _ABI_PUBLIC) void* allocate(
+    size_t bytes, options opts) UTL_THROWS;
+/**
+ * Unmaps a mapping obtained from `allocate` with the same size
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) void deallocate(void* ptr, size_t bytes) noexcept;
+
+} // namespace pages
+} // namespace memory
+
+/**
+ * Allocator that maps every allocation directly from the operating system
+ *
+ * Intended for large, long-lived buffers: allocations are rounded up to whole pages, which
+ * `allocate_at_least` hands back to the caller, may be backed by huge pages to reduce TLB pressure
+ * and may be bound to a NUMA node instead of the node that first touches them.
+ *
+ * Page allocators compare equal if they round allocations to the same granularity, the NUMA node
+ * only affects new allocations.
+ */
+template <typename T>
+class __UTL_PUBLIC_TEMPLATE page_allocator {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = decltype((char*)(0) - (char*)(0));
+    using propagate_on_container_copy_assignment = true_type;
+    using propagate_on_container_move_assignment = true_type;
+    using propagate_on_container_swap = true_type;
+    using is_always_equal = false_type;
+
+private:
+    using pointer UTL_NODEBUG = value_type*;
+    using result_type UTL_NODEBUG = allocation_result<pointer, size_t>;
+
+public:
+    __UTL_HIDE_FROM_ABI constexpr page_allocator() noexcept
+        : options_{memory::pages::huge_pages::none, -1} {}
+    __UTL_HIDE_FROM_ABI explicit constexpr page_allocator(memory::pages::options opts) noexcept
+        : options_(opts) {}
+    __UTL_HIDE_FROM_ABI constexpr page_allocator(page_allocator const&) noexcept = default;
+    __UTL_HIDE_FROM_ABI UTL_CONSTEXPR_CXX14 page_allocator& operator=(
+        page_allocator const&) noexcept = default;
+
+    template <typename U>
+    __UTL_HIDE_FROM_ABI constexpr page_allocator(page_allocator<U> const& other) noexcept
+        : options_(other.options()) {}
+
+    UTL_ATTRIBUTE(PAGES_PURE) inline constexpr memory::pages::options options() const noexcept {
+        return options_;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline pointer allocate(size_type count) UTL_THROWS {
+        check_count(count);
+        return static_cast<pointer>(memory::pages::allocate(round(count * sizeof(T)), options_));
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline result_type allocate_at_least(
+        size_type count) UTL_THROWS {
+        check_count(count);
+        size_t const bytes = round(count * sizeof(T));
+        return {static_cast<pointer>(memory::pages::allocate(bytes, options_)), bytes / sizeof(T)};
+    }
+
+    __UTL_HIDE_FROM_ABI inline void deallocate(pointer ptr, size_type count) noexcept {
+        memory::pages::deallocate(ptr, round(count * sizeof(T)));
+    }
+
+    template <typename U>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) friend inline constexpr bool operator==(
+        page_allocator const& left, page_allocator<U> const& right) noexcept {
+        return (left.options_.huge == memory::pages::huge_pages::none) ==
+            (right.options().huge == memory::pages::huge_pages::none);
+    }
+
+#if !UTL_CXX20
+    template <typename U>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) friend inline constexpr bool operator!=(
+        page_allocator const& left, page_allocator<U> const& right) noexcept {
+        return !(left == right);
+    }
+#endif
+
+private:
+    __UTL_HIDE_FROM_ABI static inline void check_count(size_type count) UTL_THROWS {
+        UTL_THROW_IF(count > memory::max_size<T>::value,
+            bad_array_new_length(
+                UTL_MESSAGE_FORMAT("[UTL] allocation operation failed, Reason=[element count "
+                                   "limit exceeded], count=[%zu], limit=[%zu]"),
+                count, memory::max_size<T>::value));
+    }
+
+    /**
+     * Deallocation must round the same way as allocation, so the huge page granularity is used
+     * whenever huge pages were requested even if the mapping fell back to base pages
+     */
+    UTL_ATTRIBUTE(PAGES_PURE) inline size_t round(size_t bytes) const noexcept {
+        size_t const unit = memory::pages::granularity(options_.huge);
+        return bytes == 0 ? unit : (bytes + unit - 1) & ~(unit - 1);
+    }
+
+    memory::pages::options options_;
+};
+
+UTL_NAMESPACE_END
+
+#undef __UTL_ATTRIBUTE_PAGES_PURE
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_PAGES_PURE
@@ -0,0 +1,183 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/memory/utl_allocator_fwd.h"
+
+#include "utl/bit/utl_bit_width.h"
+#include "utl/exception/utl_program_exception.h"
+#include "utl/memory/utl_allocator_decl.h"
+#include "utl/type_traits/utl_constants.h"
+
+#define __UTL_ATTRIBUTE_POOL_CONST (CONST)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_POOL_CONST
+
+UTL_NAMESPACE_BEGIN
+
+namespace memory {
+/**
+ * Size-class pool backing `pool_allocator`
+ *
+ * Blocks of up to `max_bytes` bytes are served from per-thread caches, one free list per size
+ * class. A cache that runs dry takes a batch of blocks from the central free list of the class,
+ * and a cache holding too many blocks returns a batch to it, so threads only synchronise once per
+ * batch. Memory obtained for the pool is retained for reuse and never returned to the system.
+ */
+namespace pool {
+
+/**
+ * Largest block size served by the pool, larger requests go to the global allocation functions
+ */
+UTL_INLINE_CXX17 constexpr size_t max_bytes = 32 * 1024;
+/**
+ * Alignment of every block
+ */
+UTL_INLINE_CXX17 constexpr size_t alignment = 16;
+/**
+ * Classes are multiples of 16 bytes up to 128 bytes, then four evenly spaced classes per doubling
+ */
+UTL_INLINE_CXX17 constexpr size_t class_count = 8 + 4 * 8;
+
+/**
+ * @return index of the smallest class holding `bytes`, `bytes` must not exceed `max_bytes`
+ */
+UTL_ATTRIBUTE(POOL_CONST) inline UTL_CONSTEXPR_CXX14 size_t class_of(size_t bytes) noexcept {
+    if (bytes <= 128) {
+        return bytes <= 16 ? 0 : (bytes - 1) >> 4;
+    }
+
+    // Doubling `d` covers (128 << d, 256 << d] in steps of 32 << d
+    size_t const doubling = static_cast<size_t>(__UTL bit_width(bytes - 1)) - 8;
+    size_t const step = (bytes - 1 - (size_t(128) << doubling)) >> (doubling + 5);
+    return 8 + doubling * 4 + step;
+}
+
+/**
+ * @return block size of class `idx`
+ */
+UTL_ATTRIBUTE(POOL_CONST) inline UTL_CONSTEXPR_CXX14 size_t class_size(size_t idx) noexcept {
+    if (idx < 8) {
+        return (idx + 1) * 16;
+    }
+
+    size_t const doubling = (idx - 8) / 4;
+    return (size_t(128) << doubling) + ((idx - 8) % 4 + 1) * (size_t(32) << doubling);
+}
+
+/**
+ * @return a block of class `idx` from the cache of the calling thread
+ */
+UTL_ATTRIBUTES(MALLOC, NODISCARD, _ABI_PUBLIC) void* allocate(size_t idx) UTL_THROWS;
+/**
+ * Returns a block of class `idx` to the cache of the calling thread, which need not be the thread
+ * that allocated it
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) void deallocate(void* ptr, size_t idx) noexcept;
+
+} // namespace pool
+} // namespace memory
+
+/**
+ * Stateless allocator backed by the `memory::pool` size-class pool
+ *
+ * `allocate_at_least` returns the full capacity of the size class. Requests larger than
+ * `memory::pool::max_bytes` or types aligned more strictly than `memory::pool::alignment` are
+ * forwarded to the global allocation functions. Memory may be deallocated by any thread.
+ */
+template <typename T>
+class __UTL_PUBLIC_TEMPLATE pool_allocator {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = decltype((char*)(0) - (char*)(0));
+    using propagate_on_container_move_assignment = true_type;
+    using is_always_equal = true_type;
+
+private:
+    using pointer UTL_NODEBUG = value_type*;
+    using result_type UTL_NODEBUG = allocation_result<pointer, size_t>;
+
+    static constexpr bool pooled = alignof(T) <= memory::pool::alignment;
+
+public:
+    __UTL_HIDE_FROM_ABI constexpr pool_allocator() noexcept = default;
+    __UTL_HIDE_FROM_ABI constexpr pool_allocator(pool_allocator const&) noexcept = default;
+    __UTL_HIDE_FROM_ABI UTL_CONSTEXPR_CXX14 pool_allocator& operator=(
+        pool_allocator const&) noexcept = default;
+
+    template <typename U>
+    __UTL_HIDE_FROM_ABI constexpr pool_allocator(pool_allocator<U> const&) noexcept {}
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline pointer allocate(size_type count) UTL_THROWS {
+        check_count(count);
+        size_t const bytes = count * sizeof(T);
+        if (!pooled || bytes > memory::pool::max_bytes) {
+            return static_cast<pointer>(memory::details::allocate(bytes, alignof(T)));
+        }
+
+        return static_cast<pointer>(memory::pool::allocate(memory::pool::class_of(bytes)));
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline result_type allocate_at_least(
+        size_type count) UTL_THROWS {
+        check_count(count);
+        size_t const bytes = count * sizeof(T);
+        if (!pooled || bytes > memory::pool::max_bytes) {
+            return {static_cast<pointer>(memory::details::allocate(bytes, alignof(T))), count};
+        }
+
+        size_t const idx = memory::pool::class_of(bytes);
+        return {static_cast<pointer>(memory::pool::allocate(idx)),
+            memory::pool::class_size(idx) / sizeof(T)};
+    }
+
+    __UTL_HIDE_FROM_ABI inline void deallocate(pointer ptr, size_type count) noexcept {
+        size_t const bytes = count * sizeof(T);
+        if (!pooled || bytes > memory::pool::max_bytes) {
+            memory::details::deallocate(ptr, bytes, alignof(T));
+        } else {
+            memory::pool::deallocate(ptr, memory::pool::class_of(bytes));
+        }
+    }
+
+    template <typename U>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) friend inline constexpr bool operator==(
+        pool_allocator const&, pool_allocator<U> const&) noexcept {
+        return true;
+    }
+
+#if !UTL_CXX20
+    template <typename U>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) friend inline constexpr bool operator!=(
+        pool_allocator const&, pool_allocator<U> const&) noexcept {
+        return false;
+    }
+#endif
+
+private:
+    __UTL_HIDE_FROM_ABI static inline void check_count(size_type count) UTL_THROWS {
+        UTL_THROW_IF(count > memory::max_size<T>::value,
+            bad_array_new_length(
+                UTL_MESSAGE_FORMAT("[UTL] allocation operation failed, Reason=[element count "
+                                   "limit exceeded], count=[%zu], limit=[%zu]"),
+                count, memory::max_size<T>::value));
+    }
+};
+
+UTL_NAMESPACE_END
+
+#if !UTL_CXX17
+
+UTL_NAMESPACE_BEGIN
+
+template <typename T>
+__UTL_ABI_PUBLIC constexpr bool pool_allocator<T>::pooled;
+
+UTL_NAMESPACE_END
+
+#endif
+
+#undef __UTL_ATTRIBUTE_POOL_CONST
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_POOL_CONST
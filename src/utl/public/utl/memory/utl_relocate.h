@@ -0,0 +1,161 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/exception/utl_exception_base.h"
+#include "utl/memory/utl_addressof.h"
+#include "utl/memory/utl_destroy_at.h"
+#include "utl/string/utl_libc.h"
+#include "utl/type_traits/utl_constants.h"
+#include "utl/type_traits/utl_is_nothrow_move_constructible.h"
+#include "utl/type_traits/utl_is_trivially_relocatable.h"
+#include "utl/type_traits/utl_remove_reference.h"
+#include "utl/utility/utl_move.h"
+#include "utl/utility/utl_pair.h"
+
+#include <new>
+
+UTL_NAMESPACE_BEGIN
+
+namespace details {
+namespace relocation {
+/**
+ * Ranges between pointers to the same trivially relocatable type are relocated with a single
+ * `memmove`
+ */
+template <typename InputIt, typename ForwardIt>
+struct is_bulk : false_type {};
+template <typename T>
+struct is_bulk<T*, T*> : is_trivially_relocatable<T> {};
+
+template <typename T>
+__UTL_HIDE_FROM_ABI inline T* move_bytes(T* first, size_t count, T* d_first) noexcept {
+    if (count != 0) {
+        __UTL libc::unsafe::memmove(reinterpret_cast<unsigned char*>(d_first),
+            reinterpret_cast<unsigned char const*>(first),
+            libc::element_count_t(count * sizeof(T)));
+    }
+#ifdef UTL_BUILTIN_launder
+    return UTL_BUILTIN_launder(d_first);
+#else
+    return d_first;
+#endif
+}
+
+template <typename T>
+__UTL_HIDE_FROM_ABI inline T* relocate_at(T* source, T* dest, true_type) noexcept {
+    return move_bytes(source, 1, dest);
+}
+
+template <typename T>
+__UTL_HIDE_FROM_ABI inline T* relocate_at(T* source, T* dest, false_type) noexcept(
+    UTL_TRAIT_is_nothrow_move_constructible(T)) {
+    T* const result = ::new (static_cast<void*>(dest)) T(__UTL move(*source));
+    __UTL destroy_at(source);
+    return result;
+}
+
+template <typename T>
+__UTL_HIDE_FROM_ABI inline pair<T*, T*> relocate_n(
+    T* first, size_t count, T* d_first, true_type) noexcept {
+    move_bytes(first, count, d_first);
+    return {first + count, d_first + count};
+}
+
+/**
+ * Relocates element by element. If a move constructor throws, the remaining source elements and
+ * the elements already relocated are destroyed before the exception propagates.
+ */
+template <typename InputIt, typename Size, typename ForwardIt>
+__UTL_HIDE_FROM_ABI inline pair<InputIt, ForwardIt> relocate_n(
+    InputIt first, Size count, ForwardIt d_first, false_type) {
+    using value_type = remove_reference_t<decltype(*d_first)>;
+    ForwardIt current = d_first;
+    UTL_TRY {
+        for (; count > 0; ++first, ++current, --count) {
+            ::new (static_cast<void*>(__UTL addressof(*current))) value_type(__UTL move(*first));
+            __UTL destroy_at(__UTL addressof(*first));
+        }
+    } UTL_CATCH(...) {
+        for (; count > 0; ++first, --count) {
+            __UTL destroy_at(__UTL addressof(*first));
+        }
+        for (; d_first != current; ++d_first) {
+            __UTL destroy_at(__UTL addressof(*d_first));
+        }
+        UTL_RETHROW();
+    }
+    return {first, current};
+}
+
+template <typename T>
+__UTL_HIDE_FROM_ABI inline T* relocate(T* first, T* last, T* d_first, true_type) noexcept {
+    size_t const count = static_cast<size_t>(last - first);
+    return move_bytes(first, count, d_first) + count;
+}
+
+template <typename InputIt, typename ForwardIt>
+__UTL_HIDE_FROM_ABI inline ForwardIt relocate(
+    InputIt first, InputIt last, ForwardIt d_first, false_type) {
+    using value_type = remove_reference_t<decltype(*d_first)>;
+    ForwardIt current = d_first;
+    UTL_TRY {
+        for (; first != last; ++first, ++current) {
+            ::new (static_cast<void*>(__UTL addressof(*current))) value_type(__UTL move(*first));
+            __UTL destroy_at(__UTL addressof(*first));
+        }
+    } UTL_CATCH(...) {
+        for (; first != last; ++first) {
+            __UTL destroy_at(__UTL addressof(*first));
+        }
+        for (; d_first != current; ++d_first) {
+            __UTL destroy_at(__UTL addressof(*d_first));
+        }
+        UTL_RETHROW();
+    }
+    return current;
+}
+} // namespace relocation
+} // namespace details
+
+/**
+ * Moves the object at `source` into the uninitialized storage at `dest` and ends the lifetime of
+ * the source, trivially relocatable objects are copied bytewise
+ *
+ * @return pointer to the relocated object
+ */
+template <typename T>
+__UTL_HIDE_FROM_ABI inline T* relocate_at(T* source, T* dest) noexcept(
+    UTL_TRAIT_is_trivially_relocatable(T) || UTL_TRAIT_is_nothrow_move_constructible(T)) {
+    return details::relocation::relocate_at(
+        source, dest, bool_constant<UTL_TRAIT_is_trivially_relocatable(T)>{});
+}
+
+/**
+ * Relocates the elements of `[first, last)` into the uninitialized storage at `d_first`, the
+ * ranges may only overlap if they are pointers to the same trivially relocatable type
+ *
+ * @return iterator past the last relocated element
+ */
+template <typename InputIt, typename ForwardIt>
+__UTL_HIDE_FROM_ABI inline ForwardIt uninitialized_relocate(
+    InputIt first, InputIt last, ForwardIt d_first) {
+    return details::relocation::relocate(
+        first, last, d_first, details::relocation::is_bulk<InputIt, ForwardIt>{});
+}
+
+/**
+ * Relocates `count` elements starting at `first` into the uninitialized storage at `d_first`
+ *
+ * @return iterators past the last element of the source and destination ranges
+ */
+template <typename InputIt, typename Size, typename ForwardIt>
+__UTL_HIDE_FROM_ABI inline pair<InputIt, ForwardIt> uninitialized_relocate_n(
+    InputIt first, Size count, ForwardIt d_first) {
+    return details::relocation::relocate_n(
+        first, count, d_first, details::relocation::is_bulk<InputIt, ForwardIt>{});
+}
+
+UTL_NAMESPACE_END
@@ -0,0 +1,105 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/exception.h"
+#include "utl/memory/utl_is_reference_countable.h"
+#include "utl/memory/utl_pool_allocator.h"
+#include "utl/memory/utl_reference_counting_destroy.h"
+#include "utl/type_traits/utl_constants.h"
+#include "utl/utility/utl_forward.h"
+#include "utl/utility/utl_move.h"
+
+#include <new>
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace memory {
+
+/**
+ * Default deleter of retired objects
+ *
+ * Reference countable objects are released through `reference_counting::destroy`, so that a custom
+ * `destroy` overload is honoured, any other object is deleted.
+ */
+struct __UTL_ABI_PUBLIC retire_delete {
+    template <typename T>
+    __UTL_HIDE_FROM_ABI inline void operator()(T* ptr) const noexcept {
+        release(ptr, is_reference_countable<T>{});
+    }
+
+private:
+    template <typename T>
+    __UTL_HIDE_FROM_ABI static inline void release(T* ptr, true_type) noexcept {
+        reference_counting::destroy(ptr);
+    }
+
+    template <typename T>
+    __UTL_HIDE_FROM_ABI static inline void release(T* ptr, false_type) noexcept {
+        delete ptr;
+    }
+};
+
+namespace details {
+
+/**
+ * Type-erased node of a list of objects waiting to be reclaimed
+ */
+struct retired {
+    retired* next;
+    /**
+     * Epoch at which the object was retired, unused by hazard pointer domains
+     */
+    uint64_t epoch;
+    void* object;
+    void (*reclaim)(retired*) noexcept;
+};
+
+/**
+ * Retired node carrying the deleter of the object, allocated from the size-class pool
+ */
+template <typename T, typename D>
+class retired_object : private retired {
+    using allocator_type = pool_allocator<retired_object>;
+
+public:
+    template <typename Dx>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) static inline retired* make(
+        T* ptr, Dx&& deleter) UTL_THROWS {
+        allocator_type alloc;
+        retired_object* const result = alloc.allocate(1);
+        UTL_TRY {
+            ::new (static_cast<void*>(result)) retired_object(ptr, __UTL forward<Dx>(deleter));
+        } UTL_CATCH(...) {
+            alloc.deallocate(result, 1);
+            UTL_RETHROW();
+        }
+
+        return result;
+    }
+
+private:
+    template <typename Dx>
+    __UTL_HIDE_FROM_ABI inline retired_object(T* ptr, Dx&& deleter)
+        : retired{nullptr, 0, ptr, &invoke}
+        , deleter_(__UTL forward<Dx>(deleter)) {}
+
+    __UTL_HIDE_FROM_ABI static void invoke(retired* base) noexcept {
+        retired_object* const self = static_cast<retired_object*>(base);
+        T* const ptr = static_cast<T*>(self->object);
+        D deleter = __UTL move(self->deleter_);
+        self->~retired_object();
+        allocator_type().deallocate(self, 1);
+        deleter(ptr);
+    }
+
+    D deleter_;
+};
+
+} // namespace details
+} // namespace memory
+
+UTL_NAMESPACE_END
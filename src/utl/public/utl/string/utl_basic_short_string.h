@@ -28,9 +28,11 @@
 #include "utl/numeric/utl_limits.h"
 #include "utl/numeric/utl_max.h"
 #include "utl/numeric/utl_min.h"
+#include "utl/string/utl_basic_string_searcher.h"
 #include "utl/string/utl_basic_string_view.h"
 #include "utl/string/utl_basic_zstring_view.h"
 #include "utl/string/utl_string_details.h"
+#include "utl/string/utl_string_growth.h"
 #include "utl/type_traits/utl_is_convertible.h"
 #include "utl/type_traits/utl_is_nothrow_convertible.h"
 #include "utl/type_traits/utl_type_identity.h"
@@ -62,7 +64,7 @@
 
 UTL_NAMESPACE_BEGIN
 
-template <typename CharType, size_t ShortSize, typename Traits, typename Alloc>
+template <typename CharType, size_t ShortSize, typename Traits, typename Alloc, typename Growth>
 class __UTL_PUBLIC_TEMPLATE basic_short_string {
     static_assert(ShortSize >= details::string::default_inline_size<CharType, Alloc>::value,
         "Inline size must be longer than the default value");
@@ -78,6 +80,7 @@ public:
     using reference = CharType&;
     using const_reference = CharType const&;
     using view_type = basic_string_view<value_type, traits_type>;
+    using growth_policy = Growth;
     __UTL_PUBLIC_TEMPLATE_DATA static constexpr size_type npos = -1;
 
     class iterator;
@@ -391,7 +394,7 @@ public:
 
     __UTL_HIDE_FROM_ABI __UTL_STRING_INLINE UTL_CONSTEXPR_CXX14 void shrink_to_fit() UTL_THROWS {
         if (is_heap_ && size() < capacity()) {
-            get_heap() = alloc_traits::reallocate(allocator_ref(), get_heap(), size() + 1);
+            get_heap() = alloc_traits::reallocate_at_least(allocator_ref(), get_heap(), size() + 1);
         }
     }
 
@@ -468,7 +471,7 @@ public:
 
     __UTL_HIDE_FROM_ABI __UTL_STRING_INLINE UTL_CONSTEXPR_CXX14 void push_back(value_type ch)
         UTL_THROWS {
-        reserve(size() + 1);
+        grow(size() + 1);
         data()[size_++] = ch;
         data()[size_] = value_type();
     }
@@ -599,7 +602,7 @@ public:
             out_of_range(UTL_MESSAGE_FORMAT("[UTL] `basic_short_string::insert` operation failed, "
                                             "Reason=[index out of range], pos=[%zu], size=[%zu]"),
                 pos, size()));
-        reserve(size() + count);
+        grow(size() + count);
         auto const src = data() + pos;
         auto const dst = src + count;
         traits_type::move(dst, src, size() + 1 - pos);
@@ -614,7 +617,7 @@ public:
             out_of_range(UTL_MESSAGE_FORMAT("[UTL] `basic_short_string::insert` operation failed, "
                                             "Reason=[index out of range], pos=[%zu], size=[%zu]"),
                 pos, size()));
-        reserve(size() + length);
+        grow(size() + length);
         auto const src = data() + pos;
         auto const dst = src + length;
         traits_type::move(dst, src, size() + 1 - pos);
@@ -679,7 +682,7 @@ public:
         }
 
         auto const idx = pos - cbegin();
-        reserve(size() + length);
+        grow(size() + length);
         auto const src = data() + idx;
         auto const dst = src + length;
         traits_type::move(dst, src, size() + 1 - idx);
@@ -1055,6 +1058,12 @@ public:
         return find(view_type(view), pos);
     }
 
+    UTL_ATTRIBUTE(STRING_PURE) inline UTL_CONSTEXPR_CXX14 size_type find(
+        basic_string_searcher<value_type, traits_type> const& searcher,
+        size_type pos = 0) const noexcept {
+        return searcher.find(view_type(data(), size()), pos);
+    }
+
     UTL_ATTRIBUTE(STRING_PURE) inline constexpr size_type rfind(
         basic_short_string const& str, size_type pos = npos) const noexcept {
         return rfind(str.data(), pos, str.size());
@@ -1391,6 +1400,27 @@ private:
             alloc_traits::reallocate_at_least(allocator_ref(), get_heap(), new_capacity + 1);
     }
 
+    /**
+     * Ensures the buffer can hold `new_size` characters ahead of an insertion, the new capacity
+     * is chosen by the growth policy so that repeated insertions reallocate a logarithmic number
+     * of times
+     */
+    __UTL_HIDE_FROM_ABI __UTL_STRING_INLINE UTL_CONSTEXPR_CXX14 void grow(size_type new_size)
+        UTL_THROWS {
+        if (new_size <= this->capacity()) {
+            return;
+        }
+
+        UTL_THROW_IF(new_size > max_size(),
+            length_error(UTL_MESSAGE_FORMAT("[UTL] basic_short_string::grow operation failed, "
+                                            "Reason=[Requested size exceeds maximum size], "
+                                            "size=[%zu], limit=[%zu]"),
+                new_size, max_size()));
+        size_type const buffer_capacity = growth_policy::template next_capacity<value_type>(
+            this->capacity() + 1, new_size + 1, max_size() + 1);
+        reserve_impl(buffer_capacity - 1);
+    }
+
     __UTL_HIDE_FROM_ABI __UTL_STRING_INLINE UTL_CONSTEXPR_CXX20 void reserve_impl(
         size_type new_capacity) UTL_THROWS {
         UTL_ASSERT(new_capacity > this->capacity());
@@ -1418,9 +1448,9 @@ private:
         allocator_type& alloc, basic_short_string const& src) UTL_THROWS {
         UTL_ASSERT(src.is_heap_);
         UTL_TRY {
-            size_type const buffer_capacity = src.capacity() + 1;
-            heap_type heap{alloc_traits::allocate(alloc, buffer_capacity), buffer_capacity};
-            traits_type::copy(heap.data_, src.data(), src.size() + 1);
+            auto result = alloc_traits::allocate_at_least(alloc, src.size() + 1);
+            heap_type heap{__UTL move(result.ptr), result.size};
+            traits_type::copy(__UTL to_address(heap.data_), src.data(), src.size() + 1);
             return heap;
         } UTL_CATCH(program_exception& exception) {
             exception.emplace_messagef(UTL_MESSAGE_FORMAT(
@@ -1519,157 +1549,157 @@ private:
     size_type is_heap_ : 1;
 };
 
-template <typename CharT, size_t N, typename Traits, typename Alloc, typename U>
-__UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 typename basic_short_string<CharT, N, Traits, Alloc>::size_type
-erase(basic_short_string<CharT, N, Traits, Alloc>& c, U const& value) {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth, typename U>
+__UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 typename basic_short_string<CharT, N, Traits, Alloc, Growth>::size_type
+erase(basic_short_string<CharT, N, Traits, Alloc, Growth>& c, U const& value) {
     auto const it = __UTL remove(c.begin(), c.end(), value);
     auto const result = c.end() - it;
     c.erase(it, c.end());
     return result;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc, typename Pred>
-__UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 typename basic_short_string<CharT, N, Traits, Alloc>::size_type
-erase_if(basic_short_string<CharT, N, Traits, Alloc>& c, Pred const& pred) {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth, typename Pred>
+__UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 typename basic_short_string<CharT, N, Traits, Alloc, Growth>::size_type
+erase_if(basic_short_string<CharT, N, Traits, Alloc, Growth>& c, Pred const& pred) {
     auto const it = __UTL remove_if(c.begin(), c.end(), pred);
     auto const result = c.end() - it;
     c.erase(it, c.end());
     return result;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTES(STRING_PURE) inline constexpr bool operator==(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs,
-    basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs,
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTES(STRING_PURE) inline constexpr bool operator==(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs, CharT const* rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs, CharT const* rhs) noexcept {
     return lhs.compare(rhs) == 0;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc> const& l,
-    basic_short_string<CharT, N, Traits, Alloc> const& r) UTL_THROWS {
-    basic_short_string<CharT, N, Traits, Alloc> output;
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& l,
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& r) UTL_THROWS {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> output;
     output.reserve(l.size() + r.size());
     output += l;
     output += r;
     return output;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc> const& l, CharT const* r) UTL_THROWS {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& l, CharT const* r) UTL_THROWS {
     return l + basic_string_view<CharT, Traits>(r);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc> const& l, CharT r) UTL_THROWS {
-    basic_short_string<CharT, N, Traits, Alloc> output;
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& l, CharT r) UTL_THROWS {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> output;
     output.reserve(l.size() + 1);
     output += l;
     output += r;
     return output;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc> const& l,
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& l,
     type_identity_t<basic_string_view<CharT, Traits>> r) UTL_THROWS {
-    basic_short_string<CharT, N, Traits, Alloc> output;
+    basic_short_string<CharT, N, Traits, Alloc, Growth> output;
     output.reserve(l.size() + r.size());
     output += l;
     output += r;
     return output;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    CharT const* l, basic_short_string<CharT, N, Traits, Alloc> const& r) UTL_THROWS {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    CharT const* l, basic_short_string<CharT, N, Traits, Alloc, Growth> const& r) UTL_THROWS {
     return basic_string_view<CharT, Traits>(l) + r;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    CharT l, basic_short_string<CharT, N, Traits, Alloc> const& r) UTL_THROWS {
-    basic_short_string<CharT, N, Traits, Alloc> output;
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    CharT l, basic_short_string<CharT, N, Traits, Alloc, Growth> const& r) UTL_THROWS {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> output;
     output.reserve(l.size() + 1);
     output += l;
     output += r;
     return output;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
     type_identity_t<basic_string_view<CharT, Traits>> l,
-    basic_short_string<CharT, N, Traits, Alloc> const& r) UTL_THROWS {
-    basic_short_string<CharT, N, Traits, Alloc> output;
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& r) UTL_THROWS {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> output;
     output.reserve(l.size() + r.size());
     output.append(l).append(r);
     return output;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc>&& l,
-    basic_short_string<CharT, N, Traits, Alloc>&& r) UTL_THROWS {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth>&& l,
+    basic_short_string<CharT, N, Traits, Alloc, Growth>&& r) UTL_THROWS {
     return __UTL move(l.append(r));
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc>&& l,
-    basic_short_string<CharT, N, Traits, Alloc> const& r) UTL_THROWS {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth>&& l,
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& r) UTL_THROWS {
     return __UTL move(l.append(r));
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc>&& l, CharT const* r) UTL_THROWS {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth>&& l, CharT const* r) UTL_THROWS {
     return __UTL move(l.append(r));
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc>&& l, CharT r) UTL_THROWS {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth>&& l, CharT r) UTL_THROWS {
     return __UTL move(l.append(r));
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc>&& l,
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth>&& l,
     type_identity_t<basic_string_view<CharT, Traits>> r) UTL_THROWS {
     return __UTL move(l.append(r));
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    basic_short_string<CharT, N, Traits, Alloc> const& l,
-    basic_short_string<CharT, N, Traits, Alloc>&& r) UTL_THROWS {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& l,
+    basic_short_string<CharT, N, Traits, Alloc, Growth>&& r) UTL_THROWS {
     return __UTL move(r.insert(0, l));
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    CharT const* l, basic_short_string<CharT, N, Traits, Alloc>&& r) UTL_THROWS {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    CharT const* l, basic_short_string<CharT, N, Traits, Alloc, Growth>&& r) UTL_THROWS {
     return __UTL move(r.insert(0, l));
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
-    CharT l, basic_short_string<CharT, N, Traits, Alloc>&& r) UTL_THROWS {
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
+    CharT l, basic_short_string<CharT, N, Traits, Alloc, Growth>&& r) UTL_THROWS {
     return __UTL move(r.insert(0, l));
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc> operator+(
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+UTL_ATTRIBUTES(NODISCARD,_HIDE_FROM_ABI) inline constexpr basic_short_string<CharT, N, Traits, Alloc, Growth> operator+(
     type_identity_t<basic_string_view<CharT, Traits>> l,
-    basic_short_string<CharT, N, Traits, Alloc>&& r) UTL_THROWS {
+    basic_short_string<CharT, N, Traits, Alloc, Growth>&& r) UTL_THROWS {
     return __UTL move(r.insert(0, l));
 }
 
@@ -1681,17 +1711,17 @@ UTL_NAMESPACE_END
 
 UTL_NAMESPACE_BEGIN
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr typename Traits::comparison_category operator<=>(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs,
-    basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs,
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     using result_type = typename Traits::comparison_category;
     return static_cast<result_type>(lhs.compare(rhs) <=> 0);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr typename Traits::comparison_category operator<=>(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs, CharT const* rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs, CharT const* rhs) noexcept {
     using result_type = typename Traits::comparison_category;
     return static_cast<result_type>(lhs.compare(rhs) <=> 0);
 }
@@ -1702,98 +1732,98 @@ UTL_NAMESPACE_END
 
 UTL_NAMESPACE_BEGIN
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator<(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs,
-    basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs,
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return lhs.compare(rhs) < 0;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator<(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs, CharT const* rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs, CharT const* rhs) noexcept {
     return lhs.compare(rhs) < 0;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator<(
-    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return rhs.compare(lhs) > 0;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator>(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs,
-    basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs,
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return rhs < lhs;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator>(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs, CharT const* rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs, CharT const* rhs) noexcept {
     return rhs < lhs;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator>(
-    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return rhs < lhs;
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator>=(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs,
-    basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs,
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return !(lhs < rhs);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator>=(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs, CharT const* rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs, CharT const* rhs) noexcept {
     return !(lhs < rhs);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator>=(
-    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return !(lhs < rhs);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator<=(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs,
-    basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs,
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return !(rhs < lhs);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator<=(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs, CharT const* rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs, CharT const* rhs) noexcept {
     return !(rhs < lhs);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator<=(
-    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return !(rhs < lhs);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator!=(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs,
-    basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs,
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return !(lhs == rhs);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator!=(
-    basic_short_string<CharT, N, Traits, Alloc> const& lhs, CharT const* rhs) noexcept {
+    basic_short_string<CharT, N, Traits, Alloc, Growth> const& lhs, CharT const* rhs) noexcept {
     return !(lhs == rhs);
 }
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
 UTL_ATTRIBUTE(STRING_PURE) inline constexpr bool operator!=(
-    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc> const& rhs) noexcept {
+    CharT const* lhs, basic_short_string<CharT, N, Traits, Alloc, Growth> const& rhs) noexcept {
     return !(lhs == rhs);
 }
 
@@ -1810,9 +1840,9 @@ UTL_NAMESPACE_END
 
 UTL_NAMESPACE_BEGIN
 
-template <typename CharT, size_t N, typename Traits, typename Alloc>
-__UTL_ABI_PUBLIC constexpr typename basic_short_string<CharT, N, Traits, Alloc>::size_type
-    basic_short_string<CharT, N, Traits, Alloc>::npos;
+template <typename CharT, size_t N, typename Traits, typename Alloc, typename Growth>
+__UTL_ABI_PUBLIC constexpr typename basic_short_string<CharT, N, Traits, Alloc, Growth>::size_type
+    basic_short_string<CharT, N, Traits, Alloc, Growth>::npos;
 
 UTL_NAMESPACE_END
 
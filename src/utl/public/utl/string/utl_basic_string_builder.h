@@ -0,0 +1,435 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/string/utl_string_fwd.h"
+
+#include "utl/exception.h"
+#include "utl/memory/utl_allocator.h"
+#include "utl/memory/utl_allocator_traits.h"
+#include "utl/memory/utl_to_address.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/string/utl_basic_short_string.h"
+#include "utl/string/utl_basic_string_view.h"
+#include "utl/string/utl_libc.h"
+#include "utl/utility/utl_compressed_pair.h"
+#include "utl/utility/utl_exchange.h"
+
+#define __UTL_ATTRIBUTE_BUILDER_PURE (PURE)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_BUILDER_PURE
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Chunked string builder for assembling large strings
+ *
+ * The content is kept as an ordered list of pieces, each a view either into an external string or
+ * into a chunk owned by the builder. Appending never moves previously written characters and
+ * inserting in the middle only shifts the piece list, not the characters. The result is flattened
+ * into a `basic_short_string` exactly once with an allocation of the final size.
+ *
+ * Views passed to `append_view`/`insert_view` are not copied, the referenced characters must
+ * outlive the builder or the last call to `str`/`copy`.
+ */
+template <typename CharType, typename Traits, typename Alloc>
+class __UTL_PUBLIC_TEMPLATE basic_string_builder {
+public:
+    using allocator_type = Alloc;
+    using value_type = CharType;
+    using traits_type = Traits;
+    using size_type = typename allocator_traits<allocator_type>::size_type;
+    using view_type = basic_string_view<value_type, traits_type>;
+    using string_type = basic_string<value_type, traits_type, allocator_type>;
+
+private:
+    using alloc_traits = allocator_traits<allocator_type>;
+    using chunk_type = typename alloc_traits::allocation_result;
+    using piece_traits = typename alloc_traits::template rebind_traits<view_type>;
+    using chunk_traits = typename alloc_traits::template rebind_traits<chunk_type>;
+    using piece_allocator = typename piece_traits::allocator_type;
+    using chunk_allocator = typename chunk_traits::allocator_type;
+
+    /**
+     * Chunk sizes in bytes, each chunk doubles the previous one up to the maximum
+     */
+    static constexpr size_type min_chunk_bytes = 256;
+    static constexpr size_type max_chunk_bytes = 64 * 1024;
+
+public:
+    __UTL_HIDE_FROM_ABI inline basic_string_builder() noexcept(noexcept(allocator_type()))
+        : basic_string_builder(allocator_type()) {}
+
+    __UTL_HIDE_FROM_ABI explicit inline basic_string_builder(allocator_type const& alloc) noexcept
+        : pieces_()
+        , chunks_()
+        , storage_(size_type(0), alloc) {}
+
+    __UTL_HIDE_FROM_ABI inline basic_string_builder(basic_string_builder&& other) noexcept
+        : pieces_(__UTL exchange(other.pieces_, piece_list{}))
+        , chunks_(__UTL exchange(other.chunks_, chunk_list{}))
+        , storage_(__UTL exchange(other.size_ref(), 0), other.allocator_ref())
+        , used_(__UTL exchange(other.used_, 0)) {}
+
+    basic_string_builder(basic_string_builder const&) = delete;
+    basic_string_builder& operator=(basic_string_builder const&) = delete;
+    basic_string_builder& operator=(basic_string_builder&&) = delete;
+
+    __UTL_HIDE_FROM_ABI inline ~basic_string_builder() noexcept { release(); }
+
+    UTL_ATTRIBUTE(BUILDER_PURE) inline size_type size() const noexcept { return size_ref(); }
+
+    UTL_ATTRIBUTE(BUILDER_PURE) inline bool empty() const noexcept { return size_ref() == 0; }
+
+    UTL_ATTRIBUTE(BUILDER_PURE) inline allocator_type get_allocator() const noexcept {
+        return allocator_ref();
+    }
+
+    /**
+     * Copies `view` into the builder
+     */
+    __UTL_HIDE_FROM_ABI inline basic_string_builder& append(view_type view) UTL_THROWS {
+        return append(view.data(), view.size());
+    }
+
+    __UTL_HIDE_FROM_ABI inline basic_string_builder& append(
+        value_type const* str, size_type count) UTL_THROWS {
+        if (count) {
+            traits_type::copy(write_area(count), str, count);
+            commit_back(count);
+        }
+
+        return *this;
+    }
+
+    __UTL_HIDE_FROM_ABI inline basic_string_builder& append(
+        size_type count, value_type ch) UTL_THROWS {
+        if (count) {
+            traits_type::assign(write_area(count), count, ch);
+            commit_back(count);
+        }
+
+        return *this;
+    }
+
+    __UTL_HIDE_FROM_ABI inline basic_string_builder& push_back(value_type ch) UTL_THROWS {
+        return append(1, ch);
+    }
+
+    /**
+     * Appends `view` by reference without copying its characters
+     */
+    __UTL_HIDE_FROM_ABI inline basic_string_builder& append_view(view_type view) UTL_THROWS {
+        if (!view.empty()) {
+            reserve_pieces(1);
+            place_piece(pieces_.size, view);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Copies `view` into the builder, inserting it before the character at `pos`
+     */
+    __UTL_HIDE_FROM_ABI inline basic_string_builder& insert(
+        size_type pos, view_type view) UTL_THROWS {
+        check_position(pos);
+        if (view.empty()) {
+            return *this;
+        }
+
+        if (pos == size()) {
+            return append(view);
+        }
+
+        reserve_pieces(2);
+        value_type* const dst = write_area(view.size());
+        traits_type::copy(dst, view.data(), view.size());
+        used_ += view.size();
+        insert_piece(pos, view_type(dst, view.size()));
+        return *this;
+    }
+
+    /**
+     * Inserts `view` by reference before the character at `pos` without copying its characters
+     */
+    __UTL_HIDE_FROM_ABI inline basic_string_builder& insert_view(
+        size_type pos, view_type view) UTL_THROWS {
+        check_position(pos);
+        if (!view.empty()) {
+            reserve_pieces(2);
+            insert_piece(pos, view);
+        }
+
+        return *this;
+    }
+
+    __UTL_HIDE_FROM_ABI inline basic_string_builder& operator+=(view_type view) UTL_THROWS {
+        return append(view);
+    }
+
+    __UTL_HIDE_FROM_ABI inline basic_string_builder& operator+=(value_type ch) UTL_THROWS {
+        return push_back(ch);
+    }
+
+    /**
+     * Discards the content, the most recent chunk is kept for reuse
+     */
+    __UTL_HIDE_FROM_ABI inline void clear() noexcept {
+        if (chunks_.size > 1) {
+            chunk_type* const chunks = __UTL to_address(chunks_.data);
+            for (size_type i = 0; i < chunks_.size - 1; ++i) {
+                alloc_traits::deallocate(allocator_ref(), chunks[i].ptr, chunks[i].size);
+            }
+
+            chunks[0] = chunks[chunks_.size - 1];
+            chunks_.size = 1;
+        }
+
+        pieces_.size = 0;
+        size_ref() = 0;
+        used_ = 0;
+    }
+
+    /**
+     * Invokes `func` with each piece in order
+     */
+    template <typename F>
+    __UTL_HIDE_FROM_ABI inline void for_each_piece(F&& func) const {
+        view_type const* const pieces = __UTL to_address(pieces_.data);
+        for (size_type i = 0; i < pieces_.size; ++i) {
+            func(pieces[i]);
+        }
+    }
+
+    /**
+     * Copies the content to `dst` which must have space for `size()` elements, no null-terminator
+     * is written
+     *
+     * @return number of elements written
+     */
+    __UTL_HIDE_FROM_ABI inline size_type copy(value_type* dst) const noexcept {
+        view_type const* const pieces = __UTL to_address(pieces_.data);
+        for (size_type i = 0; i < pieces_.size; ++i) {
+            traits_type::copy(dst, pieces[i].data(), pieces[i].size());
+            dst += pieces[i].size();
+        }
+
+        return size();
+    }
+
+    /**
+     * Appends the content to `output` growing it at most once
+     */
+    template <size_t N, typename Growth>
+    __UTL_HIDE_FROM_ABI inline void append_to(
+        basic_short_string<value_type, N, traits_type, allocator_type, Growth>& output) const
+        UTL_THROWS {
+        output.reserve(output.size() + size());
+        for_each_piece([&](view_type piece) { output.append(piece.data(), piece.size()); });
+    }
+
+    /**
+     * Flattens the content into a single string with an allocation of exactly `size() + 1`
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline string_type str() const UTL_THROWS {
+        string_type output(allocator_ref());
+        append_to(output);
+        return output;
+    }
+
+private:
+    template <typename Pointer>
+    struct list {
+        Pointer data;
+        size_type capacity;
+        size_type size;
+    };
+
+    using piece_list = list<typename piece_traits::pointer>;
+    using chunk_list = list<typename chunk_traits::pointer>;
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline size_type& size_ref() noexcept {
+        return storage_.first();
+    }
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline size_type const& size_ref() const noexcept {
+        return storage_.first();
+    }
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline allocator_type& allocator_ref() noexcept {
+        return storage_.second();
+    }
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline allocator_type const&
+    allocator_ref() const noexcept {
+        return storage_.second();
+    }
+
+    __UTL_HIDE_FROM_ABI inline void check_position(size_type pos) const UTL_THROWS {
+        UTL_THROW_IF(pos > size(),
+            out_of_range(UTL_MESSAGE_FORMAT("[UTL] basic_string_builder::insert operation failed, "
+                                            "Reason=[index out of range], pos=[%zu], size=[%zu]"),
+                pos, size()));
+    }
+
+    /**
+     * Ensures the piece list can take `count` more pieces
+     */
+    __UTL_HIDE_FROM_ABI inline void reserve_pieces(size_type count) UTL_THROWS {
+        if (pieces_.capacity - pieces_.size >= count) {
+            return;
+        }
+
+        piece_allocator alloc(allocator_ref());
+        size_type const required = pieces_.size + count;
+        size_type const capacity = __UTL numeric::max(required, pieces_.capacity * 2);
+        auto const result = pieces_.capacity
+            ? piece_traits::reallocate_at_least(alloc, {pieces_.data, pieces_.capacity}, capacity)
+            : piece_traits::allocate_at_least(alloc, capacity);
+        pieces_.data = result.ptr;
+        pieces_.capacity = result.size;
+    }
+
+    /**
+     * @return pointer to at least `count` unused elements at the end of the current chunk
+     */
+    __UTL_HIDE_FROM_ABI inline value_type* write_area(size_type count) UTL_THROWS {
+        if (chunks_.size == 0 || back_chunk().size - used_ < count) {
+            add_chunk(count);
+        }
+
+        return __UTL to_address(back_chunk().ptr) + used_;
+    }
+
+    __UTL_HIDE_FROM_ABI inline void add_chunk(size_type count) UTL_THROWS {
+        if (chunks_.size == chunks_.capacity) {
+            chunk_allocator alloc(allocator_ref());
+            size_type const capacity = __UTL numeric::max(size_type(4), chunks_.capacity * 2);
+            auto const result = chunks_.capacity
+                ? chunk_traits::reallocate_at_least(
+                      alloc, {chunks_.data, chunks_.capacity}, capacity)
+                : chunk_traits::allocate_at_least(alloc, capacity);
+            chunks_.data = result.ptr;
+            chunks_.capacity = result.size;
+        }
+
+        size_type const previous = chunks_.size ? back_chunk().size * sizeof(value_type) : 0;
+        size_type const bytes = __UTL numeric::max(
+            min_chunk_bytes, __UTL numeric::min(previous * 2, max_chunk_bytes));
+        size_type const elements = __UTL numeric::max(count, bytes / sizeof(value_type));
+        __UTL to_address(chunks_.data)[chunks_.size] =
+            alloc_traits::allocate_at_least(allocator_ref(), elements);
+        ++chunks_.size;
+        used_ = 0;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline chunk_type& back_chunk() noexcept {
+        return __UTL to_address(chunks_.data)[chunks_.size - 1];
+    }
+
+    /**
+     * Records `count` elements written to the write area as the last piece, extending the last
+     * piece if it ends where the write area begins
+     */
+    __UTL_HIDE_FROM_ABI inline void commit_back(size_type count) UTL_THROWS {
+        value_type const* const dst = __UTL to_address(back_chunk().ptr) + used_;
+        if (pieces_.size) {
+            view_type& last = __UTL to_address(pieces_.data)[pieces_.size - 1];
+            if (last.data() + last.size() == dst) {
+                last = view_type(last.data(), last.size() + count);
+                used_ += count;
+                size_ref() += count;
+                return;
+            }
+        }
+
+        // The characters have been written but the chunk is only marked used once the piece is
+        // recorded, a failure leaves them in the free area
+        reserve_pieces(1);
+        used_ += count;
+        place_piece(pieces_.size, view_type(dst, count));
+    }
+
+    /**
+     * Places `piece` at index `idx` of the piece list, capacity must already be reserved
+     */
+    __UTL_HIDE_FROM_ABI inline void place_piece(size_type idx, view_type piece) noexcept {
+        view_type* const pieces = __UTL to_address(pieces_.data);
+        if (idx != pieces_.size) {
+            __UTL libc::memmove(
+                pieces + idx + 1, pieces + idx, libc::element_count_t(pieces_.size - idx));
+        }
+
+        pieces[idx] = piece;
+        ++pieces_.size;
+        size_ref() += piece.size();
+    }
+
+    /**
+     * Inserts `piece` before the character at `pos`, splitting the piece containing it if needed;
+     * space for two pieces must already be reserved
+     */
+    __UTL_HIDE_FROM_ABI inline void insert_piece(size_type pos, view_type piece) noexcept {
+        view_type* const pieces = __UTL to_address(pieces_.data);
+        size_type idx = 0;
+        while (idx < pieces_.size && pos >= pieces[idx].size()) {
+            pos -= pieces[idx].size();
+            ++idx;
+        }
+
+        if (pos != 0) {
+            view_type const whole = pieces[idx];
+            pieces[idx] = whole.substr(0, pos);
+            ++idx;
+            place_piece(idx, whole.substr(pos));
+            size_ref() -= whole.size() - pos;
+        }
+
+        place_piece(idx, piece);
+    }
+
+    __UTL_HIDE_FROM_ABI inline void release() noexcept {
+        chunk_type* const chunks = __UTL to_address(chunks_.data);
+        for (size_type i = 0; i < chunks_.size; ++i) {
+            alloc_traits::deallocate(allocator_ref(), chunks[i].ptr, chunks[i].size);
+        }
+
+        if (chunks_.capacity) {
+            chunk_allocator alloc(allocator_ref());
+            chunk_traits::deallocate(alloc, chunks_.data, chunks_.capacity);
+        }
+
+        if (pieces_.capacity) {
+            piece_allocator alloc(allocator_ref());
+            piece_traits::deallocate(alloc, pieces_.data, pieces_.capacity);
+        }
+    }
+
+    piece_list pieces_;
+    chunk_list chunks_;
+    compressed_pair<size_type, allocator_type> storage_;
+    /**
+     * Number of elements written to the most recent chunk
+     */
+    size_type used_ = 0;
+};
+
+UTL_NAMESPACE_END
+
+#if !UTL_CXX17
+
+UTL_NAMESPACE_BEGIN
+
+template <typename CharType, typename Traits, typename Alloc>
+__UTL_ABI_PUBLIC constexpr typename basic_string_builder<CharType, Traits, Alloc>::size_type
+    basic_string_builder<CharType, Traits, Alloc>::min_chunk_bytes;
+template <typename CharType, typename Traits, typename Alloc>
+__UTL_ABI_PUBLIC constexpr typename basic_string_builder<CharType, Traits, Alloc>::size_type
+    basic_string_builder<CharType, Traits, Alloc>::max_chunk_bytes;
+
+UTL_NAMESPACE_END
+
+#endif
+
+#undef __UTL_ATTRIBUTE_BUILDER_PURE
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_BUILDER_PURE
@@ -0,0 +1,722 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/string/utl_string_fwd.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/bit/utl_bit_ceil.h"
+#include "utl/exception.h"
+#include "utl/hash/utl_wyhash.h"
+#include "utl/memory/utl_allocator.h"
+#include "utl/memory/utl_allocator_traits.h"
+#include "utl/memory/utl_pointer_traits.h"
+#include "utl/memory/utl_to_address.h"
+#include "utl/numeric/utl_limits.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/string/utl_basic_string_view.h"
+#include "utl/string/utl_basic_zstring_view.h"
+#include "utl/utility/utl_compressed_pair.h"
+#include "utl/utility/utl_exchange.h"
+#include "utl/utility/utl_move.h"
+
+#include <new>
+#include <stdint.h>
+
+#define __UTL_ATTRIBUTE_STRING_POOL_PURE (PURE)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_STRING_POOL_PURE
+#define __UTL_ATTRIBUTE_STRING_POOL_CONST (CONST)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_STRING_POOL_CONST
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Memory usage of a string pool, all sizes are in bytes
+ */
+struct string_pool_statistics {
+    /**
+     * Number of unique strings in the pool
+     */
+    size_t strings;
+    /**
+     * Characters of the unique strings, including their null terminators
+     */
+    size_t string_bytes;
+    /**
+     * Memory held by the arena pages
+     */
+    size_t arena_bytes;
+    /**
+     * Part of the arena pages consumed by string headers, characters and page headers
+     */
+    size_t arena_used_bytes;
+    /**
+     * Memory held by the lookup table
+     */
+    size_t table_bytes;
+    /**
+     * Number of arena pages
+     */
+    size_t pages;
+};
+
+namespace details {
+namespace string_pool {
+
+/**
+ * Header of an interned string, the null-terminated characters follow it in the same page
+ */
+struct entry {
+    uint64_t hash;
+    size_t size;
+};
+
+/**
+ * Header at the start of every arena page, the pages of an arena form a singly linked list
+ */
+struct page {
+    page* next;
+    /**
+     * Number of entry sized units in the page, including the header
+     */
+    size_t units;
+    /**
+     * Number of units handed out, may exceed `units` in a concurrent arena once the page is full
+     */
+    size_t used;
+};
+
+UTL_INLINE_CXX17 constexpr size_t header_units =
+    (sizeof(page) + sizeof(entry) - 1) / sizeof(entry);
+
+/**
+ * Number of entry sized units occupied by a string of `size` characters
+ */
+template <typename CharType>
+UTL_ATTRIBUTE(STRING_POOL_CONST) inline constexpr size_t entry_units(size_t size) noexcept {
+    return 1 + ((size + 1) * sizeof(CharType) + sizeof(entry) - 1) / sizeof(entry);
+}
+
+template <typename CharType>
+UTL_ATTRIBUTE(STRING_POOL_CONST) inline CharType* characters(entry* ptr) noexcept {
+    static_assert(alignof(CharType) <= alignof(entry), "Unsupported character type");
+    return reinterpret_cast<CharType*>(ptr + 1);
+}
+
+template <typename CharType>
+UTL_ATTRIBUTE(STRING_POOL_CONST) inline CharType const* characters(entry const* ptr) noexcept {
+    return reinterpret_cast<CharType const*>(ptr + 1);
+}
+
+template <typename CharType, typename Traits>
+UTL_ATTRIBUTE(STRING_POOL_PURE) inline bool matches(
+    entry const* ptr, uint64_t hash, basic_string_view<CharType, Traits> str) noexcept {
+    return ptr->hash == hash && ptr->size == str.size() &&
+        Traits::compare(characters<CharType>(ptr), str.data(), str.size()) == 0;
+}
+
+template <typename CharType, typename Traits>
+UTL_ATTRIBUTE(STRING_POOL_PURE) inline uint64_t hash(
+    basic_string_view<CharType, Traits> str) noexcept {
+    return __UTL hashing::wyhash(str.data(), str.size());
+}
+
+/**
+ * Bump allocator of entry sized units backed by pages obtained from `Alloc`
+ *
+ * Units are never returned individually, all pages are released together. Strings larger than a
+ * quarter of a page get a dedicated page so that they do not waste the tail of the current one.
+ */
+template <typename Alloc>
+class __UTL_PUBLIC_TEMPLATE arena {
+    using unit_traits = typename allocator_traits<Alloc>::template rebind_traits<entry>;
+    using unit_allocator = typename unit_traits::allocator_type;
+    using unit_pointer = typename unit_traits::pointer;
+
+public:
+    static constexpr size_t page_units = 64 * 1024 / sizeof(entry);
+    static constexpr size_t large_units = page_units / 4;
+
+    __UTL_HIDE_FROM_ABI explicit inline arena(Alloc const& alloc) noexcept
+        : storage_(nullptr, unit_allocator(alloc))
+        , large_(nullptr) {}
+
+    __UTL_HIDE_FROM_ABI inline arena(arena&& other) noexcept
+        : storage_(__UTL exchange(other.storage_.first(), nullptr), other.storage_.second())
+        , large_(__UTL exchange(other.large_, nullptr)) {}
+
+    arena(arena const&) = delete;
+    arena& operator=(arena const&) = delete;
+    arena& operator=(arena&&) = delete;
+
+    __UTL_HIDE_FROM_ABI inline ~arena() noexcept { release(); }
+
+    __UTL_HIDE_FROM_ABI inline void release() noexcept {
+        release(__UTL exchange(storage_.first(), nullptr));
+        release(__UTL exchange(large_, nullptr));
+    }
+
+    /**
+     * @return `units` contiguous units, must not be called concurrently
+     */
+    __UTL_HIDE_FROM_ABI inline entry* allocate(size_t units) UTL_THROWS {
+        if (units > large_units) {
+            large_ = make_page(header_units + units, large_);
+            large_->used += units;
+            return first_unit(large_);
+        }
+
+        page* current = storage_.first();
+        if (current == nullptr || current->units - current->used < units) {
+            current = storage_.first() = make_page(page_units, current);
+        }
+
+        entry* const result = unit_at(current, current->used);
+        current->used += units;
+        return result;
+    }
+
+    /**
+     * @return `units` contiguous units, lock-free with respect to other calls to this function
+     */
+    __UTL_HIDE_FROM_ABI inline entry* allocate_concurrent(size_t units) UTL_THROWS {
+        if (units > large_units) {
+            page* const fresh = make_page(header_units + units, nullptr);
+            fresh->used += units;
+            page* head = atomic_relaxed::load(&large_);
+            do {
+                fresh->next = head;
+            } while (!atomic_release::compare_exchange_weak(
+                &large_, &head, fresh, atomics::relaxed_failure));
+            return first_unit(fresh);
+        }
+
+        page* current = atomic_acquire::load(&current_ref());
+        while (true) {
+            if (current != nullptr) {
+                size_t const offset = atomic_relaxed::fetch_add(&current->used, units);
+                if (offset <= current->units && current->units - offset >= units) {
+                    return unit_at(current, offset);
+                }
+            }
+
+            // The page is exhausted, racing threads each allocate a replacement but only the
+            // first one to be published is kept
+            page* const fresh = make_page(page_units, current);
+            fresh->used += units;
+            if (atomic_acq_rel::compare_exchange_strong(
+                    &current_ref(), &current, fresh, atomics::acquire_failure)) {
+                return first_unit(fresh);
+            }
+
+            deallocate(fresh);
+        }
+    }
+
+    __UTL_HIDE_FROM_ABI inline void collect(string_pool_statistics& stats) const noexcept {
+        collect(atomic_acquire::load(&storage_.first()), stats);
+        collect(atomic_acquire::load(&large_), stats);
+    }
+
+private:
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline page*& current_ref() noexcept {
+        return storage_.first();
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_CONST) static inline entry* unit_at(page* ptr, size_t idx) noexcept {
+        return reinterpret_cast<entry*>(ptr) + idx;
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_CONST) static inline entry* first_unit(page* ptr) noexcept {
+        return unit_at(ptr, header_units);
+    }
+
+    __UTL_HIDE_FROM_ABI inline page* make_page(size_t units, page* next) UTL_THROWS {
+        auto const result = unit_traits::allocate_at_least(storage_.second(), units);
+        return ::new (static_cast<void*>(__UTL to_address(result.ptr)))
+            page{next, result.size, header_units};
+    }
+
+    __UTL_HIDE_FROM_ABI inline void deallocate(page* ptr) noexcept {
+        size_t const units = ptr->units;
+        unit_traits::deallocate(storage_.second(),
+            pointer_traits<unit_pointer>::pointer_to(*reinterpret_cast<entry*>(ptr)), units);
+    }
+
+    __UTL_HIDE_FROM_ABI inline void release(page* head) noexcept {
+        while (head != nullptr) {
+            page* const next = head->next;
+            deallocate(head);
+            head = next;
+        }
+    }
+
+    __UTL_HIDE_FROM_ABI static inline void collect(
+        page const* head, string_pool_statistics& stats) noexcept {
+        for (; head != nullptr; head = head->next) {
+            size_t const used = atomic_relaxed::load(&head->used);
+            stats.arena_bytes += head->units * sizeof(entry);
+            stats.arena_used_bytes += __UTL numeric::min(used, head->units) * sizeof(entry);
+            ++stats.pages;
+        }
+    }
+
+    /**
+     * The page currently being bump allocated from and the allocator
+     */
+    compressed_pair<page*, unit_allocator> storage_;
+    /**
+     * Dedicated pages of large strings
+     */
+    page* large_;
+};
+
+} // namespace string_pool
+} // namespace details
+
+/**
+ * String interning pool
+ *
+ * Each unique string is stored once, null-terminated, in arena pages owned by the pool. The
+ * returned `basic_zstring_view` handles remain valid and keep their address until the pool is
+ * cleared or destroyed, so two handles obtained from the same pool refer to equal strings if and
+ * only if their `data()` pointers are equal.
+ *
+ * Lookups use an open addressing table that grows as strings are added. The pool is not thread
+ * safe, see `basic_concurrent_string_pool` for concurrent use.
+ */
+template <typename CharType, typename Traits, typename Alloc>
+class __UTL_PUBLIC_TEMPLATE basic_string_pool {
+    using entry = details::string_pool::entry;
+    using arena_type = details::string_pool::arena<Alloc>;
+    using slot_traits = typename allocator_traits<Alloc>::template rebind_traits<entry*>;
+    using slot_allocator = typename slot_traits::allocator_type;
+    using slot_pointer = typename slot_traits::pointer;
+
+    static constexpr size_t min_slots = 16;
+
+public:
+    using allocator_type = Alloc;
+    using value_type = CharType;
+    using traits_type = Traits;
+    using size_type = typename allocator_traits<allocator_type>::size_type;
+    using view_type = basic_string_view<value_type, traits_type>;
+    using handle_type = basic_zstring_view<value_type, traits_type>;
+
+    __UTL_HIDE_FROM_ABI inline basic_string_pool() noexcept(noexcept(allocator_type()))
+        : basic_string_pool(allocator_type()) {}
+
+    __UTL_HIDE_FROM_ABI explicit inline basic_string_pool(allocator_type const& alloc) noexcept
+        : arena_(alloc)
+        , slots_(nullptr)
+        , capacity_(0)
+        , storage_(size_type(0), alloc)
+        , string_bytes_(0) {}
+
+    __UTL_HIDE_FROM_ABI inline basic_string_pool(basic_string_pool&& other) noexcept
+        : arena_(__UTL move(other.arena_))
+        , slots_(__UTL exchange(other.slots_, nullptr))
+        , capacity_(__UTL exchange(other.capacity_, 0))
+        , storage_(__UTL exchange(other.size_ref(), 0), other.allocator_ref())
+        , string_bytes_(__UTL exchange(other.string_bytes_, 0)) {}
+
+    basic_string_pool(basic_string_pool const&) = delete;
+    basic_string_pool& operator=(basic_string_pool const&) = delete;
+    basic_string_pool& operator=(basic_string_pool&&) = delete;
+
+    __UTL_HIDE_FROM_ABI inline ~basic_string_pool() noexcept { release_table(); }
+
+    /**
+     * @return number of unique strings in the pool
+     */
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline size_type size() const noexcept { return size_ref(); }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline bool empty() const noexcept { return size_ref() == 0; }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline allocator_type get_allocator() const noexcept {
+        return allocator_ref();
+    }
+
+    /**
+     * @return the pooled copy of `str`, copying it into the pool if it is not present
+     */
+    __UTL_HIDE_FROM_ABI inline handle_type intern(view_type str) UTL_THROWS {
+        uint64_t const hash = details::string_pool::hash(str);
+        reserve(size() + 1);
+        size_type const idx = probe(hash, str);
+        if (slots()[idx] != nullptr) {
+            return handle(slots()[idx]);
+        }
+
+        entry* const result = make_entry(str, hash);
+        slots()[idx] = result;
+        ++size_ref();
+        string_bytes_ += (str.size() + 1) * sizeof(value_type);
+        return handle(result);
+    }
+
+    /**
+     * @return the pooled copy of `str`, or an empty handle with a null `data()` if it is absent
+     */
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline handle_type find(view_type str) const noexcept {
+        if (capacity_ != 0) {
+            entry* const result = slots()[probe(details::string_pool::hash(str), str)];
+            if (result != nullptr) {
+                return handle(result);
+            }
+        }
+
+        return handle_type();
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline bool contains(view_type str) const noexcept {
+        return find(str).data() != nullptr;
+    }
+
+    /**
+     * Prepares the lookup table for `count` strings without further rehashing
+     */
+    __UTL_HIDE_FROM_ABI inline void reserve(size_type count) UTL_THROWS {
+        UTL_THROW_IF(count > max_size(),
+            length_error(UTL_MESSAGE_FORMAT("[UTL] basic_string_pool::reserve operation failed, "
+                                            "Reason=[requested count exceeds max size], "
+                                            "count=[%zu], max=[%zu]"),
+                count, max_size()));
+        // Keeps the load factor at or below 3/4
+        if (count * 4 > capacity_ * 3) {
+            rehash(__UTL bit_ceil(__UTL numeric::max(size_type(min_slots), count + count / 3 + 1)));
+        }
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline size_type max_size() const noexcept {
+        return numeric::maximum<size_type>::value / (2 * sizeof(entry*));
+    }
+
+    /**
+     * Removes every string, invalidating all handles; the lookup table is kept for reuse
+     */
+    __UTL_HIDE_FROM_ABI inline void clear() noexcept {
+        arena_.release();
+        for (size_type i = 0; i < capacity_; ++i) {
+            slots()[i] = nullptr;
+        }
+
+        size_ref() = 0;
+        string_bytes_ = 0;
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline string_pool_statistics statistics() const noexcept {
+        string_pool_statistics stats{size(), string_bytes_, 0, 0, capacity_ * sizeof(entry*), 0};
+        arena_.collect(stats);
+        return stats;
+    }
+
+private:
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline size_type& size_ref() noexcept {
+        return storage_.first();
+    }
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline size_type const& size_ref() const noexcept {
+        return storage_.first();
+    }
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline allocator_type& allocator_ref() noexcept {
+        return storage_.second();
+    }
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline allocator_type const&
+    allocator_ref() const noexcept {
+        return storage_.second();
+    }
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline entry** slots() const noexcept {
+        return __UTL to_address(slots_);
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) static inline handle_type handle(entry const* ptr) noexcept {
+        return handle_type(details::string_pool::characters<value_type>(ptr), ptr->size);
+    }
+
+    /**
+     * @return index of the slot holding `str`, or of the empty slot where it would be placed
+     */
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline size_type probe(
+        uint64_t hash, view_type str) const noexcept {
+        size_type const mask = capacity_ - 1;
+        size_type idx = static_cast<size_type>(hash) & mask;
+        while (slots()[idx] != nullptr && !details::string_pool::matches(slots()[idx], hash, str)) {
+            idx = (idx + 1) & mask;
+        }
+
+        return idx;
+    }
+
+    __UTL_HIDE_FROM_ABI inline entry* make_entry(view_type str, uint64_t hash) UTL_THROWS {
+        entry* const result = ::new (static_cast<void*>(arena_.allocate(
+            details::string_pool::entry_units<value_type>(str.size())))) entry{hash, str.size()};
+        value_type* const dst = details::string_pool::characters<value_type>(result);
+        traits_type::copy(dst, str.data(), str.size());
+        traits_type::assign(dst[str.size()], value_type());
+        return result;
+    }
+
+    __UTL_HIDE_FROM_ABI inline void rehash(size_type capacity) UTL_THROWS {
+        slot_allocator alloc(allocator_ref());
+        slot_pointer const table = slot_traits::allocate(alloc, capacity);
+        entry** const dst = __UTL to_address(table);
+        for (size_type i = 0; i < capacity; ++i) {
+            dst[i] = nullptr;
+        }
+
+        size_type const mask = capacity - 1;
+        for (size_type i = 0; i < capacity_; ++i) {
+            entry* const item = slots()[i];
+            if (item != nullptr) {
+                size_type idx = static_cast<size_type>(item->hash) & mask;
+                while (dst[idx] != nullptr) {
+                    idx = (idx + 1) & mask;
+                }
+                dst[idx] = item;
+            }
+        }
+
+        release_table();
+        slots_ = table;
+        capacity_ = capacity;
+    }
+
+    __UTL_HIDE_FROM_ABI inline void release_table() noexcept {
+        if (capacity_ != 0) {
+            slot_allocator alloc(allocator_ref());
+            slot_traits::deallocate(alloc, slots_, capacity_);
+        }
+    }
+
+    arena_type arena_;
+    slot_pointer slots_;
+    /**
+     * Number of slots in the lookup table, zero or a power of two
+     */
+    size_type capacity_;
+    compressed_pair<size_type, allocator_type> storage_;
+    size_type string_bytes_;
+};
+
+/**
+ * Thread-safe string interning pool
+ *
+ * Provides the same handle guarantees as `basic_string_pool`. The lookup table has a fixed number
+ * of slots chosen at construction, which allows `find` and `intern` to be lock-free: an absent
+ * string is copied into the arena and published with a single compare-exchange on its slot. When
+ * two threads race to intern the same string, one copy is discarded and both threads receive the
+ * published handle; the discarded copy stays in the arena until the pool is destroyed.
+ */
+template <typename CharType, typename Traits, typename Alloc>
+class __UTL_PUBLIC_TEMPLATE basic_concurrent_string_pool {
+    using entry = details::string_pool::entry;
+    using arena_type = details::string_pool::arena<Alloc>;
+    using slot_traits = typename allocator_traits<Alloc>::template rebind_traits<entry*>;
+    using slot_allocator = typename slot_traits::allocator_type;
+    using slot_pointer = typename slot_traits::pointer;
+
+public:
+    using allocator_type = Alloc;
+    using value_type = CharType;
+    using traits_type = Traits;
+    using size_type = typename allocator_traits<allocator_type>::size_type;
+    using view_type = basic_string_view<value_type, traits_type>;
+    using handle_type = basic_zstring_view<value_type, traits_type>;
+
+    /**
+     * @param capacity - maximum number of unique strings the pool can hold
+     */
+    __UTL_HIDE_FROM_ABI explicit inline basic_concurrent_string_pool(
+        size_type capacity, allocator_type const& alloc = allocator_type()) UTL_THROWS
+        : arena_(alloc)
+        , slots_(nullptr)
+        , slot_count_(__UTL bit_ceil(__UTL numeric::max(size_type(16), capacity * 2)))
+        , storage_(capacity, alloc)
+        , size_(0)
+        , string_bytes_(0) {
+        slot_allocator slot_alloc(allocator_ref());
+        slots_ = slot_traits::allocate(slot_alloc, slot_count_);
+        for (size_type i = 0; i < slot_count_; ++i) {
+            slots()[i] = nullptr;
+        }
+    }
+
+    basic_concurrent_string_pool(basic_concurrent_string_pool const&) = delete;
+    basic_concurrent_string_pool& operator=(basic_concurrent_string_pool const&) = delete;
+
+    __UTL_HIDE_FROM_ABI inline ~basic_concurrent_string_pool() noexcept {
+        slot_allocator alloc(allocator_ref());
+        slot_traits::deallocate(alloc, slots_, slot_count_);
+    }
+
+    /**
+     * @return number of unique strings in the pool
+     */
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline size_type size() const noexcept {
+        return atomic_relaxed::load(&size_);
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline bool empty() const noexcept { return size() == 0; }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline size_type capacity() const noexcept {
+        return storage_.first();
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline allocator_type get_allocator() const noexcept {
+        return allocator_ref();
+    }
+
+    /**
+     * @return the pooled copy of `str`, copying it into the pool if it is not present
+     *
+     * @throws length_error if the pool already holds `capacity()` strings
+     */
+    __UTL_HIDE_FROM_ABI inline handle_type intern(view_type str) UTL_THROWS {
+        uint64_t const hash = details::string_pool::hash(str);
+        size_type const mask = slot_count_ - 1;
+        size_type idx = static_cast<size_type>(hash) & mask;
+        entry* fresh = nullptr;
+        while (true) {
+            entry* current = atomic_acquire::load(slots() + idx);
+            if (current == nullptr) {
+                if (fresh == nullptr) {
+                    acquire_capacity();
+                    fresh = make_entry(str, hash);
+                }
+
+                if (atomic_acq_rel::compare_exchange_strong(
+                        slots() + idx, &current, fresh, atomics::acquire_failure)) {
+                    atomic_relaxed::fetch_add(
+                        &string_bytes_, (str.size() + 1) * sizeof(value_type));
+                    return handle(fresh);
+                }
+            }
+
+            if (details::string_pool::matches(current, hash, str)) {
+                if (fresh != nullptr) {
+                    atomic_relaxed::fetch_sub(&size_, size_type(1));
+                }
+
+                return handle(current);
+            }
+
+            idx = (idx + 1) & mask;
+        }
+    }
+
+    /**
+     * @return the pooled copy of `str`, or an empty handle with a null `data()` if it is absent
+     */
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline handle_type find(view_type str) const noexcept {
+        uint64_t const hash = details::string_pool::hash(str);
+        size_type const mask = slot_count_ - 1;
+        size_type idx = static_cast<size_type>(hash) & mask;
+        while (true) {
+            entry* const current = atomic_acquire::load(slots() + idx);
+            if (current == nullptr) {
+                return handle_type();
+            }
+
+            if (details::string_pool::matches(current, hash, str)) {
+                return handle(current);
+            }
+
+            idx = (idx + 1) & mask;
+        }
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline bool contains(view_type str) const noexcept {
+        return find(str).data() != nullptr;
+    }
+
+    /**
+     * Safe to call concurrently with `intern`, the result is then a snapshot of each counter
+     * rather than of the whole pool
+     */
+    UTL_ATTRIBUTE(STRING_POOL_PURE) inline string_pool_statistics statistics() const noexcept {
+        string_pool_statistics stats{size(), atomic_relaxed::load(&string_bytes_), 0, 0,
+            slot_count_ * sizeof(entry*), 0};
+        arena_.collect(stats);
+        return stats;
+    }
+
+private:
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline allocator_type& allocator_ref() noexcept {
+        return storage_.second();
+    }
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline allocator_type const&
+    allocator_ref() const noexcept {
+        return storage_.second();
+    }
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline entry** slots() const noexcept {
+        return __UTL to_address(slots_);
+    }
+
+    UTL_ATTRIBUTE(STRING_POOL_PURE) static inline handle_type handle(entry const* ptr) noexcept {
+        return handle_type(details::string_pool::characters<value_type>(ptr), ptr->size);
+    }
+
+    /**
+     * Reserves room for one more string, the table keeps at least half of its slots empty which
+     * guarantees every probe sequence terminates
+     */
+    __UTL_HIDE_FROM_ABI inline void acquire_capacity() UTL_THROWS {
+        size_type const count = atomic_relaxed::fetch_add(&size_, size_type(1));
+        if (count >= capacity()) {
+            atomic_relaxed::fetch_sub(&size_, size_type(1));
+            UTL_THROW(length_error(
+                UTL_MESSAGE_FORMAT("[UTL] basic_concurrent_string_pool::intern operation failed, "
+                                   "Reason=[pool capacity exhausted], capacity=[%zu]"),
+                capacity()));
+        }
+    }
+
+    __UTL_HIDE_FROM_ABI inline entry* make_entry(view_type str, uint64_t hash) UTL_THROWS {
+        entry* const result = ::new (static_cast<void*>(arena_.allocate_concurrent(
+            details::string_pool::entry_units<value_type>(str.size())))) entry{hash, str.size()};
+        value_type* const dst = details::string_pool::characters<value_type>(result);
+        traits_type::copy(dst, str.data(), str.size());
+        traits_type::assign(dst[str.size()], value_type());
+        return result;
+    }
+
+    arena_type arena_;
+    slot_pointer slots_;
+    /**
+     * Number of slots in the lookup table, a power of two of at least twice the capacity
+     */
+    size_type slot_count_;
+    compressed_pair<size_type, allocator_type> storage_;
+    size_type size_;
+    size_type string_bytes_;
+};
+
+UTL_NAMESPACE_END
+
+#if !UTL_CXX17
+
+UTL_NAMESPACE_BEGIN
+
+namespace details {
+namespace string_pool {
+template <typename Alloc>
+__UTL_ABI_PUBLIC constexpr size_t arena<Alloc>::page_units;
+template <typename Alloc>
+__UTL_ABI_PUBLIC constexpr size_t arena<Alloc>::large_units;
+} // namespace string_pool
+} // namespace details
+
+template <typename CharType, typename Traits, typename Alloc>
+__UTL_ABI_PUBLIC constexpr size_t basic_string_pool<CharType, Traits, Alloc>::min_slots;
+
+UTL_NAMESPACE_END
+
+#endif
+
+#undef __UTL_ATTRIBUTE_STRING_POOL_PURE
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_STRING_POOL_PURE
+#undef __UTL_ATTRIBUTE_STRING_POOL_CONST
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_STRING_POOL_CONST
@@ -0,0 +1,258 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/string/utl_string_fwd.h"
+
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/string/utl_basic_string_view.h"
+#include "utl/string/utl_libc.h"
+#include "utl/string/utl_string_details.h"
+#include "utl/type_traits/utl_constants.h"
+#include "utl/type_traits/utl_is_same.h"
+
+#define __UTL_ATTRIBUTE_SEARCHER_PURE (PURE)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_SEARCHER_PURE
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Precompiled substring searcher
+ *
+ * Derives everything needed to locate a needle (the Two-Way critical factorization and a
+ * bad-character shift table) once on construction so the same needle can be searched for in any
+ * number of haystacks without repeating the preprocessing.
+ *
+ * The searcher does not own the needle, the needle must outlive the searcher.
+ */
+template <typename CharType, typename Traits>
+class __UTL_PUBLIC_TEMPLATE basic_string_searcher {
+public:
+    using value_type = CharType;
+    using traits_type = Traits;
+    using size_type = size_t;
+    using const_pointer = CharType const*;
+    using view_type = basic_string_view<CharType, Traits>;
+
+    __UTL_PUBLIC_TEMPLATE_DATA static constexpr size_type npos = details::string::npos;
+
+    __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 basic_string_searcher(
+        const_pointer needle, size_type count) noexcept
+        : needle_(needle)
+        , size_(count)
+        , suffix_(0)
+        , period_(1)
+        , periodic_(false)
+        , shift_{} {
+        initialize();
+    }
+
+    __UTL_HIDE_FROM_ABI explicit inline UTL_CONSTEXPR_CXX14 basic_string_searcher(
+        view_type needle) noexcept
+        : basic_string_searcher(needle.data(), needle.size()) {}
+
+    __UTL_HIDE_FROM_ABI explicit inline UTL_CONSTEXPR_CXX14 basic_string_searcher(
+        const_pointer needle) noexcept
+        : basic_string_searcher(needle, traits_type::length(needle)) {}
+
+    __UTL_HIDE_FROM_ABI inline constexpr basic_string_searcher(
+        basic_string_searcher const&) noexcept = default;
+    __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 basic_string_searcher& operator=(
+        basic_string_searcher const&) noexcept = default;
+
+    UTL_ATTRIBUTE(SEARCHER_PURE) inline constexpr view_type needle() const noexcept {
+        return view_type(needle_, size_);
+    }
+
+    UTL_ATTRIBUTE(SEARCHER_PURE) inline constexpr size_type size() const noexcept { return size_; }
+
+    /**
+     * @return index of the first match at or after `pos`, or `npos`
+     */
+    UTL_ATTRIBUTE(SEARCHER_PURE) inline UTL_CONSTEXPR_CXX14 size_type find(
+        view_type haystack, size_type pos = 0) const noexcept {
+        return pos > haystack.size()
+            ? npos
+            : details::string::to_index(
+                  haystack.data(), search(haystack.data() + pos, haystack.size() - pos));
+    }
+
+    /**
+     * @return pointer to the first match in the range `[haystack, haystack + count)`, or nullptr
+     */
+    UTL_ATTRIBUTE(SEARCHER_PURE) inline UTL_CONSTEXPR_CXX14 const_pointer search(
+        const_pointer haystack, size_type count) const noexcept {
+        return count < size_   ? nullptr
+            : size_ == 0       ? haystack
+            : UTL_CONSTANT_P(haystack == needle_) ? two_way(haystack, count)
+                                                  : search(haystack, count, is_default_traits{});
+    }
+
+private:
+    using is_default_traits UTL_NODEBUG =
+        bool_constant<UTL_TRAIT_is_same(traits_type, char_traits<value_type>)>;
+
+    /**
+     * Needles up to this length are searched with the vectorized first/last element filter which
+     * outperforms the shift table on short needles
+     */
+    static constexpr size_type vectorized_limit = 32;
+    static constexpr size_type shift_limit = UCHAR_MAX;
+
+    UTL_ATTRIBUTE(SEARCHER_PURE) inline const_pointer search(
+        const_pointer haystack, size_type count, true_type) const noexcept {
+        return size_ <= vectorized_limit
+            ? libc::runtime::vectorized::memmem(haystack, libc::element_count_t(count), needle_,
+                  libc::element_count_t(size_))
+            : two_way(haystack, count);
+    }
+
+    UTL_ATTRIBUTE(SEARCHER_PURE) inline const_pointer search(
+        const_pointer haystack, size_type count, false_type) const noexcept {
+        return two_way(haystack, count);
+    }
+
+    UTL_ATTRIBUTE(SEARCHER_PURE) static inline constexpr unsigned char bucket(
+        value_type ch) noexcept {
+        return static_cast<unsigned char>(ch);
+    }
+
+    __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 size_type maximal_suffix(
+        bool invert, size_type& period) const noexcept {
+        size_type suffix = npos;
+        size_type j = 0;
+        size_type k = 1;
+        size_type p = 1;
+        while (j + k < size_) {
+            value_type const a = needle_[j + k];
+            value_type const b = needle_[suffix + k];
+            if (invert ? traits_type::lt(b, a) : traits_type::lt(a, b)) {
+                j += k;
+                k = 1;
+                p = j - suffix;
+            } else if (traits_type::eq(a, b)) {
+                if (k != p) {
+                    ++k;
+                } else {
+                    j += p;
+                    k = 1;
+                }
+            } else {
+                suffix = j++;
+                k = p = 1;
+            }
+        }
+
+        period = p;
+        return suffix + 1;
+    }
+
+    __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 bool is_periodic() const noexcept {
+        for (size_type i = 0; i < suffix_; ++i) {
+            if (!traits_type::eq(needle_[i], needle_[i + period_])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 void initialize() noexcept {
+        if (size_ == 0) {
+            return;
+        }
+
+        size_type forward_period = 1;
+        size_type reverse_period = 1;
+        size_type const forward = maximal_suffix(false, forward_period);
+        size_type const reverse = maximal_suffix(true, reverse_period);
+        // The critical factorization is given by the longer of the two maximal suffixes
+        suffix_ = reverse < forward ? forward : reverse;
+        period_ = reverse < forward ? forward_period : reverse_period;
+        periodic_ = is_periodic();
+        if (!periodic_) {
+            period_ = __UTL numeric::max(suffix_, size_ - suffix_) + 1;
+        }
+
+        // The shift table is keyed on the low byte of each element which is only sound if
+        // equality implies bitwise equality, otherwise every alignment is checked
+        if (is_default_traits::value) {
+            auto const initial = static_cast<unsigned char>(__UTL numeric::min(size_, shift_limit));
+            for (auto& shift : shift_) {
+                shift = initial;
+            }
+
+            for (size_type i = 0; i < size_; ++i) {
+                shift_[bucket(needle_[i])] =
+                    static_cast<unsigned char>(__UTL numeric::min(size_ - 1 - i, shift_limit));
+            }
+        }
+    }
+
+    UTL_ATTRIBUTE(SEARCHER_PURE) inline UTL_CONSTEXPR_CXX14 const_pointer two_way(
+        const_pointer haystack, size_type count) const noexcept {
+        size_type j = 0;
+        size_type memory = 0;
+        while (j <= count - size_) {
+            size_type const shift = shift_[bucket(haystack[j + size_ - 1])];
+            if (shift) {
+                j += shift;
+                memory = 0;
+                continue;
+            }
+
+            size_type i = __UTL numeric::max(suffix_, memory);
+            while (i < size_ && traits_type::eq(needle_[i], haystack[i + j])) {
+                ++i;
+            }
+
+            if (i < size_) {
+                j += i - suffix_ + 1;
+                memory = 0;
+                continue;
+            }
+
+            i = suffix_;
+            while (memory < i && traits_type::eq(needle_[i - 1], haystack[i - 1 + j])) {
+                --i;
+            }
+
+            if (i <= memory) {
+                return haystack + j;
+            }
+
+            j += period_;
+            // The left half of a periodic needle is repeated, remember how much has been matched
+            memory = periodic_ ? size_ - period_ : 0;
+        }
+
+        return nullptr;
+    }
+
+    const_pointer needle_;
+    size_type size_;
+    size_type suffix_;
+    size_type period_;
+    bool periodic_;
+    unsigned char shift_[UCHAR_MAX + 1];
+};
+
+UTL_NAMESPACE_END
+
+#if !UTL_CXX17
+
+UTL_NAMESPACE_BEGIN
+
+template <typename CharType, typename Traits>
+__UTL_ABI_PUBLIC constexpr typename basic_string_searcher<CharType, Traits>::size_type
+    basic_string_searcher<CharType, Traits>::npos;
+
+UTL_NAMESPACE_END
+
+#endif
+
+#undef __UTL_ATTRIBUTE_SEARCHER_PURE
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_SEARCHER_PURE
@@ -24,6 +24,7 @@
 #include "utl/numeric/utl_add_sat.h"
 #include "utl/numeric/utl_max.h"
 #include "utl/numeric/utl_min.h"
+#include "utl/string/utl_basic_string_searcher.h"
 #include "utl/string/utl_literal_sequence.h"
 #include "utl/string/utl_split.h"
 #include "utl/string/utl_string_details.h"
@@ -264,6 +265,11 @@ public:
         return find(other) != npos;
     }
 
+    UTL_ATTRIBUTE(STRING_PURE) inline UTL_CONSTEXPR_CXX14 bool contains(
+        basic_string_searcher<CharType, Traits> const& searcher) const noexcept {
+        return find(searcher) != npos;
+    }
+
     UTL_ATTRIBUTE(STRING_PURE) inline constexpr size_type find(
         basic_string_view other, size_type pos = 0) const noexcept {
         return find(other.data(), pos, other.size());
@@ -286,6 +292,12 @@ public:
         return find(str, pos, traits_type::length(str));
     }
 
+    UTL_ATTRIBUTE(STRING_PURE) inline UTL_CONSTEXPR_CXX14 size_type find(
+        basic_string_searcher<CharType, Traits> const& searcher,
+        size_type pos = 0) const noexcept {
+        return searcher.find(*this, pos);
+    }
+
     UTL_ATTRIBUTE(STRING_PURE) inline constexpr size_type rfind(
         basic_string_view other, size_type pos = npos) const noexcept {
         return rfind(other.data(), pos, other.size());
@@ -442,6 +454,17 @@ public:
                   str, basic_string_view(delimiter), __UTL move(callable));
     }
 
+    template <UTL_CONCEPT_CXX20(invocable<basic_string_view>) F>
+    __UTL_HIDE_FROM_ABI friend inline constexpr UTL_ENABLE_IF_CXX11(
+        size_type, UTL_TRAIT_is_invocable(F, basic_string_view))
+    split_all(basic_string_view str, basic_string_searcher<CharType, Traits> const& delimiter,
+        F callable) noexcept {
+        return UTL_CONSTANT_P(
+                   string_utils::compile_time::split_all(str, delimiter, __UTL move(callable)))
+            ? string_utils::compile_time::split_all(str, delimiter, __UTL move(callable))
+            : string_utils::runtime::split_all(str, delimiter, __UTL move(callable));
+    }
+
     template <UTL_CONCEPT_CXX20(convertible_to<basic_string_view>) ViewLike,
         UTL_CONCEPT_CXX20(predicate<basic_string_view>) F>
     __UTL_HIDE_FROM_ABI friend inline constexpr UTL_ENABLE_IF_CXX11(size_type,
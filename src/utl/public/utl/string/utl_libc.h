@@ -70,6 +70,14 @@ UTL_ATTRIBUTE(LIBC_PURE) inline constexpr T* memchr(T const* str, U value, size_
         : runtime::memchr(str, value, bytes);
 }
 
+template <UTL_CONCEPT_CXX20(string_char) T UTL_CONSTRAINT_CXX11(is_string_char<T>::value)>
+UTL_ATTRIBUTE(LIBC_PURE) inline constexpr T* memchr(
+    T const* str, T const value, element_count_t count) noexcept {
+    return UTL_CONSTANT_P(compile_time::memchr(str, value, count))
+        ? compile_time::memchr(str, value, count)
+        : runtime::memchr(str, value, count);
+}
+
 template <UTL_CONCEPT_CXX20(trivially_copyable) T UTL_CONSTRAINT_CXX11(
     is_trivially_copyable<T>::value && exact_size<T, 1>::value)>
 UTL_CONSTRAINT_CXX20(exact_size<T, 1>)
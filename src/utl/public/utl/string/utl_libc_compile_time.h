@@ -64,6 +64,14 @@ __UTL_HIDE_FROM_ABI inline constexpr T* memchr(T const* str, U value, size_t byt
                         : __UTL libc::compile_time::recursive::memchr(str + 1, value, bytes - 1);
 }
 
+template <typename T>
+__UTL_HIDE_FROM_ABI inline constexpr T* memchr(
+    T const* str, T const value, element_count_t count) noexcept {
+    return count == 0   ? nullptr
+        : *str == value ? const_cast<T*>(str)
+                        : __UTL libc::compile_time::recursive::memchr(str + 1, value, count - 1);
+}
+
 template <typename T>
 __UTL_HIDE_FROM_ABI inline constexpr size_t strlen(T const* str, size_t r = 0) noexcept {
     return !*str ? r : strlen(str + 1, r + 1);
@@ -156,6 +164,12 @@ __UTL_HIDE_FROM_ABI inline constexpr T* memchr(T const* str, U value, size_t byt
     return recursive::memchr(str, as_byte(value), bytes);
 }
 
+template <UTL_CONCEPT_CXX20(string_char) T UTL_CONSTRAINT_CXX11(is_string_char<T>::value)>
+__UTL_HIDE_FROM_ABI inline constexpr T* memchr(
+    T const* str, T const value, element_count_t count) noexcept {
+    return recursive::memchr(str, value, count);
+}
+
 __UTL_HIDE_FROM_ABI inline constexpr size_t strlen(char const* str) noexcept {
     return recursive::strlen(str);
 }
@@ -5,6 +5,7 @@
 #include "utl/utl_config.h"
 
 #include "utl/string/utl_libc_common.h"
+#include "utl/string/utl_libc_vectorized.h"
 #include "utl/utility/utl_signs.h"
 
 UTL_NAMESPACE_BEGIN
@@ -61,6 +62,11 @@ UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline T* memchr(T const* ptr, U value, size_t
 #endif
 }
 
+template <UTL_CONCEPT_CXX20(string_char) T UTL_CONSTRAINT_CXX11(is_string_char<T>::value)>
+UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline T* memchr(T const* ptr, T const value, element_count_t count) noexcept {
+    return vectorized::memchr(ptr, value, count);
+}
+
 template <typename T, typename U>
 UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline int memcmp(T const* lhs, U const* rhs, element_count_t count) noexcept {
     static_assert(is_trivially_lexicographically_comparable<T, U>::value,
@@ -89,14 +95,8 @@ UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline size_t strlen(wchar_t const* str) noexce
 }
 
 template <UTL_CONCEPT_CXX20(string_char) T UTL_CONSTRAINT_CXX11(is_string_char<T>::value)>
-UTL_ATTRIBUTES(LIBC_PURE) inline size_t strlen(T const* str) noexcept {
-    size_t count = 0;
-    while (*str) {
-        ++str;
-        ++count;
-    }
-
-    return count;
+UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline size_t strlen(T const* str) noexcept {
+    return vectorized::strlen(str);
 }
 
 UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline char* strchr(char const* str, char const ch) noexcept {
@@ -116,21 +116,8 @@ UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline wchar_t* strchr(wchar_t const* str, wcha
 }
 
 template <UTL_CONCEPT_CXX20(string_char) T UTL_CONSTRAINT_CXX11(is_string_char<T>::value)>
-UTL_ATTRIBUTES(LIBC_PURE) inline T* strnchr(T const* str, T const ch, element_count_t count) noexcept {
-    size_t len = size_t(count);
-    while (len) {
-        if (*str == ch) {
-            return const_cast<T*>(str);
-        }
-        if (!*str) {
-            return nullptr;
-        }
-
-        ++str;
-        --len;
-    }
-
-    return nullptr;
+UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline T* strnchr(T const* str, T const ch, element_count_t count) noexcept {
+    return vectorized::strnchr(str, ch, count);
 }
 
 template <UTL_CONCEPT_CXX20(string_char) T UTL_CONSTRAINT_CXX11(is_string_char<T>::value)>
@@ -198,47 +185,13 @@ UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline int strncmp(
 }
 
 template <UTL_CONCEPT_CXX20(string_char) T UTL_CONSTRAINT_CXX11(is_string_char<T>::value)>
-UTL_ATTRIBUTES(LIBC_PURE) inline int strncmp(T const* left, T const* right, element_count_t elements) noexcept {
-    size_t len = (size_t)elements;
-    while (len && *left == *right) {
-        if (!*left) {
-            return 0;
-        }
-
-        ++left;
-        ++right;
-        --len;
-    }
-
-    return (len == 0) ? 0 : (*left < *right) ? -1 : 1;
+UTL_ATTRIBUTES(LIBC_INLINE_PURE) inline int strncmp(T const* left, T const* right, element_count_t elements) noexcept {
+    return vectorized::strncmp(left, right, elements);
 }
 
-#if UTL_COMPILER_MSVC
-#  pragma intrinsic(memcpy)
-#endif
-
 template <UTL_CONCEPT_CXX20(string_char) T UTL_CONSTRAINT_CXX11(is_string_char<T>::value)>
-UTL_ATTRIBUTES(LIBC_PURE) inline T* strnset(T* dst, T const val, element_count_t elements) noexcept {
-    size_t len = (size_t)elements;
-    if (!len) {
-        return dst;
-    }
-
-    static constexpr size_t buffer_count = 16 / sizeof(T);
-    alignas(16) T buffer[buffer_count];
-    for (auto& e : buffer) {
-        e = val;
-    }
-
-    T* ptr = dst;
-    do {
-        size_t const copy_size = len < buffer_count ? len : buffer_count;
-        ::memcpy(ptr, buffer, byte_count<T>(static_cast<element_count_t>(copy_size)));
-        len -= copy_size;
-        ptr += copy_size;
-    } while (len);
-
-    return dst;
+UTL_ATTRIBUTES(ALWAYS_INLINE, _HIDE_FROM_ABI) inline T* strnset(T* dst, T const val, element_count_t elements) noexcept {
+    return vectorized::strnset(dst, val, elements);
 }
 } // namespace standard
 
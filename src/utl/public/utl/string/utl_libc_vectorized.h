@@ -0,0 +1,230 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/string/utl_libc_common.h"
+
+UTL_NAMESPACE_BEGIN
+
+#define __UTL_ATTRIBUTE_LIBC_VECTORIZED (PURE)(NODISCARD) __UTL_ATTRIBUTE__ABI_PUBLIC
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_LIBC_VECTORIZED
+
+namespace libc {
+namespace runtime {
+/**
+ * Vectorized string kernels
+ *
+ * The kernel used is selected once on first use based on the capabilities of the executing CPU,
+ * i.e. SSE2/AVX2 on x86-64 and NEON on AArch64. The semantics of each function matches the
+ * corresponding function in `libc::runtime::standard`.
+ *
+ * Functions that scan for a null terminator may read past the terminator, but will never read
+ * across a page boundary that the string does not extend into.
+ */
+namespace vectorized {
+
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char* memchr(char const*, char, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) wchar_t* memchr(wchar_t const*, wchar_t, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char16_t* memchr(
+    char16_t const*, char16_t, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char32_t* memchr(
+    char32_t const*, char32_t, element_count_t) noexcept;
+
+UTL_ATTRIBUTE(LIBC_VECTORIZED) size_t strlen(char const*) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) size_t strlen(wchar_t const*) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) size_t strlen(char16_t const*) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) size_t strlen(char32_t const*) noexcept;
+
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char* strnchr(char const*, char, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) wchar_t* strnchr(wchar_t const*, wchar_t, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char16_t* strnchr(
+    char16_t const*, char16_t, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char32_t* strnchr(
+    char32_t const*, char32_t, element_count_t) noexcept;
+
+UTL_ATTRIBUTE(LIBC_VECTORIZED) int strncmp(char const*, char const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) int strncmp(
+    wchar_t const*, wchar_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) int strncmp(
+    char16_t const*, char16_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) int strncmp(
+    char32_t const*, char32_t const*, element_count_t) noexcept;
+
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char* memrchr(char const*, char, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) wchar_t* memrchr(wchar_t const*, wchar_t, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char16_t* memrchr(
+    char16_t const*, char16_t, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char32_t* memrchr(
+    char32_t const*, char32_t, element_count_t) noexcept;
+
+/**
+ * Finds the first occurrence of a needle within a haystack
+ *
+ * Short needles are located with a vectorized filter on their first and last element, longer
+ * needles use the Two-Way algorithm to guarantee linear time.
+ *
+ * @return pointer to the first match, the haystack if the needle is empty, or nullptr
+ */
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char* memmem(
+    char const*, element_count_t, char const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) wchar_t* memmem(
+    wchar_t const*, element_count_t, wchar_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char16_t* memmem(
+    char16_t const*, element_count_t, char16_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char32_t* memmem(
+    char32_t const*, element_count_t, char32_t const*, element_count_t) noexcept;
+
+/**
+ * Finds the last occurrence of a needle within a haystack
+ *
+ * @return pointer to the last match, the end of the haystack if the needle is empty, or nullptr
+ */
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char* memrmem(
+    char const*, element_count_t, char const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) wchar_t* memrmem(
+    wchar_t const*, element_count_t, wchar_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char16_t* memrmem(
+    char16_t const*, element_count_t, char16_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char32_t* memrmem(
+    char32_t const*, element_count_t, char32_t const*, element_count_t) noexcept;
+
+/**
+ * Finds the first element of a string that is one of a set of characters
+ *
+ * Builds a bitmap of the set once and classifies a full vector of elements per step with nibble
+ * table lookups.
+ *
+ * @return pointer to the first matching element, or nullptr
+ */
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char* find_first_of(
+    char const*, element_count_t, char const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) wchar_t* find_first_of(
+    wchar_t const*, element_count_t, wchar_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char16_t* find_first_of(
+    char16_t const*, element_count_t, char16_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char32_t* find_first_of(
+    char32_t const*, element_count_t, char32_t const*, element_count_t) noexcept;
+
+/**
+ * Finds the first element of a string that is not one of a set of characters
+ *
+ * @return pointer to the first non-matching element, or nullptr
+ */
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char* find_first_not_of(
+    char const*, element_count_t, char const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) wchar_t* find_first_not_of(
+    wchar_t const*, element_count_t, wchar_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char16_t* find_first_not_of(
+    char16_t const*, element_count_t, char16_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char32_t* find_first_not_of(
+    char32_t const*, element_count_t, char32_t const*, element_count_t) noexcept;
+
+/**
+ * Finds the last element of a string that is one of a set of characters
+ *
+ * @return pointer to the last matching element, or nullptr
+ */
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char* find_last_of(
+    char const*, element_count_t, char const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) wchar_t* find_last_of(
+    wchar_t const*, element_count_t, wchar_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char16_t* find_last_of(
+    char16_t const*, element_count_t, char16_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char32_t* find_last_of(
+    char32_t const*, element_count_t, char32_t const*, element_count_t) noexcept;
+
+/**
+ * Finds the last element of a string that is not one of a set of characters
+ *
+ * @return pointer to the last non-matching element, or nullptr
+ */
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char* find_last_not_of(
+    char const*, element_count_t, char const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) wchar_t* find_last_not_of(
+    wchar_t const*, element_count_t, wchar_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char16_t* find_last_not_of(
+    char16_t const*, element_count_t, char16_t const*, element_count_t) noexcept;
+UTL_ATTRIBUTE(LIBC_VECTORIZED) char32_t* find_last_not_of(
+    char32_t const*, element_count_t, char32_t const*, element_count_t) noexcept;
+
+__UTL_ABI_PUBLIC char* strnset(char*, char, element_count_t) noexcept;
+__UTL_ABI_PUBLIC wchar_t* strnset(wchar_t*, wchar_t, element_count_t) noexcept;
+__UTL_ABI_PUBLIC char16_t* strnset(char16_t*, char16_t, element_count_t) noexcept;
+__UTL_ABI_PUBLIC char32_t* strnset(char32_t*, char32_t, element_count_t) noexcept;
+
+#if UTL_SUPPORTS_CHAR8_T
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* memchr(
+    char8_t const* str, char8_t ch, element_count_t count) noexcept {
+    return (char8_t*)memchr((char const*)str, (char)ch, count);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline size_t strlen(
+    char8_t const* str) noexcept {
+    return strlen((char const*)str);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* strnchr(
+    char8_t const* str, char8_t ch, element_count_t count) noexcept {
+    return (char8_t*)strnchr((char const*)str, (char)ch, count);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline int strncmp(
+    char8_t const* left, char8_t const* right, element_count_t count) noexcept {
+    return strncmp((char const*)left, (char const*)right, count);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* memrchr(
+    char8_t const* str, char8_t ch, element_count_t count) noexcept {
+    return (char8_t*)memrchr((char const*)str, (char)ch, count);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* memmem(
+    char8_t const* haystack, element_count_t n, char8_t const* needle, element_count_t m) noexcept {
+    return (char8_t*)memmem((char const*)haystack, n, (char const*)needle, m);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* memrmem(
+    char8_t const* haystack, element_count_t n, char8_t const* needle, element_count_t m) noexcept {
+    return (char8_t*)memrmem((char const*)haystack, n, (char const*)needle, m);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* find_first_of(
+    char8_t const* str, element_count_t count, char8_t const* chars,
+    element_count_t chars_count) noexcept {
+    return (char8_t*)find_first_of((char const*)str, count, (char const*)chars, chars_count);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* find_first_not_of(
+    char8_t const* str, element_count_t count, char8_t const* chars,
+    element_count_t chars_count) noexcept {
+    return (char8_t*)find_first_not_of((char const*)str, count, (char const*)chars, chars_count);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* find_last_of(
+    char8_t const* str, element_count_t count, char8_t const* chars,
+    element_count_t chars_count) noexcept {
+    return (char8_t*)find_last_of((char const*)str, count, (char const*)chars, chars_count);
+}
+
+UTL_ATTRIBUTES(PURE, NODISCARD, ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* find_last_not_of(
+    char8_t const* str, element_count_t count, char8_t const* chars,
+    element_count_t chars_count) noexcept {
+    return (char8_t*)find_last_not_of((char const*)str, count, (char const*)chars, chars_count);
+}
+
+UTL_ATTRIBUTES(ALWAYS_INLINE, _HIDE_FROM_ABI) inline char8_t* strnset(
+    char8_t* dst, char8_t ch, element_count_t count) noexcept {
+    return (char8_t*)strnset((char*)dst, (char)ch, count);
+}
+#endif
+
+} // namespace vectorized
+} // namespace runtime
+} // namespace libc
+
+#undef __UTL_ATTRIBUTE_LIBC_VECTORIZED
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_LIBC_VECTORIZED
+
+UTL_NAMESPACE_END
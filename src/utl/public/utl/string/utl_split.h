@@ -7,6 +7,7 @@
 #include "utl/string/utl_string_fwd.h"
 
 #include "utl/numeric/utl_add_sat.h"
+#include "utl/string/utl_basic_string_searcher.h"
 #include "utl/utility/utl_forward.h"
 #include "utl/utility/utl_move.h"
 
@@ -22,6 +23,7 @@ template <typename CharType, typename Traits>
 struct split_all_impl {
 private:
     using view_type = basic_string_view<CharType, Traits>;
+    using searcher_type = basic_string_searcher<CharType, Traits>;
 
     template <typename F>
     __UTL_HIDE_FROM_ABI static inline constexpr size_t split2(
@@ -65,12 +67,38 @@ private:
         return split1(str, delimiter, __UTL forward<F>(process), count, str.find(delimiter));
     }
 
+    template <typename F>
+    __UTL_HIDE_FROM_ABI static inline constexpr size_t split2(view_type str,
+        searcher_type const& delimiter, F&& process, size_t count, size_t idx) noexcept {
+        return str.empty() ? count + 1
+                           : split(str, delimiter, __UTL forward<F>(process), count + 1);
+    }
+
+    template <typename F>
+    __UTL_HIDE_FROM_ABI static inline constexpr size_t split1(view_type str,
+        searcher_type const& delimiter, F&& process, size_t count, size_t idx) noexcept {
+        return process(str.substr(0, idx)),
+               split2(remove_prefix(str, __UTL add_sat(idx, delimiter.size())), delimiter,
+                   __UTL forward<F>(process), count, idx);
+    }
+
+    template <typename F>
+    __UTL_HIDE_FROM_ABI static inline constexpr size_t split(
+        view_type str, searcher_type const& delimiter, F&& process, size_t count = 0) noexcept {
+        return split1(str, delimiter, __UTL forward<F>(process), count, delimiter.find(str));
+    }
+
 public:
     template <typename F>
     __UTL_HIDE_FROM_ABI inline constexpr explicit split_all_impl(
         view_type str, view_type delimiter, F&& process) noexcept
         : count(split(str, delimiter, __UTL forward<F>(process))) {}
 
+    template <typename F>
+    __UTL_HIDE_FROM_ABI inline constexpr explicit split_all_impl(
+        view_type str, searcher_type const& delimiter, F&& process) noexcept
+        : count(split(str, delimiter, __UTL forward<F>(process))) {}
+
     template <typename F>
     __UTL_HIDE_FROM_ABI inline constexpr explicit split_all_impl(
         view_type str, CharType delimiter, F&& process) noexcept
@@ -91,6 +119,12 @@ __UTL_HIDE_FROM_ABI inline constexpr size_t split_all(
     return split_all_impl<CharType, Traits>(str, delimiter, __UTL forward<F>(process)).count;
 }
 
+template <typename CharType, typename Traits, typename F>
+__UTL_HIDE_FROM_ABI inline constexpr size_t split_all(basic_string_view<CharType, Traits> str,
+    basic_string_searcher<CharType, Traits> const& delimiter, F&& process) {
+    return split_all_impl<CharType, Traits>(str, delimiter, __UTL forward<F>(process)).count;
+}
+
 template <typename CharType, typename Traits>
 struct split_while_impl {
 private:
@@ -183,6 +217,20 @@ __UTL_HIDE_FROM_ABI inline size_t split_all(basic_string_view<CharType, Traits>
     return count;
 }
 
+template <typename CharType, typename Traits, typename F>
+__UTL_HIDE_FROM_ABI inline size_t split_all(basic_string_view<CharType, Traits> str,
+    basic_string_searcher<CharType, Traits> const& delimiter, F&& predicate) {
+    size_t count = 0;
+    do {
+        auto idx = delimiter.find(str);
+        predicate(str.substr(0, idx));
+        str = remove_prefix(str, __UTL add_sat(idx, delimiter.size()));
+        ++count;
+    } while (!str.empty());
+
+    return count;
+}
+
 template <typename CharType, typename Traits, typename F>
 __UTL_HIDE_FROM_ABI inline size_t split_while(basic_string_view<CharType, Traits> str,
     basic_string_view<CharType, Traits> delimiter, F&& predicate) {
@@ -0,0 +1,268 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/string/utl_string_fwd.h"
+
+#include "utl/iterator/utl_iterator_tags.h"
+#include "utl/memory/utl_addressof.h"
+#include "utl/string/utl_basic_string_searcher.h"
+#include "utl/string/utl_basic_string_view.h"
+#include "utl/type_traits/utl_type_identity.h"
+
+#define __UTL_ATTRIBUTE_SPLIT_PURE (PURE)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_SPLIT_PURE
+
+UTL_NAMESPACE_BEGIN
+
+namespace string_utils {
+
+enum class empty_fields : bool {
+    keep,
+    skip
+};
+
+/**
+ * Delimiters used by `basic_split_view`
+ *
+ * `find` returns the index of the next delimiter within the string or `npos`, and `size` the
+ * number of characters a matched delimiter occupies
+ */
+template <typename CharType, typename Traits>
+class __UTL_PUBLIC_TEMPLATE char_delimiter {
+public:
+    using view_type = basic_string_view<CharType, Traits>;
+
+    __UTL_HIDE_FROM_ABI explicit inline constexpr char_delimiter(CharType value) noexcept
+        : value_(value) {}
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr size_t find(view_type str) const noexcept {
+        return str.find(value_);
+    }
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr size_t size() const noexcept { return 1; }
+
+private:
+    CharType value_;
+};
+
+template <typename CharType, typename Traits>
+class __UTL_PUBLIC_TEMPLATE substring_delimiter {
+public:
+    using view_type = basic_string_view<CharType, Traits>;
+    using searcher_type = basic_string_searcher<CharType, Traits>;
+
+    __UTL_HIDE_FROM_ABI explicit inline UTL_CONSTEXPR_CXX14 substring_delimiter(
+        view_type value) noexcept
+        : searcher_(value) {}
+
+    __UTL_HIDE_FROM_ABI explicit inline constexpr substring_delimiter(
+        searcher_type const& searcher) noexcept
+        : searcher_(searcher) {}
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline UTL_CONSTEXPR_CXX14 size_t find(view_type str) const noexcept {
+        return searcher_.find(str);
+    }
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr size_t size() const noexcept {
+        return searcher_.size();
+    }
+
+private:
+    searcher_type searcher_;
+};
+
+template <typename CharType, typename Traits>
+class __UTL_PUBLIC_TEMPLATE any_of_delimiter {
+public:
+    using view_type = basic_string_view<CharType, Traits>;
+
+    __UTL_HIDE_FROM_ABI explicit inline constexpr any_of_delimiter(view_type chars) noexcept
+        : chars_(chars) {}
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr size_t find(view_type str) const noexcept {
+        return str.find_first_of(chars_);
+    }
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr size_t size() const noexcept { return 1; }
+
+private:
+    view_type chars_;
+};
+
+} // namespace string_utils
+
+/**
+ * Lazily splits a string into the fields separated by a delimiter
+ *
+ * Fields are produced one at a time as the view is iterated, which allows the caller to stop at
+ * any point and uses constant stack space regardless of the number of fields. The fields match
+ * those passed to `split_all`: an empty string has a single empty field and a trailing delimiter
+ * does not produce an empty field. Empty fields may optionally be skipped.
+ *
+ * The delimiter is stored in the view, its iterators refer to it and must not outlive the view.
+ */
+template <typename CharType, typename Traits, typename Delimiter>
+class __UTL_PUBLIC_TEMPLATE basic_split_view {
+public:
+    using view_type = basic_string_view<CharType, Traits>;
+    using delimiter_type = Delimiter;
+    using size_type = size_t;
+    class iterator;
+    using const_iterator = iterator;
+
+    __UTL_HIDE_FROM_ABI inline constexpr basic_split_view(view_type str,
+        delimiter_type const& delim,
+        string_utils::empty_fields mode = string_utils::empty_fields::keep) noexcept
+        : str_(str)
+        , delimiter_(delim)
+        , skip_empty_(mode == string_utils::empty_fields::skip) {}
+
+    class __UTL_ABI_PUBLIC iterator {
+    public:
+        using value_type = view_type;
+        using difference_type = decltype((CharType*)0 - (CharType*)0);
+        using pointer = view_type const*;
+        using reference = view_type const&;
+        using iterator_category = __UTL forward_iterator_tag;
+        using iterator_concept = __UTL forward_iterator_tag;
+
+        __UTL_HIDE_FROM_ABI inline constexpr iterator() noexcept = default;
+
+        UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr view_type const& operator*() const noexcept {
+            return field_;
+        }
+
+        UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr view_type const* operator->() const noexcept {
+            return __UTL addressof(field_);
+        }
+
+        __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 iterator& operator++() noexcept {
+            do {
+                advance();
+            } while (parent_ != nullptr && parent_->skip_empty_ && field_.empty());
+
+            return *this;
+        }
+
+        __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 iterator operator++(int) noexcept {
+            auto prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        UTL_ATTRIBUTE(SPLIT_PURE) friend inline constexpr bool operator==(
+            iterator const& left, iterator const& right) noexcept {
+            return left.parent_ == right.parent_ && left.field_.data() == right.field_.data() &&
+                left.field_.size() == right.field_.size();
+        }
+
+        UTL_ATTRIBUTE(SPLIT_PURE) friend inline constexpr bool operator!=(
+            iterator const& left, iterator const& right) noexcept {
+            return !(left == right);
+        }
+
+    private:
+        friend basic_split_view;
+
+        __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 iterator(
+            basic_split_view const& parent) noexcept
+            : parent_(__UTL addressof(parent))
+            , rest_(parent.str_) {
+            next();
+            if (parent_->skip_empty_ && field_.empty()) {
+                ++*this;
+            }
+        }
+
+        __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 void next() noexcept {
+            // An empty delimiter never matches, otherwise it would produce empty fields forever
+            size_type const length = parent_->delimiter_.size();
+            size_type const idx = length ? parent_->delimiter_.find(rest_) : view_type::npos;
+            field_ = view_type(rest_.data(), idx == view_type::npos ? rest_.size() : idx);
+            last_ = idx == view_type::npos || idx + length >= rest_.size();
+            if (!last_) {
+                rest_ = rest_.substr(idx + length);
+            }
+        }
+
+        __UTL_HIDE_FROM_ABI inline UTL_CONSTEXPR_CXX14 void advance() noexcept {
+            if (last_) {
+                *this = iterator();
+            } else {
+                next();
+            }
+        }
+
+        basic_split_view const* parent_ = nullptr;
+        view_type rest_;
+        view_type field_;
+        bool last_ = true;
+    };
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline UTL_CONSTEXPR_CXX14 iterator begin() const noexcept
+        UTL_LIFETIMEBOUND {
+        return iterator(*this);
+    }
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr iterator end() const noexcept UTL_LIFETIMEBOUND {
+        return iterator();
+    }
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr view_type base() const noexcept { return str_; }
+
+    UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr delimiter_type const& delimiter() const noexcept
+        UTL_LIFETIMEBOUND {
+        return delimiter_;
+    }
+
+private:
+    view_type str_;
+    delimiter_type delimiter_;
+    bool skip_empty_;
+};
+
+template <typename CharType, typename Traits>
+UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr basic_split_view<CharType, Traits,
+    string_utils::char_delimiter<CharType, Traits>>
+split(basic_string_view<CharType, Traits> str, type_identity_t<CharType> delimiter,
+    string_utils::empty_fields mode = string_utils::empty_fields::keep) noexcept {
+    return {str, string_utils::char_delimiter<CharType, Traits>(delimiter), mode};
+}
+
+template <typename CharType, typename Traits>
+UTL_ATTRIBUTE(SPLIT_PURE) inline UTL_CONSTEXPR_CXX14 basic_split_view<CharType, Traits,
+    string_utils::substring_delimiter<CharType, Traits>>
+split(basic_string_view<CharType, Traits> str,
+    type_identity_t<basic_string_view<CharType, Traits>> delimiter,
+    string_utils::empty_fields mode = string_utils::empty_fields::keep) noexcept {
+    return {str, string_utils::substring_delimiter<CharType, Traits>(delimiter), mode};
+}
+
+template <typename CharType, typename Traits>
+UTL_ATTRIBUTE(SPLIT_PURE) inline UTL_CONSTEXPR_CXX14 basic_split_view<CharType, Traits,
+    string_utils::substring_delimiter<CharType, Traits>>
+split(basic_string_view<CharType, Traits> str,
+    basic_string_searcher<CharType, Traits> const& delimiter,
+    string_utils::empty_fields mode = string_utils::empty_fields::keep) noexcept {
+    return {str, string_utils::substring_delimiter<CharType, Traits>(delimiter), mode};
+}
+
+/**
+ * Splits on any one of a set of characters
+ */
+template <typename CharType, typename Traits>
+UTL_ATTRIBUTE(SPLIT_PURE) inline constexpr basic_split_view<CharType, Traits,
+    string_utils::any_of_delimiter<CharType, Traits>>
+split_any_of(basic_string_view<CharType, Traits> str,
+    type_identity_t<basic_string_view<CharType, Traits>> chars,
+    string_utils::empty_fields mode = string_utils::empty_fields::keep) noexcept {
+    return {str, string_utils::any_of_delimiter<CharType, Traits>(chars), mode};
+}
+
+UTL_NAMESPACE_END
+
+#undef __UTL_ATTRIBUTE_SPLIT_PURE
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_SPLIT_PURE
@@ -10,6 +10,8 @@
 #include "utl/numeric/utl_sub_sat.h"
 #include "utl/string/utl_char_traits.h"
 #include "utl/string/utl_libc.h"
+#include "utl/type_traits/utl_constants.h"
+#include "utl/type_traits/utl_is_same.h"
 
 UTL_NAMESPACE_BEGIN
 
@@ -167,7 +169,7 @@ public:
 
     __UTL_HIDE_FROM_ABI inline constexpr const_pointer find_for(
         const_pointer str, size_type len) const noexcept {
-        return len_ == 0 ? str : find_for_impl(str, len);
+        return len_ == 0 ? str + len : len < len_ ? nullptr : find_for_impl(str, len);
     }
 
 private:
@@ -188,7 +190,7 @@ private:
 
     __UTL_HIDE_FROM_ABI inline constexpr const_pointer find_for_impl_tail(
         const_pointer str, size_type len, const_pointer found, const_pointer begin) const noexcept {
-        return compare_with(begin) ? begin : find_for_impl(str, found - str);
+        return compare_with(begin) ? begin : find_for(str, found - str);
     }
 
     __UTL_HIDE_FROM_ABI inline constexpr const_pointer find_back(
@@ -229,20 +231,40 @@ UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) constexpr CharType const* rsearch_subs
 } // namespace compile_time
 
 namespace runtime {
+/**
+ * The vectorized kernels compare elements bitwise, which is only equivalent to the traits'
+ * comparison for the default traits
+ */
+template <typename Traits, typename T>
+using is_default_traits = bool_constant<UTL_TRAIT_is_same(Traits, char_traits<T>)>;
+
 template <typename T>
-UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* rfind_char(T const* str, T const ch, size_t len) noexcept {
-    for (auto p = str + len - 1; p >= str; --p) {
-        if (*p == ch) {
-            return const_cast<T*>(str);
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* rfind_char(
+    T const* str, T const ch, size_t len, false_type) noexcept {
+    for (auto p = str + len; p != str;) {
+        if (*--p == ch) {
+            return p;
         }
     }
 
     return nullptr;
 }
 
+template <typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* rfind_char(
+    T const* str, T const ch, size_t len, true_type) noexcept {
+    return __UTL libc::runtime::vectorized::memrchr(str, ch, libc::element_count_t(len));
+}
+
+template <typename Traits, typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* rfind_char(
+    T const* str, T const ch, size_t len) noexcept {
+    return rfind_char(str, ch, len, is_default_traits<Traits, T>{});
+}
+
 template <typename Traits, typename T>
 UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_first_of(
-    T const* str, size_t len, T const* chars, size_t chars_count) noexcept {
+    T const* str, size_t len, T const* chars, size_t chars_count, false_type) noexcept {
     while (len) {
         if (Traits::find(chars, chars_count, *str) != nullptr) {
             return str;
@@ -256,8 +278,21 @@ UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_first_of(
 }
 
 template <typename Traits, typename T>
-UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_first_not_of(
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_first_of(
+    T const* str, size_t len, T const* chars, size_t chars_count, true_type) noexcept {
+    return __UTL libc::runtime::vectorized::find_first_of(
+        str, libc::element_count_t(len), chars, libc::element_count_t(chars_count));
+}
+
+template <typename Traits, typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_first_of(
     T const* str, size_t len, T const* chars, size_t chars_count) noexcept {
+    return find_first_of<Traits>(str, len, chars, chars_count, is_default_traits<Traits, T>{});
+}
+
+template <typename Traits, typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_first_not_of(
+    T const* str, size_t len, T const* chars, size_t chars_count, false_type) noexcept {
     while (len) {
         if (Traits::find(chars, chars_count, *str) == nullptr) {
             return str;
@@ -270,9 +305,22 @@ UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_first_not_of(
     return nullptr;
 }
 
+template <typename Traits, typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_first_not_of(
+    T const* str, size_t len, T const* chars, size_t chars_count, true_type) noexcept {
+    return __UTL libc::runtime::vectorized::find_first_not_of(
+        str, libc::element_count_t(len), chars, libc::element_count_t(chars_count));
+}
+
+template <typename Traits, typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_first_not_of(
+    T const* str, size_t len, T const* chars, size_t chars_count) noexcept {
+    return find_first_not_of<Traits>(str, len, chars, chars_count, is_default_traits<Traits, T>{});
+}
+
 template <typename Traits, typename T>
 UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_last_of(
-    T const* str, T const* current, T const* chars, size_t chars_count) noexcept {
+    T const* str, T const* current, T const* chars, size_t chars_count, false_type) noexcept {
     while (current >= str) {
         if (Traits::find(chars, chars_count, *current) != nullptr) {
             return current;
@@ -285,8 +333,21 @@ UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_last_of(
 }
 
 template <typename Traits, typename T>
-UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_last_not_of(
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_last_of(
+    T const* str, T const* current, T const* chars, size_t chars_count, true_type) noexcept {
+    return __UTL libc::runtime::vectorized::find_last_of(
+        str, libc::element_count_t(current + 1 - str), chars, libc::element_count_t(chars_count));
+}
+
+template <typename Traits, typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_last_of(
     T const* str, T const* current, T const* chars, size_t chars_count) noexcept {
+    return find_last_of<Traits>(str, current, chars, chars_count, is_default_traits<Traits, T>{});
+}
+
+template <typename Traits, typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_last_not_of(
+    T const* str, T const* current, T const* chars, size_t chars_count, false_type) noexcept {
     while (current >= str) {
         if (Traits::find(chars, chars_count, *current) == nullptr) {
             return current;
@@ -298,15 +359,30 @@ UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_last_not_of(
     return nullptr;
 }
 
+template <typename Traits, typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_last_not_of(
+    T const* str, T const* current, T const* chars, size_t chars_count, true_type) noexcept {
+    return __UTL libc::runtime::vectorized::find_last_not_of(
+        str, libc::element_count_t(current + 1 - str), chars, libc::element_count_t(chars_count));
+}
+
+template <typename Traits, typename T>
+UTL_ATTRIBUTE(INLINE_PURE_FUNCTION) inline T const* find_last_not_of(
+    T const* str, T const* current, T const* chars, size_t chars_count) noexcept {
+    return find_last_not_of<Traits>(
+        str, current, chars, chars_count, is_default_traits<Traits, T>{});
+}
+
 template <typename Traits, typename CharType>
-UTL_ATTRIBUTE(PURE_FUNCTION) inline CharType const* search_substring(
-    CharType const* l, size_t l_count, CharType const* r, size_t r_count) noexcept {
+UTL_ATTRIBUTE(PURE_FUNCTION) inline CharType const* search_substring(CharType const* l,
+    size_t l_count, CharType const* r, size_t r_count, false_type) noexcept {
     if (r_count == 0) {
         return l;
     }
+
     auto const r_first = *r;
-    while (true) {
-        auto l_front = Traits::find(l, __UTL sub_sat(l_count + 1, r_count), r_first);
+    while (l_count >= r_count) {
+        auto const l_front = Traits::find(l, l_count - r_count + 1, r_first);
         if (l_front == nullptr) {
             return nullptr;
         }
@@ -315,33 +391,65 @@ UTL_ATTRIBUTE(PURE_FUNCTION) inline CharType const* search_substring(
             return l_front;
         }
 
-        l_front += 1;
-        l = l_front;
-        l_count -= l_front - l;
+        l_count -= l_front + 1 - l;
+        l = l_front + 1;
     }
+
+    return nullptr;
 }
 
 template <typename Traits, typename CharType>
-UTL_ATTRIBUTE(PURE_FUNCTION) inline CharType const* rsearch_substring(
+UTL_ATTRIBUTE(PURE_FUNCTION) inline CharType const* search_substring(CharType const* l,
+    size_t l_count, CharType const* r, size_t r_count, true_type) noexcept {
+    return __UTL libc::runtime::vectorized::memmem(
+        l, libc::element_count_t(l_count), r, libc::element_count_t(r_count));
+}
+
+template <typename Traits, typename CharType>
+UTL_ATTRIBUTE(PURE_FUNCTION) inline CharType const* search_substring(
     CharType const* l, size_t l_count, CharType const* r, size_t r_count) noexcept {
+    return search_substring<Traits>(
+        l, l_count, r, r_count, is_default_traits<Traits, CharType>{});
+}
+
+template <typename Traits, typename CharType>
+UTL_ATTRIBUTE(PURE_FUNCTION) inline CharType const* rsearch_substring(CharType const* l,
+    size_t l_count, CharType const* r, size_t r_count, false_type) noexcept {
     if (r_count == 0) {
-        return l;
+        return l + l_count;
     }
+
     auto const r_last = r[r_count - 1];
-    while (true) {
-        auto min = __UTL numeric::min(r_count - 1, l_count);
-        auto const l_last = rfind_char(l + min, r_last, __UTL sub_sat(l_count, min));
+    while (l_count >= r_count) {
+        auto const l_last =
+            rfind_char(l + r_count - 1, r_last, l_count - r_count + 1, false_type{});
         if (l_last == nullptr) {
             return nullptr;
         }
 
-        auto const l_begin = l_last - min;
+        auto const l_begin = l_last - (r_count - 1);
         if (Traits::compare(l_begin, r, r_count) == 0) {
             return l_begin;
         }
 
         l_count = l_last - l;
     }
+
+    return nullptr;
+}
+
+template <typename Traits, typename CharType>
+UTL_ATTRIBUTE(PURE_FUNCTION) inline CharType const* rsearch_substring(CharType const* l,
+    size_t l_count, CharType const* r, size_t r_count, true_type) noexcept {
+    return __UTL libc::runtime::vectorized::memrmem(
+        l, libc::element_count_t(l_count), r, libc::element_count_t(r_count));
+}
+
+template <typename Traits, typename CharType>
+UTL_ATTRIBUTE(PURE_FUNCTION) inline CharType const* rsearch_substring(
+    CharType const* l, size_t l_count, CharType const* r, size_t r_count) noexcept {
+    return rsearch_substring<Traits>(
+        l, l_count, r, r_count, is_default_traits<Traits, CharType>{});
 }
 } // namespace runtime
 
@@ -364,8 +472,9 @@ UTL_ATTRIBUTE(PURE_FUNCTION) inline constexpr CharType const* rsearch_substring(
 template <typename Traits, typename CharType>
 UTL_ATTRIBUTE(PURE_FUNCTION) inline constexpr CharType const* rfind_char(
     CharType const* str, size_t length, CharType const ch) noexcept {
-    return UTL_CONSTANT_P(*str == ch) ? compile_time::rfind_char<Traits>(str, ch, length)
-                                      : runtime::rfind_char<Traits>(str, ch, length);
+    return length == 0 ? nullptr
+        : UTL_CONSTANT_P(*str == ch) ? compile_time::rfind_char(str, ch, length)
+                                     : runtime::rfind_char<Traits>(str, ch, length);
 }
 
 template <typename Traits, typename CharType>
@@ -394,24 +503,25 @@ UTL_ATTRIBUTE(PURE_FUNCTION) inline constexpr size_t find(
     return to_index(str, Traits::find(str, length, ch));
 }
 
-template <typename CharType>
+template <typename Traits, typename CharType>
 UTL_ATTRIBUTE(PURE_FUNCTION) inline constexpr size_t rfind(
     CharType const* str, size_t length, CharType const ch) noexcept {
-    return to_index(str, rfind_char(str, length, ch));
+    return to_index(str, rfind_char<Traits>(str, length, ch));
 }
 
 template <typename Traits, typename CharType>
 UTL_ATTRIBUTE(PURE_FUNCTION) inline constexpr size_t rfind(
     CharType const* str, size_t length, CharType const ch, size_t pos) noexcept {
-    return rfind(str, __UTL numeric::min(length, __UTL add_sat<size_t>(pos, 1)), ch);
+    return rfind<Traits>(str, __UTL numeric::min(length, __UTL add_sat<size_t>(pos, 1)), ch);
 }
 
 template <typename Traits, typename CharType>
 UTL_ATTRIBUTE(PURE_FUNCTION) inline constexpr size_t rfind(
     CharType const* l, size_t l_count, CharType const* r, size_t r_count, size_t l_pos) noexcept {
+    // A match may start at l_pos and extend past it
     return to_index(l,
         rsearch_substring<Traits>(
-            l, __UTL numeric::min(__UTL add_sat<size_t>(l_pos, 1), l_count), r, r_count));
+            l, __UTL numeric::min(__UTL add_sat<size_t>(l_pos, r_count), l_count), r, r_count));
 }
 
 template <typename Traits, typename T>
@@ -471,7 +581,8 @@ UTL_ATTRIBUTE(PURE_FUNCTION) inline constexpr size_t find_last_of(
 template <typename Traits, typename T>
 UTL_ATTRIBUTE(PURE_FUNCTION) inline constexpr size_t find_last_of(
     T const* str, size_t len, T const* chars, size_t chars_count, size_t pos) noexcept {
-    return find_last_of<Traits>(str, __UTL numeric::min(len, pos), chars, chars_count);
+    return find_last_of<Traits>(
+        str, __UTL numeric::min(len, __UTL add_sat<size_t>(pos, 1)), chars, chars_count);
 }
 
 template <typename Traits, typename T>
@@ -18,9 +18,26 @@ template <typename CharType, typename Traits = char_traits<CharType>>
 class __UTL_PUBLIC_TEMPLATE basic_string_view;
 template <typename CharType, typename Traits = char_traits<CharType>>
 class __UTL_PUBLIC_TEMPLATE basic_zstring_view;
+template <typename CharType, typename Traits = char_traits<CharType>>
+class __UTL_PUBLIC_TEMPLATE basic_string_searcher;
+template <typename CharType, typename Traits = char_traits<CharType>,
+    typename Alloc = allocator<CharType>>
+class __UTL_PUBLIC_TEMPLATE basic_string_builder;
+template <typename CharType, typename Traits = char_traits<CharType>,
+    typename Alloc = allocator<CharType>>
+class __UTL_PUBLIC_TEMPLATE basic_string_pool;
+template <typename CharType, typename Traits = char_traits<CharType>,
+    typename Alloc = allocator<CharType>>
+class __UTL_PUBLIC_TEMPLATE basic_concurrent_string_pool;
+
+namespace string_growth {
+template <size_t Numerator, size_t Denominator>
+struct __UTL_PUBLIC_TEMPLATE geometric;
+using doubling = geometric<2, 1>;
+} // namespace string_growth
 
 template <typename CharType, size_t ShortSize, typename Traits = char_traits<CharType>,
-    typename Alloc = allocator<CharType>>
+    typename Alloc = allocator<CharType>, typename Growth = string_growth::doubling>
 class __UTL_PUBLIC_TEMPLATE basic_short_string;
 
 namespace details {
@@ -122,6 +139,46 @@ using u8string_view = basic_string_view<char8_t>;
 using u8string_view = basic_string_view<char>;
 #endif
 
+using string_searcher = basic_string_searcher<char>;
+using wstring_searcher = basic_string_searcher<wchar_t>;
+using u16string_searcher = basic_string_searcher<char16_t>;
+using u32string_searcher = basic_string_searcher<char32_t>;
+#if UTL_SUPPORTS_CHAR8_T
+using u8string_searcher = basic_string_searcher<char8_t>;
+#else
+using u8string_searcher = basic_string_searcher<char>;
+#endif
+
+using string_builder = basic_string_builder<char>;
+using wstring_builder = basic_string_builder<wchar_t>;
+using u16string_builder = basic_string_builder<char16_t>;
+using u32string_builder = basic_string_builder<char32_t>;
+#if UTL_SUPPORTS_CHAR8_T
+using u8string_builder = basic_string_builder<char8_t>;
+#else
+using u8string_builder = basic_string_builder<char>;
+#endif
+
+using string_pool = basic_string_pool<char>;
+using wstring_pool = basic_string_pool<wchar_t>;
+using u16string_pool = basic_string_pool<char16_t>;
+using u32string_pool = basic_string_pool<char32_t>;
+#if UTL_SUPPORTS_CHAR8_T
+using u8string_pool = basic_string_pool<char8_t>;
+#else
+using u8string_pool = basic_string_pool<char>;
+#endif
+
+using concurrent_string_pool = basic_concurrent_string_pool<char>;
+using concurrent_wstring_pool = basic_concurrent_string_pool<wchar_t>;
+using concurrent_u16string_pool = basic_concurrent_string_pool<char16_t>;
+using concurrent_u32string_pool = basic_concurrent_string_pool<char32_t>;
+#if UTL_SUPPORTS_CHAR8_T
+using concurrent_u8string_pool = basic_concurrent_string_pool<char8_t>;
+#else
+using concurrent_u8string_pool = basic_concurrent_string_pool<char>;
+#endif
+
 using zstring_view = basic_zstring_view<char>;
 using zwstring_view = basic_zstring_view<wchar_t>;
 using zu16string_view = basic_zstring_view<char16_t>;
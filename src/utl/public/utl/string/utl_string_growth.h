@@ -0,0 +1,112 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/string/utl_string_fwd.h"
+
+#include "utl/bit/utl_bit_floor.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/numeric/utl_min.h"
+
+#define __UTL_ATTRIBUTE_GROWTH_CONST (CONST)(NODISCARD) __UTL_ATTRIBUTE__HIDE_FROM_ABI
+#define __UTL_ATTRIBUTE_TYPE_AGGREGATE_GROWTH_CONST
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Growth policies for `basic_short_string`
+ *
+ * A policy is consulted whenever an insertion outgrows the current buffer, explicit requests such
+ * as `reserve` are always honoured exactly. All quantities are buffer sizes in elements, including
+ * the null-terminator:
+ *
+ *     template <typename T>
+ *     static size_t next_capacity(size_t current, size_t required, size_t limit) noexcept;
+ *
+ * The result must be at least `required` and, unless `required` exceeds it, at most `limit`. The
+ * container always records the size actually returned by `allocate_at_least`, which may be larger.
+ */
+namespace string_growth {
+
+/**
+ * Requests exactly the required capacity, every insertion past the end of the buffer reallocates
+ */
+struct __UTL_ABI_PUBLIC exact {
+    template <typename T>
+    UTL_ATTRIBUTE(GROWTH_CONST) static inline constexpr size_t next_capacity(
+        size_t, size_t required, size_t) noexcept {
+        return required;
+    }
+};
+
+/**
+ * Scales the current capacity by `Numerator / Denominator`
+ */
+template <size_t Numerator, size_t Denominator>
+struct __UTL_PUBLIC_TEMPLATE geometric {
+    static_assert(Denominator > 0 && Numerator > Denominator, "Growth factor must exceed 1");
+
+    template <typename T>
+    UTL_ATTRIBUTE(GROWTH_CONST) static inline constexpr size_t next_capacity(
+        size_t current, size_t required, size_t limit) noexcept {
+        return __UTL numeric::max(required, __UTL numeric::min(scale(current, limit), limit));
+    }
+
+private:
+    UTL_ATTRIBUTE(GROWTH_CONST) static inline constexpr size_t scale(
+        size_t current, size_t limit) noexcept {
+        // Split the product to avoid overflowing before the limit is applied
+        return current > limit / Numerator * Denominator
+            ? limit
+            : current / Denominator * Numerator + current % Denominator * Numerator / Denominator;
+    }
+};
+
+/**
+ * Rounds the capacity chosen by `Base` up to the next allocator size class
+ *
+ * The classes follow the spacing used by jemalloc and other size-class allocators: multiples of 16
+ * bytes up to 128 bytes and four evenly spaced classes per doubling beyond that. Memory the
+ * allocator would have reserved regardless becomes usable capacity, even when the allocator does
+ * not report it through `allocate_at_least`.
+ */
+template <typename Base = geometric<3, 2>>
+struct __UTL_PUBLIC_TEMPLATE size_class {
+    template <typename T>
+    UTL_ATTRIBUTE(GROWTH_CONST) static inline UTL_CONSTEXPR_CXX14 size_t next_capacity(
+        size_t current, size_t required, size_t limit) noexcept {
+        size_t const target = Base::template next_capacity<T>(current, required, limit);
+        if (target > (size_t(-1) >> 1) / sizeof(T)) {
+            return target;
+        }
+
+        size_t const rounded = round(target * sizeof(T)) / sizeof(T);
+        return rounded > limit ? __UTL numeric::max(target, limit) : rounded;
+    }
+
+    UTL_ATTRIBUTE(GROWTH_CONST) static inline UTL_CONSTEXPR_CXX14 size_t round(
+        size_t bytes) noexcept {
+        if (bytes <= 8) {
+            return 8;
+        }
+
+        if (bytes <= 128) {
+            return (bytes + 15) & ~size_t(15);
+        }
+
+        size_t const spacing = __UTL bit_floor(bytes - 1) >> 2;
+        return (bytes + spacing - 1) & ~(spacing - 1);
+    }
+};
+
+// `doubling` is declared in utl_string_fwd.h as the default policy
+using one_and_a_half = geometric<3, 2>;
+
+} // namespace string_growth
+
+UTL_NAMESPACE_END
+
+#undef __UTL_ATTRIBUTE_GROWTH_CONST
+#undef __UTL_ATTRIBUTE_TYPE_AGGREGATE_GROWTH_CONST
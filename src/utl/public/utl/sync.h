@@ -0,0 +1,12 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/sync/utl_barrier.h"
+#include "utl/sync/utl_condition_variable.h"
+#include "utl/sync/utl_event_count.h"
+#include "utl/sync/utl_latch.h"
+#include "utl/sync/utl_mpmc_ring.h"
+#include "utl/sync/utl_mutex.h"
+#include "utl/sync/utl_shared_mutex.h"
+#include "utl/sync/utl_spsc_ring.h"
@@ -0,0 +1,43 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/hardware/utl_pause.h"
+
+UTL_NAMESPACE_BEGIN
+namespace sync {
+namespace details {
+
+/**
+ * Number of backoff rounds before a waiter blocks, round `n` issues `2^n` pause instructions so
+ * the spin phase lasts on the order of a microsecond, long enough for a short critical section or
+ * a hand-off between threads to complete without a system call
+ */
+UTL_INLINE_CXX17 constexpr int spin_rounds = 7;
+
+/**
+ * Polls `ready` with bounded exponential backoff, every primitive that spins before blocking goes
+ * through here so that they share a single spin budget
+ *
+ * @return true if `ready` was satisfied before the spin budget ran out
+ */
+template <typename F>
+__UTL_HIDE_FROM_ABI inline bool spin_until(F&& ready) noexcept(noexcept(ready())) {
+    for (int round = 0; round < spin_rounds; ++round) {
+        if (ready()) {
+            return true;
+        }
+
+        for (int i = 0; i < (1 << round); ++i) {
+            __UTL hardware::pause();
+        }
+    }
+
+    return ready();
+}
+
+} // namespace details
+} // namespace sync
+UTL_NAMESPACE_END
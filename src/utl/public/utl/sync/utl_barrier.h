@@ -0,0 +1,65 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Reusable thread barrier occupying a single 32-bit word
+ *
+ * The word packs the number of threads that arrived in the current phase, the number expected per
+ * phase and a phase counter. The last thread to arrive resets the arrival count, advances the
+ * phase and wakes the threads blocked on the previous phase.
+ *
+ * At most 2^15 - 1 threads may participate.
+ */
+class __UTL_ABI_PUBLIC barrier {
+public:
+    /**
+     * Phase in which a thread arrived, passed to `wait`
+     */
+    using arrival_token = uint32_t;
+
+    /**
+     * @param expected number of threads per phase, must not exceed `max()`
+     */
+    __UTL_HIDE_FROM_ABI explicit constexpr barrier(uint32_t expected) noexcept
+        : state_(expected << expected_shift) {}
+    barrier(barrier const&) = delete;
+    barrier& operator=(barrier const&) = delete;
+    __UTL_HIDE_FROM_ABI ~barrier() noexcept = default;
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) static inline constexpr uint32_t max() noexcept {
+        return count_mask;
+    }
+
+    /**
+     * Arrives at the barrier without blocking
+     */
+    UTL_ATTRIBUTES(NODISCARD) arrival_token arrive() noexcept;
+    /**
+     * Blocks until the phase identified by `token` has completed
+     */
+    void wait(arrival_token token) const noexcept;
+    void arrive_and_wait() noexcept;
+    /**
+     * Arrives and removes the calling thread from the threads expected in later phases
+     */
+    void arrive_and_drop() noexcept;
+
+private:
+    static constexpr uint32_t count_mask = (uint32_t(1) << 15) - 1;
+    static constexpr uint32_t expected_shift = 15;
+    static constexpr uint32_t phase_one = uint32_t(1) << 30;
+    static constexpr uint32_t phase_mask = ~(phase_one - 1);
+
+    arrival_token arrive(uint32_t dropped) noexcept;
+
+    uint32_t state_;
+};
+
+UTL_NAMESPACE_END
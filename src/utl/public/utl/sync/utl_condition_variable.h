@@ -0,0 +1,55 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/sync/utl_mutex.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Condition variable occupying a single 32-bit word, used together with `mutex`
+ *
+ * The word is a sequence number advanced by every notification; a waiter samples it while holding
+ * the mutex and blocks until it changes, so a notification between releasing the mutex and
+ * blocking is never lost. Waits may return spuriously.
+ *
+ * Waking every waiter at once makes them all contend for the mutex only for all but one to block
+ * on it again. `notify_all(mutex&)` instead wakes a single waiter and, where the platform supports
+ * it, moves the others onto the mutex so that each is woken in turn as the mutex is released.
+ */
+class __UTL_ABI_PUBLIC condition_variable {
+public:
+    __UTL_HIDE_FROM_ABI constexpr condition_variable() noexcept : sequence_(0) {}
+    condition_variable(condition_variable const&) = delete;
+    condition_variable& operator=(condition_variable const&) = delete;
+    __UTL_HIDE_FROM_ABI ~condition_variable() noexcept = default;
+
+    /**
+     * Atomically releases `m` and blocks until notified, `m` is reacquired before returning
+     */
+    void wait(mutex& m) noexcept;
+
+    template <typename Predicate>
+    __UTL_HIDE_FROM_ABI inline void wait(mutex& m, Predicate pred) {
+        while (!pred()) {
+            wait(m);
+        }
+    }
+
+    void notify_one() noexcept;
+    void notify_all() noexcept;
+    /**
+     * Wakes every waiter, which must all be waiting with `m`, while avoiding a thundering herd on
+     * the mutex
+     */
+    void notify_all(mutex& m) noexcept;
+
+private:
+    uint32_t sequence_;
+};
+
+UTL_NAMESPACE_END
@@ -0,0 +1,73 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/atomic/utl_atomic.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Event count occupying two 32-bit words, lets threads block until a condition that is checked
+ * without a lock may have changed
+ *
+ * A waiter registers with `prepare_wait`, checks its condition again and then either blocks in
+ * `wait` with the returned key or calls `cancel_wait`. A notifier publishes its change before
+ * calling `notify_one` or `notify_all`, so a change made between the check and blocking is never
+ * missed. Notifying costs a fence and a load while nobody is registered.
+ */
+class __UTL_ABI_PUBLIC event_count {
+public:
+    __UTL_HIDE_FROM_ABI constexpr event_count() noexcept : epoch_(0), waiters_(0) {}
+    event_count(event_count const&) = delete;
+    event_count& operator=(event_count const&) = delete;
+    __UTL_HIDE_FROM_ABI ~event_count() noexcept = default;
+
+    /**
+     * @return the key to pass to `wait`, the caller must check its condition after this call
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline uint32_t
+    prepare_wait() noexcept {
+        atomic_relaxed::fetch_add(&waiters_, uint32_t(1));
+        atomic_seq_cst::thread_fence();
+        return atomic_acquire::load(&epoch_);
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void cancel_wait() noexcept {
+        atomic_relaxed::fetch_sub(&waiters_, uint32_t(1));
+    }
+
+    /**
+     * Blocks until a notification after `prepare_wait` returned `key`, may return spuriously
+     */
+    void wait(uint32_t key) noexcept;
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void notify_one() noexcept {
+        if (has_waiters()) {
+            wake_one();
+        }
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void notify_all() noexcept {
+        if (has_waiters()) {
+            wake_all();
+        }
+    }
+
+private:
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool has_waiters() noexcept {
+        atomic_seq_cst::thread_fence();
+        return atomic_relaxed::load(&waiters_) != 0;
+    }
+
+    void wake_one() noexcept;
+    void wake_all() noexcept;
+
+    uint32_t epoch_;
+    uint32_t waiters_;
+};
+
+UTL_NAMESPACE_END
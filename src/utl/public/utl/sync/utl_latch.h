@@ -0,0 +1,62 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/assert/utl_assert.h"
+#include "utl/atomic/utl_atomic.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Single-use countdown occupying a single 32-bit word
+ *
+ * Threads block in `wait` until the counter reaches zero; the thread that brings it to zero wakes
+ * them all. The counter cannot be reset.
+ */
+class __UTL_ABI_PUBLIC latch {
+public:
+    __UTL_HIDE_FROM_ABI explicit constexpr latch(uint32_t expected) noexcept : count_(expected) {}
+    latch(latch const&) = delete;
+    latch& operator=(latch const&) = delete;
+    __UTL_HIDE_FROM_ABI ~latch() noexcept = default;
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) static inline constexpr uint32_t max() noexcept {
+        return UINT32_MAX;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void count_down(uint32_t n = 1) noexcept {
+        uint32_t const previous = atomic_acq_rel::fetch_sub(&count_, n);
+        UTL_ASSERT(previous >= n);
+        if (previous == n) {
+            wake();
+        }
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool try_wait() const noexcept {
+        return atomic_acquire::load(&count_) == 0;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void wait() const noexcept {
+        if (!try_wait()) {
+            wait_contended();
+        }
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void arrive_and_wait(
+        uint32_t n = 1) noexcept {
+        count_down(n);
+        wait();
+    }
+
+private:
+    void wait_contended() const noexcept;
+    void wake() noexcept;
+
+    uint32_t count_;
+};
+
+UTL_NAMESPACE_END
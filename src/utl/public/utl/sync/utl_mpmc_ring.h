@@ -0,0 +1,299 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/bit/utl_bit_ceil.h"
+#include "utl/memory/utl_allocator.h"
+#include "utl/memory/utl_allocator_traits.h"
+#include "utl/memory/utl_destroy_at.h"
+#include "utl/memory/utl_to_address.h"
+#include "utl/numeric/utl_max.h"
+#include "utl/sync/utl_ring_details.h"
+#include "utl/type_traits/utl_is_nothrow_constructible.h"
+#include "utl/type_traits/utl_is_nothrow_move_assignable.h"
+#include "utl/type_traits/utl_is_nothrow_move_constructible.h"
+#include "utl/utility/utl_compressed_pair.h"
+#include "utl/utility/utl_forward.h"
+#include "utl/utility/utl_move.h"
+
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace details {
+namespace ring {
+
+/**
+ * Element slot of an MPMC ring
+ *
+ * The sequence of the cell at index `i` equals `pos` when the cell is free for the producer that
+ * claimed position `pos`, and `pos + 1` once that producer has filled it. The consumer that claims
+ * `pos` then empties the cell and sets the sequence to `pos + capacity` for the next lap.
+ */
+template <typename T>
+struct cell {
+    size_t sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline T* element() noexcept {
+        return reinterpret_cast<T*>(storage);
+    }
+};
+
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE, CONST) inline constexpr intptr_t lag(
+    size_t sequence, size_t position) noexcept {
+    return static_cast<intptr_t>(sequence - position);
+}
+
+} // namespace ring
+} // namespace details
+
+/**
+ * Bounded lock-free queue for any number of producer and consumer threads
+ *
+ * Producers and consumers claim positions by advancing a shared counter, each on its own cache
+ * line, and hand cells over through a per-cell sequence number, so a producer and a consumer only
+ * touch the same line when they work on the same cell. The batch operations claim a run of
+ * consecutive cells with a single update of the counter.
+ *
+ * A claimed cell cannot be abandoned, so constructing and move assigning elements must not throw.
+ *
+ * If `Blocking` is set, `push` and `pop` block on an event count while the ring is full or empty;
+ * every successful operation then also checks for blocked threads on the other side.
+ */
+template <typename T, bool Blocking = false, typename Alloc = allocator<T>>
+class __UTL_PUBLIC_TEMPLATE mpmc_ring {
+    static_assert(
+        UTL_TRAIT_is_nothrow_move_constructible(T), "T must be nothrow move constructible");
+    static_assert(UTL_TRAIT_is_nothrow_move_assignable(T), "T must be nothrow move assignable");
+    using cell = details::ring::cell<T>;
+    using cell_traits = typename allocator_traits<Alloc>::template rebind_traits<cell>;
+    using cell_allocator = typename cell_traits::allocator_type;
+    using cell_pointer = typename cell_traits::pointer;
+    static constexpr size_t cache_line = details::ring::cache_line;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = size_t;
+
+    /**
+     * @param capacity rounded up to a power of two, at least 2
+     */
+    __UTL_HIDE_FROM_ABI explicit inline mpmc_ring(
+        size_type capacity, Alloc const& alloc = Alloc()) UTL_THROWS
+        : enqueue_(0)
+        , dequeue_(0)
+        , storage_(cell_pointer(), cell_allocator(alloc))
+        , mask_(__UTL bit_ceil(__UTL numeric::max(capacity, size_type(2))) - 1) {
+        storage_.first() = cell_traits::allocate(storage_.second(), mask_ + 1);
+        cell* const cells = __UTL to_address(storage_.first());
+        for (size_t idx = 0; idx <= mask_; ++idx) {
+            ::new (static_cast<void*>(cells + idx)) cell;
+            cells[idx].sequence = idx;
+        }
+    }
+
+    mpmc_ring(mpmc_ring const&) = delete;
+    mpmc_ring& operator=(mpmc_ring const&) = delete;
+
+    __UTL_HIDE_FROM_ABI inline ~mpmc_ring() noexcept {
+        for (size_t pos = dequeue_; pos != enqueue_; ++pos) {
+            __UTL destroy_at(at(pos).element());
+        }
+
+        cell_traits::deallocate(storage_.second(), storage_.first(), mask_ + 1);
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline size_type
+    capacity() const noexcept {
+        return mask_ + 1;
+    }
+
+    /**
+     * @return an estimate of the number of elements, exact only while no operation is in progress
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline size_type size() const noexcept {
+        size_t const head = atomic_acquire::load(&dequeue_);
+        size_t const tail = atomic_acquire::load(&enqueue_);
+        return details::ring::lag(tail, head) > 0 ? tail - head : 0;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    template <typename... Args>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool try_emplace(Args&&... args) noexcept {
+        static_assert(UTL_TRAIT_is_nothrow_constructible(T, Args...),
+            "Elements must be constructed without throwing");
+        size_t pos;
+        if (claim(enqueue_, 0, 1, pos) == 0) {
+            return false;
+        }
+
+        cell& target = at(pos);
+        ::new (static_cast<void*>(target.storage)) T(__UTL forward<Args>(args)...);
+        atomic_release::store(&target.sequence, pos + 1);
+        events_.pushed(1);
+        return true;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool try_push(
+        T const& value) noexcept {
+        return try_emplace(value);
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool try_push(
+        T&& value) noexcept {
+        return try_emplace(__UTL move(value));
+    }
+
+    /**
+     * Claims up to `count` consecutive cells and constructs their elements from `first`
+     *
+     * @return the number of elements pushed
+     */
+    template <typename It>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline size_type try_push_n(
+        It first, size_type count) noexcept {
+        static_assert(UTL_TRAIT_is_nothrow_constructible(T, decltype(*first)),
+            "Elements must be constructed without throwing");
+        size_t pos;
+        size_t const n = claim(enqueue_, 0, count, pos);
+        for (size_t idx = 0; idx != n; ++idx, ++first) {
+            cell& target = at(pos + idx);
+            ::new (static_cast<void*>(target.storage)) T(*first);
+            atomic_release::store(&target.sequence, pos + idx + 1);
+        }
+
+        if (n != 0) {
+            events_.pushed(n);
+        }
+
+        return n;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool try_pop(T& out) noexcept {
+        size_t pos;
+        if (claim(dequeue_, 1, 1, pos) == 0) {
+            return false;
+        }
+
+        release(at(pos), pos, out);
+        events_.popped(1);
+        return true;
+    }
+
+    /**
+     * Claims up to `count` consecutive filled cells and move assigns their elements to `out`
+     *
+     * @return the number of elements popped
+     */
+    template <typename It>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline size_type try_pop_n(
+        It out, size_type count) noexcept {
+        size_t pos;
+        size_t const n = claim(dequeue_, 1, count, pos);
+        for (size_t idx = 0; idx != n; ++idx, ++out) {
+            release(at(pos + idx), pos + idx, *out);
+        }
+
+        if (n != 0) {
+            events_.popped(n);
+        }
+
+        return n;
+    }
+
+    /**
+     * Blocks while the ring is full
+     */
+    template <typename... Args>
+    __UTL_HIDE_FROM_ABI inline void emplace(Args&&... args) noexcept {
+        static_assert(Blocking, "Blocking operations require a blocking ring");
+        // Arguments are only consumed by the attempt that succeeds
+        details::ring::block_until(
+            events_.writable, [&]() { return try_emplace(__UTL forward<Args>(args)...); });
+    }
+
+    __UTL_HIDE_FROM_ABI inline void push(T const& value) noexcept { emplace(value); }
+    __UTL_HIDE_FROM_ABI inline void push(T&& value) noexcept { emplace(__UTL move(value)); }
+
+    /**
+     * Blocks while the ring is empty
+     */
+    __UTL_HIDE_FROM_ABI inline void pop(T& out) noexcept {
+        static_assert(Blocking, "Blocking operations require a blocking ring");
+        details::ring::block_until(events_.readable, [&]() { return try_pop(out); });
+    }
+
+private:
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline cell& at(
+        size_t pos) const noexcept {
+        return __UTL to_address(storage_.first())[pos & mask_];
+    }
+
+    /**
+     * Claims up to `count` consecutive positions from `counter` whose cells have sequence
+     * `position + offset`, i.e. are free for producers with an offset of 0 and filled for
+     * consumers with an offset of 1
+     *
+     * @return the number of positions claimed, starting at `first`
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline size_t claim(
+        size_t& counter, size_t offset, size_t count, size_t& first) noexcept {
+        size_t pos = atomic_relaxed::load(&counter);
+        while (count != 0) {
+            size_t n = 0;
+            intptr_t state = 0;
+            for (; n != count; ++n) {
+                size_t const sequence = atomic_acquire::load(&at(pos + n).sequence);
+                state = details::ring::lag(sequence, pos + n + offset);
+                if (state != 0) {
+                    break;
+                }
+            }
+
+            if (n == 0) {
+                if (state < 0) {
+                    // The cell still belongs to the previous lap, the ring is full or empty
+                    return 0;
+                }
+
+                // Another thread claimed the position since `counter` was read
+                pos = atomic_relaxed::load(&counter);
+                continue;
+            }
+
+            if (atomic_relaxed::compare_exchange_weak(
+                    &counter, &pos, pos + n, atomics::relaxed_failure)) {
+                first = pos;
+                return n;
+            }
+        }
+
+        return 0;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void release(
+        cell& source, size_t pos, T& out) noexcept {
+        T* const element = source.element();
+        out = __UTL move(*element);
+        __UTL destroy_at(element);
+        atomic_release::store(&source.sequence, pos + mask_ + 1);
+    }
+
+    alignas(cache_line) size_t enqueue_;
+    alignas(cache_line) size_t dequeue_;
+    alignas(cache_line) compressed_pair<cell_pointer, cell_allocator> storage_;
+    size_t mask_;
+    UTL_ATTRIBUTE(NO_UNIQUE_ADDRESS) details::ring::events<Blocking> events_;
+};
+
+UTL_NAMESPACE_END
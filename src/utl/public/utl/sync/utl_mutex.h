@@ -0,0 +1,70 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/atomic/utl_atomic.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+class condition_variable;
+
+/**
+ * Mutual exclusion lock occupying a single 32-bit word
+ *
+ * The word is unlocked, locked, or locked with possible waiters. Locking and unlocking an
+ * uncontended mutex is a single atomic operation. A contended `lock` spins with bounded backoff
+ * before it marks the word and blocks on it with `futex::wait`, and `unlock` only issues a system
+ * call when the word was marked.
+ *
+ * The mutex is not recursive and must be unlocked by the thread that locked it.
+ */
+class __UTL_ABI_PUBLIC mutex {
+public:
+    __UTL_HIDE_FROM_ABI constexpr mutex() noexcept : state_(unlocked) {}
+    mutex(mutex const&) = delete;
+    mutex& operator=(mutex const&) = delete;
+    __UTL_HIDE_FROM_ABI ~mutex() noexcept = default;
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void lock() noexcept {
+        uint32_t expected = unlocked;
+        if (!atomic_acquire::compare_exchange_weak(
+                &state_, &expected, locked, atomics::relaxed_failure)) {
+            lock_contended();
+        }
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool try_lock() noexcept {
+        uint32_t expected = unlocked;
+        return atomic_acquire::compare_exchange_strong(
+            &state_, &expected, locked, atomics::relaxed_failure);
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void unlock() noexcept {
+        if (atomic_release::exchange(&state_, unlocked) == contended) {
+            wake();
+        }
+    }
+
+private:
+    friend condition_variable;
+
+    static constexpr uint32_t unlocked = 0;
+    static constexpr uint32_t locked = 1;
+    static constexpr uint32_t contended = 2;
+
+    void lock_contended() noexcept;
+    /**
+     * Acquires the mutex leaving it marked as contended, used by threads that were woken from a
+     * queue that may still hold other waiters
+     */
+    void lock_marked() noexcept;
+    void wake() noexcept;
+
+    uint32_t state_;
+};
+
+UTL_NAMESPACE_END
@@ -0,0 +1,94 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/scope/utl_scope_exit.h"
+#include "utl/sync/utl_backoff.h"
+#include "utl/sync/utl_event_count.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+namespace details {
+namespace ring {
+
+/**
+ * Positions written by one side of a ring are kept on their own cache line so that the producers
+ * and the consumers do not invalidate each other's lines on every operation
+ */
+constexpr size_t cache_line = 64;
+
+/**
+ * Position owned by one side of an SPSC ring along with that side's last observation of the
+ * position owned by the other side
+ */
+struct alignas(cache_line) cursor {
+    size_t position;
+    size_t cached;
+};
+
+/**
+ * Notifications of a ring that only supports non-blocking operations, compiled out entirely
+ */
+template <bool Blocking>
+struct events {
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void pushed(size_t) noexcept {}
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void popped(size_t) noexcept {}
+};
+
+template <>
+struct events<true> {
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void pushed(size_t count) noexcept {
+        count == 1 ? readable.notify_one() : readable.notify_all();
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void popped(size_t count) noexcept {
+        count == 1 ? writable.notify_one() : writable.notify_all();
+    }
+
+    /**
+     * Consumers wait here while the ring is empty
+     */
+    event_count readable;
+    /**
+     * Producers wait here while the ring is full
+     */
+    event_count writable;
+};
+
+/**
+ * Retries `attempt` until it succeeds, spinning briefly before blocking on `event`
+ */
+template <typename F>
+__UTL_HIDE_FROM_ABI void block_until(event_count& event, F attempt) {
+    if (__UTL sync::details::spin_until(attempt)) {
+        return;
+    }
+
+    while (true) {
+        uint32_t const key = event.prepare_wait();
+        // Stays set if `attempt` throws so that the registration is withdrawn
+        bool done = true;
+        {
+            UTL_ON_SCOPE_EXIT {
+                if (done) {
+                    event.cancel_wait();
+                }
+            };
+            done = attempt();
+        }
+
+        if (done) {
+            return;
+        }
+
+        event.wait(key);
+    }
+}
+
+} // namespace ring
+} // namespace details
+UTL_NAMESPACE_END
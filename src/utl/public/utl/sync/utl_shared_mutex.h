@@ -0,0 +1,95 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/atomic/utl_atomic.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Reader-writer lock occupying a single 32-bit word
+ *
+ * The word holds the number of readers, the number of writers waiting for the lock, a flag for
+ * readers waiting and the write lock flag. Readers do not enter while a writer is waiting, so a
+ * steady stream of readers cannot starve writers. Readers and writers block on the same word, a
+ * release that may unblock both wakes every waiter.
+ *
+ * At most 2^18 - 1 readers may hold the lock and 2^12 - 1 writers may wait at the same time.
+ */
+class __UTL_ABI_PUBLIC shared_mutex {
+public:
+    __UTL_HIDE_FROM_ABI constexpr shared_mutex() noexcept : state_(0) {}
+    shared_mutex(shared_mutex const&) = delete;
+    shared_mutex& operator=(shared_mutex const&) = delete;
+    __UTL_HIDE_FROM_ABI ~shared_mutex() noexcept = default;
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void lock() noexcept {
+        uint32_t expected = 0;
+        if (!atomic_acquire::compare_exchange_weak(
+                &state_, &expected, write_locked, atomics::relaxed_failure)) {
+            lock_contended();
+        }
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool try_lock() noexcept {
+        uint32_t expected = atomic_relaxed::load(&state_);
+        return (expected & (write_locked | reader_mask)) == 0 &&
+            atomic_acquire::compare_exchange_strong(
+                &state_, &expected, expected | write_locked, atomics::relaxed_failure);
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void unlock() noexcept {
+        uint32_t const previous =
+            atomic_release::fetch_and(&state_, ~(write_locked | readers_waiting));
+        if ((previous & (writer_mask | readers_waiting)) != 0) {
+            wake();
+        }
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void lock_shared() noexcept {
+        if (!try_lock_shared()) {
+            lock_shared_contended();
+        }
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool
+    try_lock_shared() noexcept {
+        uint32_t expected = atomic_relaxed::load(&state_);
+        return readable(expected) &&
+            atomic_acquire::compare_exchange_weak(
+                &state_, &expected, expected + 1, atomics::relaxed_failure);
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void unlock_shared() noexcept {
+        uint32_t const previous = atomic_release::fetch_sub(&state_, uint32_t(1));
+        uint32_t const readers = previous & reader_mask;
+        if ((readers == 1 && (previous & writer_mask) != 0) ||
+            (readers == reader_mask && (previous & readers_waiting) != 0)) {
+            wake();
+        }
+    }
+
+private:
+    static constexpr uint32_t reader_mask = (uint32_t(1) << 18) - 1;
+    static constexpr uint32_t writer_one = uint32_t(1) << 18;
+    static constexpr uint32_t writer_mask = ((uint32_t(1) << 12) - 1) << 18;
+    static constexpr uint32_t readers_waiting = uint32_t(1) << 30;
+    static constexpr uint32_t write_locked = uint32_t(1) << 31;
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) static inline constexpr bool readable(
+        uint32_t state) noexcept {
+        return (state & (write_locked | writer_mask)) == 0 && (state & reader_mask) != reader_mask;
+    }
+
+    void lock_contended() noexcept;
+    void lock_shared_contended() noexcept;
+    void wake() noexcept;
+
+    uint32_t state_;
+};
+
+UTL_NAMESPACE_END
@@ -0,0 +1,257 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/memory/utl_allocator.h"
+#include "utl/memory/utl_allocator_traits.h"
+#include "utl/memory/utl_destroy_at.h"
+#include "utl/memory/utl_to_address.h"
+#include "utl/numeric/utl_min.h"
+#include "utl/scope/utl_scope_exit.h"
+#include "utl/sync/utl_ring_details.h"
+#include "utl/type_traits/utl_is_nothrow_constructible.h"
+#include "utl/type_traits/utl_is_nothrow_move_assignable.h"
+#include "utl/utility/utl_compressed_pair.h"
+#include "utl/utility/utl_forward.h"
+#include "utl/utility/utl_move.h"
+
+#include <new>
+#include <stddef.h>
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread
+ *
+ * The producer and the consumer each own a position on a separate cache line and cache the last
+ * position they read from the other side, so the other side's line is only fetched when the ring
+ * looks full or empty. The batch operations publish all of their elements with a single store.
+ *
+ * If `Blocking` is set, `push` and `pop` block on an event count while the ring is full or empty;
+ * every successful operation then also checks for a blocked thread on the other side.
+ *
+ * @tparam N the capacity, a power of two
+ */
+template <typename T, size_t N, bool Blocking = false, typename Alloc = allocator<T>>
+class __UTL_PUBLIC_TEMPLATE spsc_ring {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "Capacity must be a power of two");
+    using slot_traits = typename allocator_traits<Alloc>::template rebind_traits<T>;
+    using slot_allocator = typename slot_traits::allocator_type;
+    using slot_pointer = typename slot_traits::pointer;
+    using cursor = details::ring::cursor;
+    static constexpr size_t mask = N - 1;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = size_t;
+
+    __UTL_HIDE_FROM_ABI explicit inline spsc_ring(Alloc const& alloc = Alloc()) UTL_THROWS
+        : producer_{0, 0}
+        , consumer_{0, 0}
+        , storage_(slot_pointer(), slot_allocator(alloc)) {
+        storage_.first() = slot_traits::allocate(storage_.second(), N);
+    }
+
+    spsc_ring(spsc_ring const&) = delete;
+    spsc_ring& operator=(spsc_ring const&) = delete;
+
+    __UTL_HIDE_FROM_ABI inline ~spsc_ring() noexcept {
+        for (size_t idx = consumer_.position; idx != producer_.position; ++idx) {
+            __UTL destroy_at(slot(idx));
+        }
+
+        slot_traits::deallocate(storage_.second(), storage_.first(), N);
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) static inline constexpr size_type
+    capacity() noexcept {
+        return N;
+    }
+
+    /**
+     * @return the number of elements, exact only when called by the producer or the consumer
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline size_type size() const noexcept {
+        size_t const head = atomic_acquire::load(&consumer_.position);
+        return atomic_acquire::load(&producer_.position) - head;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /**
+     * Producer only
+     */
+    template <typename... Args>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool try_emplace(Args&&... args) noexcept(
+        UTL_TRAIT_is_nothrow_constructible(T, Args...)) {
+        size_t const tail = atomic_relaxed::load(&producer_.position);
+        if (writable(tail) == 0) {
+            return false;
+        }
+
+        ::new (static_cast<void*>(slot(tail))) T(__UTL forward<Args>(args)...);
+        atomic_release::store(&producer_.position, tail + 1);
+        events_.pushed(1);
+        return true;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool try_push(
+        T const& value) noexcept(UTL_TRAIT_is_nothrow_constructible(T, T const&)) {
+        return try_emplace(value);
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool try_push(
+        T&& value) noexcept(UTL_TRAIT_is_nothrow_constructible(T, T&&)) {
+        return try_emplace(__UTL move(value));
+    }
+
+    /**
+     * Producer only, constructs up to `count` elements from `first` and publishes them at once
+     *
+     * @return the number of elements pushed, if a construction throws the elements constructed
+     * before it remain pushed
+     */
+    template <typename It>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline size_type try_push_n(
+        It first, size_type count) {
+        size_t const tail = atomic_relaxed::load(&producer_.position);
+        size_t const n = __UTL numeric::min(count, writable(tail, count));
+        size_t done = 0;
+        {
+            UTL_ON_SCOPE_EXIT {
+                if (done != 0) {
+                    atomic_release::store(&producer_.position, tail + done);
+                    events_.pushed(done);
+                }
+            };
+            for (; done != n; ++done, ++first) {
+                ::new (static_cast<void*>(slot(tail + done))) T(*first);
+            }
+        }
+
+        return n;
+    }
+
+    /**
+     * Consumer only
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline bool try_pop(T& out) noexcept(
+        UTL_TRAIT_is_nothrow_move_assignable(T)) {
+        size_t const head = atomic_relaxed::load(&consumer_.position);
+        if (readable(head) == 0) {
+            return false;
+        }
+
+        T* const element = slot(head);
+        out = __UTL move(*element);
+        __UTL destroy_at(element);
+        atomic_release::store(&consumer_.position, head + 1);
+        events_.popped(1);
+        return true;
+    }
+
+    /**
+     * Consumer only, move assigns up to `count` elements to `out` and releases their slots at once
+     *
+     * @return the number of elements popped, if an assignment throws the elements assigned before
+     * it remain popped
+     */
+    template <typename It>
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI) inline size_type try_pop_n(It out, size_type count) {
+        size_t const head = atomic_relaxed::load(&consumer_.position);
+        size_t const n = __UTL numeric::min(count, readable(head, count));
+        size_t done = 0;
+        {
+            UTL_ON_SCOPE_EXIT {
+                if (done != 0) {
+                    atomic_release::store(&consumer_.position, head + done);
+                    events_.popped(done);
+                }
+            };
+            for (; done != n; ++done, ++out) {
+                T* const element = slot(head + done);
+                *out = __UTL move(*element);
+                __UTL destroy_at(element);
+            }
+        }
+
+        return n;
+    }
+
+    /**
+     * Producer only, blocks while the ring is full
+     */
+    template <typename... Args>
+    __UTL_HIDE_FROM_ABI inline void emplace(Args&&... args) {
+        static_assert(Blocking, "Blocking operations require a blocking ring");
+        // Arguments are only consumed by the attempt that succeeds
+        details::ring::block_until(
+            events_.writable, [&]() { return try_emplace(__UTL forward<Args>(args)...); });
+    }
+
+    __UTL_HIDE_FROM_ABI inline void push(T const& value) { emplace(value); }
+    __UTL_HIDE_FROM_ABI inline void push(T&& value) { emplace(__UTL move(value)); }
+
+    /**
+     * Consumer only, blocks while the ring is empty
+     */
+    __UTL_HIDE_FROM_ABI inline void pop(T& out) {
+        static_assert(Blocking, "Blocking operations require a blocking ring");
+        details::ring::block_until(events_.readable, [&]() { return try_pop(out); });
+    }
+
+private:
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline T* slot(
+        size_t idx) const noexcept {
+        return __UTL to_address(storage_.first()) + (idx & mask);
+    }
+
+    /**
+     * @return the free slots at `tail`, the consumer position is only reloaded if fewer than
+     * `wanted` slots were free at the last observation
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline size_t writable(
+        size_t tail, size_t wanted = 1) noexcept {
+        size_t available = N - (tail - producer_.cached);
+        if (available < wanted) {
+            producer_.cached = atomic_acquire::load(&consumer_.position);
+            available = N - (tail - producer_.cached);
+        }
+
+        return available;
+    }
+
+    /**
+     * @return the filled slots at `head`, the producer position is only reloaded if fewer than
+     * `wanted` slots were filled at the last observation
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline size_t readable(
+        size_t head, size_t wanted = 1) noexcept {
+        size_t available = consumer_.cached - head;
+        if (available < wanted) {
+            consumer_.cached = atomic_acquire::load(&producer_.position);
+            available = consumer_.cached - head;
+        }
+
+        return available;
+    }
+
+    /**
+     * Written by the producer, `cached` holds the consumer position
+     */
+    cursor producer_;
+    /**
+     * Written by the consumer, `cached` holds the producer position
+     */
+    cursor consumer_;
+    alignas(details::ring::cache_line) compressed_pair<slot_pointer, slot_allocator> storage_;
+    UTL_ATTRIBUTE(NO_UNIQUE_ADDRESS) details::ring::events<Blocking> events_;
+};
+
+UTL_NAMESPACE_END
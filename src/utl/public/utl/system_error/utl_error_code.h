@@ -4,6 +4,7 @@
 
 #include "utl/utl_config.h"
 
+#include "utl/hash/utl_hash_fwd.h"
 #include "utl/span/utl_span_fwd.h"
 #include "utl/string/utl_string_fwd.h"
 
@@ -122,9 +123,6 @@ __UTL_HIDE_FROM_ABI inline error_code make_error_code(errc code) noexcept {
     return error_code(static_cast<int>(code), generic_category());
 }
 
-template <typename>
-struct hash;
-
 template <>
 struct __UTL_PUBLIC_TEMPLATE hash<error_code> {
     __UTL_HIDE_FROM_ABI inline constexpr size_t operator()(error_code const& code) const noexcept {
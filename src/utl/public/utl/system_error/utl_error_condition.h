@@ -4,6 +4,7 @@
 
 #include "utl/utl_config.h"
 
+#include "utl/hash/utl_hash_fwd.h"
 #include "utl/span/utl_span_fwd.h"
 #include "utl/string/utl_string_fwd.h"
 
@@ -123,9 +124,6 @@ __UTL_HIDE_FROM_ABI inline error_condition make_error_condition(errc code) noexc
     return error_condition(static_cast<int>(code), generic_category());
 }
 
-template <typename>
-struct hash;
-
 template <>
 struct __UTL_PUBLIC_TEMPLATE hash<error_condition> {
     __UTL_HIDE_FROM_ABI inline constexpr size_t operator()(
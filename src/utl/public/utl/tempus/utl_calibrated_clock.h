@@ -0,0 +1,139 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/hardware/utl_instruction_barrier.h"
+
+#if UTL_ARCH_x86_64
+#  include "utl/hardware/x86/utl_rdtsc.h"
+#elif UTL_ARCH_AARCH64
+#  include "utl/hardware/aarch64/utl_cntvct.h"
+#else
+#  include "utl/tempus/utl_clock.h"
+#endif
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace tempus {
+namespace details {
+namespace calibrated_clock {
+
+/**
+ * @return `(delta * mult) >> 32`, rounded towards negative infinity
+ */
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline constexpr int64_t multiply_shift(
+    int64_t delta, uint64_t mult) noexcept {
+#if UTL_SUPPORTS_INT128
+    return static_cast<int64_t>((__int128_t(delta) * __int128_t(mult)) >> 32);
+#else
+    // Only reached on targets without a 128-bit product, the sign costs a branch there
+    uint64_t const value = delta < 0 ? uint64_t(0) - uint64_t(delta) : uint64_t(delta);
+    uint64_t const low = (value & 0xffffffffu) * (mult & 0xffffffffu);
+    uint64_t const product = ((value >> 32) * (mult >> 32) << 32) +
+        (value >> 32) * (mult & 0xffffffffu) + (value & 0xffffffffu) * (mult >> 32) + (low >> 32);
+    return delta < 0 ? -static_cast<int64_t>(product + ((low & 0xffffffffu) != 0))
+                     : static_cast<int64_t>(product);
+#endif
+}
+
+} // namespace calibrated_clock
+} // namespace details
+
+/**
+ * Linear mapping from counter ticks to nanoseconds of the steady clock
+ */
+struct __UTL_ABI_PUBLIC calibration {
+    /**
+     * Fractional bits of `mult`
+     */
+    static constexpr int shift = 32;
+
+    int64_t base_ticks;
+    int64_t base_ns;
+    /**
+     * Nanoseconds per tick, scaled by `2^shift`
+     */
+    uint64_t mult;
+
+    /**
+     * @return `ticks` in nanoseconds of the steady clock, ticks before `base_ticks` are converted
+     * by extending the mapping backwards
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline constexpr int64_t
+    to_nanoseconds(int64_t ticks) const noexcept {
+        return base_ns + details::calibrated_clock::multiply_shift(ticks - base_ticks, mult);
+    }
+};
+
+/**
+ * Steady clock read from the hardware counter
+ *
+ * The counter is the unfenced time-stamp counter on x86-64 and the virtual counter on AArch64,
+ * the same counter as `trace` events; elsewhere the ticks are steady nanoseconds, and if the TSC
+ * is not invariant `now_ns` reads the steady clock. Ticks are converted to nanoseconds with a
+ * fixed-point multiply and shift, so reading the clock costs one counter read and a multiply
+ * instead of a call to the steady clock.
+ *
+ * The counter is calibrated against the steady clock on first use, with the frequency reported by
+ * the hardware if it is invariant and otherwise with a rate measured over 5ms. Afterwards, the
+ * first read past the resync point, every second once settled, remeasures the rate and corrects
+ * the drift by adjusting the rate until the next resync, so that the clock never steps backwards;
+ * it only steps forwards if it lags the steady clock by more than 1ms, e.g. after a suspend.
+ *
+ * Reads on one thread never decrease unless the thread resyncing is preempted in the middle of
+ * the resync; reads on different threads may disagree by a few nanoseconds around a resync.
+ *
+ *     utl::tempus::calibrated_clock::calibrate();  // optional, keeps the first read cheap
+ *     int64_t const stamp = utl::tempus::calibrated_clock::now_ns();
+ */
+class __UTL_ABI_PUBLIC calibrated_clock {
+public:
+    /**
+     * @return the unfenced hardware counter, or the steady clock in nanoseconds without one
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) static inline int64_t
+    ticks() noexcept {
+#if UTL_ARCH_x86_64
+        return static_cast<int64_t>(x86::rdtsc(instruction_barrier_none));
+#elif UTL_ARCH_AARCH64
+        return static_cast<int64_t>(aarch64::cntvct(instruction_barrier_none));
+#else
+        auto const now = get_time(tempus::steady_clock).time_since_epoch();
+        return static_cast<int64_t>(now.seconds()) * 1000000000 + now.nanoseconds();
+#endif
+    }
+
+    /**
+     * @return the current time in nanoseconds, on the epoch of the steady clock
+     */
+    UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) static int64_t now_ns() noexcept;
+
+    /**
+     * @return the current mapping, e.g. to convert a batch of `ticks` read earlier; the mapping
+     * drifts from the steady clock as its resync point passes
+     */
+    UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) static calibration current() noexcept;
+
+    /**
+     * @return the measured frequency of `ticks` in hertz
+     */
+    UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) static uint64_t frequency() noexcept;
+
+    /**
+     * Calibrates the counter if it is not yet calibrated, which takes up to 5ms
+     */
+    UTL_ATTRIBUTES(_ABI_PUBLIC) static void calibrate() noexcept;
+
+    /**
+     * Measures the rate and corrects the drift now instead of on the next resync point
+     */
+    UTL_ATTRIBUTES(_ABI_PUBLIC) static void resync() noexcept;
+};
+
+} // namespace tempus
+
+UTL_NAMESPACE_END
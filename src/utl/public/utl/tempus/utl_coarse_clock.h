@@ -0,0 +1,115 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/tempus/utl_clock_fwd.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/tempus/utl_clock.h"
+#include "utl/tempus/utl_duration.h"
+
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace tempus {
+
+/**
+ * Steady clock cached by a background ticker
+ *
+ * While the ticker runs, reading the clock is a single relaxed load of the time last published by
+ * the ticker thread, so reads lag the steady clock by up to the ticker interval. While it is
+ * stopped, reads fall back to the steady clock. Time points are nanoseconds on the epoch of the
+ * steady clock and never decrease while the ticker runs.
+ *
+ *     utl::tempus::coarse_clock_t::start(utl::tempus::duration(0, 1000000));
+ *     auto const received = get_time(utl::tempus::coarse_clock);
+ */
+struct __UTL_ABI_PUBLIC coarse_clock_t {
+    explicit constexpr coarse_clock_t() noexcept = default;
+    __UTL_HIDE_FROM_ABI friend time_point<coarse_clock_t> get_time(coarse_clock_t) noexcept;
+
+    /**
+     * Starts the ticker, which publishes the steady clock every `interval`
+     *
+     * @return false if the ticker is already running, `interval` is invalid or zero, or the thread
+     * could not be started
+     */
+    UTL_ATTRIBUTES(_ABI_PUBLIC) static bool start(
+        duration interval = duration(0, 1000000)) noexcept;
+
+    /**
+     * Stops the ticker, later reads fall back to the steady clock
+     */
+    UTL_ATTRIBUTES(_ABI_PUBLIC) static void stop() noexcept;
+
+private:
+    friend clock_traits<coarse_clock_t>;
+
+    /**
+     * @return the steady clock in nanoseconds
+     */
+    UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) static int64_t fallback() noexcept;
+
+    /**
+     * Entry of the ticker thread
+     */
+    static void run(void*) noexcept;
+
+    /**
+     * Last time published by the ticker, 0 while it is stopped
+     */
+    static int64_t published_;
+};
+
+template <>
+struct __UTL_PUBLIC_TEMPLATE clock_traits<coarse_clock_t> {
+public:
+    using clock = coarse_clock_t;
+    using value_type = int64_t;
+    using duration_type = duration;
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE, NODISCARD) static inline constexpr duration_type
+    time_since_epoch(value_type t) noexcept {
+        return duration_type{0, t};
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE, NODISCARD) static inline constexpr duration_type
+    difference(value_type l, value_type r) noexcept {
+        return duration_type{0, l - r};
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE, NODISCARD) static inline constexpr bool equal(
+        value_type l, value_type r) noexcept {
+        return l == r;
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE, NODISCARD) static inline constexpr clock_order
+    compare(value_type l, value_type r) noexcept {
+        return static_cast<clock_order>((l > r) - (l < r));
+    }
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE, NODISCARD) friend time_point<coarse_clock_t>
+    get_time(coarse_clock_t) noexcept {
+        value_type now = atomic_relaxed::load(&coarse_clock_t::published_);
+        if (now == 0) UTL_UNLIKELY {
+            now = coarse_clock_t::fallback();
+        }
+
+        return construct(now);
+    }
+
+private:
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE, NODISCARD) static inline
+    time_point<coarse_clock_t> construct(value_type value) noexcept {
+        return time_point<coarse_clock_t>{value};
+    }
+};
+
+UTL_INLINE_CXX17 constexpr coarse_clock_t coarse_clock{};
+
+} // namespace tempus
+
+UTL_NAMESPACE_END
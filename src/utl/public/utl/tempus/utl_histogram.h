@@ -0,0 +1,302 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/atomic/utl_atomic.h"
+#include "utl/bit/utl_bit_width.h"
+#include "utl/exception/utl_exception_base.h"
+#include "utl/tempus/utl_clock.h"
+#include "utl/tempus/utl_duration.h"
+#include "utl/tempus/utl_hardware_ticks.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+UTL_NAMESPACE_BEGIN
+
+namespace tempus {
+namespace details {
+namespace histogram {
+
+UTL_INLINE_CXX17 constexpr size_t cache_line = 64;
+
+/**
+ * Values below `sub_buckets` have a bucket each, every power of two above is split into
+ * `sub_buckets / 2` buckets, so a bucket spans at most 1/128 of its lowest value
+ */
+UTL_INLINE_CXX17 constexpr int precision_bits = 8;
+UTL_INLINE_CXX17 constexpr size_t sub_buckets = size_t(1) << precision_bits;
+UTL_INLINE_CXX17 constexpr size_t half_buckets = sub_buckets / 2;
+UTL_INLINE_CXX17 constexpr size_t bucket_count = (66 - precision_bits) * half_buckets;
+
+/**
+ * @return the number of low bits dropped from `value` by its bucket
+ */
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline constexpr int shift_of(
+    uint64_t value) noexcept {
+    return value < sub_buckets ? 0 : __UTL bit_width(value) - precision_bits;
+}
+
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline constexpr size_t index_of(
+    uint64_t value) noexcept {
+    return static_cast<size_t>(shift_of(value)) * half_buckets +
+        static_cast<size_t>(value >> shift_of(value));
+}
+
+/**
+ * @return the smallest value counted by the bucket `index`
+ */
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline constexpr uint64_t lowest_of(
+    size_t index) noexcept {
+    return index < sub_buckets
+        ? uint64_t(index)
+        : uint64_t(index % half_buckets + half_buckets) << (index / half_buckets - 1);
+}
+
+/**
+ * @return the largest value counted by the bucket `index`
+ */
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline constexpr uint64_t highest_of(
+    size_t index) noexcept {
+    return index < sub_buckets
+        ? uint64_t(index)
+        : lowest_of(index) + ((uint64_t(1) << (index / half_buckets - 1)) - 1);
+}
+
+/**
+ * Counts of one recorder, shards are reused by later recorders and only freed with their
+ * histogram so that a read never accesses freed memory
+ */
+struct alignas(cache_line) shard {
+    uint64_t counts[bucket_count];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    shard* next;
+    uint32_t in_use;
+};
+
+} // namespace histogram
+} // namespace details
+
+/**
+ * Log-linear latency histogram
+ *
+ * Values are counted in buckets whose width grows with the value, so the histogram has a fixed
+ * size, reports quantiles within 1% of the recorded values and never allocates while recording.
+ * Each thread records through its own `recorder`, which owns a shard of counts that only it
+ * writes; reading the histogram merges every shard into a `snapshot`.
+ *
+ * A histogram counts plain integers, its unit is the unit of the recorded values: nanoseconds for
+ * `duration`s and ticks for `hardware_ticks`. A histogram should only receive one of the two.
+ *
+ *     utl::tempus::histogram latencies;
+ *     utl::tempus::histogram::recorder recorder(latencies);
+ *     recorder.record(utl::tempus::measure(handle_request, utl::tempus::steady_clock));
+ *     {
+ *         utl::tempus::histogram::timer<utl::tempus::steady_clock_t> timer(recorder);
+ *         handle_request();
+ *     }
+ *     auto const summary = latencies.read();
+ *     summary.p99();
+ */
+class __UTL_ABI_PUBLIC histogram {
+    using shard = details::histogram::shard;
+
+public:
+    class recorder;
+    class snapshot;
+    template <typename Clock>
+    class timer;
+
+    histogram() noexcept;
+    histogram(histogram const&) = delete;
+    histogram& operator=(histogram const&) = delete;
+    /**
+     * All recorders must have been destroyed
+     */
+    ~histogram() noexcept;
+
+    /**
+     * Merges the counts of every recorder, including destroyed ones
+     *
+     * Values recorded concurrently may or may not be included, a value is never half-counted in
+     * the quantiles but `count` and the bucket totals of the snapshot may briefly disagree.
+     */
+    UTL_ATTRIBUTES(NODISCARD) snapshot read() const UTL_THROWS;
+
+private:
+    shard* acquire() UTL_THROWS;
+
+    shard* shards_;
+};
+
+/**
+ * Merged counts of a histogram
+ */
+class __UTL_ABI_PUBLIC histogram::snapshot {
+public:
+    /**
+     * Constructs an empty snapshot without allocating
+     */
+    __UTL_HIDE_FROM_ABI inline constexpr snapshot() noexcept
+        : counts_(nullptr)
+        , total_(0)
+        , min_(0)
+        , max_(0) {}
+
+    snapshot(snapshot const& other) UTL_THROWS;
+    snapshot& operator=(snapshot const& other) UTL_THROWS;
+
+    __UTL_HIDE_FROM_ABI inline snapshot(snapshot&& other) noexcept
+        : counts_(other.counts_)
+        , total_(other.total_)
+        , min_(other.min_)
+        , max_(other.max_) {
+        other.counts_ = nullptr;
+        other.total_ = 0;
+    }
+
+    snapshot& operator=(snapshot&& other) noexcept;
+    ~snapshot() noexcept;
+
+    /**
+     * Adds the counts of `other`, e.g. to combine the histograms of several processes
+     */
+    void merge(snapshot const& other) UTL_THROWS;
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline uint64_t
+    count() const noexcept {
+        return total_;
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline bool empty() const noexcept {
+        return total_ == 0;
+    }
+
+    /**
+     * @return the smallest recorded value, 0 if empty
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline uint64_t min() const noexcept {
+        return min_;
+    }
+
+    /**
+     * @return the largest recorded value, 0 if empty
+     */
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline uint64_t max() const noexcept {
+        return max_;
+    }
+
+    /**
+     * @return the mean of the recorded values, each value taken at the middle of its bucket
+     */
+    UTL_ATTRIBUTES(NODISCARD) double mean() const noexcept;
+
+    /**
+     * @return the largest value of the bucket holding the `quantile` rank, within 1% above the
+     * exact value and never above `max()`, 0 if empty
+     */
+    UTL_ATTRIBUTES(NODISCARD) uint64_t value_at(double quantile) const noexcept;
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline uint64_t p50() const noexcept {
+        return value_at(0.5);
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline uint64_t p99() const noexcept {
+        return value_at(0.99);
+    }
+
+    UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline uint64_t p999() const noexcept {
+        return value_at(0.999);
+    }
+
+private:
+    friend class histogram;
+
+    void add(uint64_t const* counts, uint64_t total, uint64_t min, uint64_t max) UTL_THROWS;
+
+    uint64_t* counts_;
+    uint64_t total_;
+    uint64_t min_;
+    uint64_t max_;
+};
+
+/**
+ * Registration of one thread with a histogram
+ *
+ * A recorder must only be used by one thread at a time. Recording only writes to the shard owned
+ * by the recorder, with plain loads and stores and without allocating; the counts remain in the
+ * histogram after the recorder is destroyed.
+ */
+class __UTL_ABI_PUBLIC histogram::recorder {
+public:
+    explicit recorder(histogram& owner) UTL_THROWS;
+    recorder(recorder const&) = delete;
+    recorder& operator=(recorder const&) = delete;
+    ~recorder() noexcept;
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI) inline void record(uint64_t value) noexcept {
+        size_t const index = details::histogram::index_of(value);
+        uint64_t* const bucket = &shard_->counts[index];
+        atomic_relaxed::store(bucket, atomic_relaxed::load(bucket) + 1);
+        if (value > atomic_relaxed::load(&shard_->max)) {
+            atomic_relaxed::store(&shard_->max, value);
+        }
+        if (value < atomic_relaxed::load(&shard_->min)) {
+            atomic_relaxed::store(&shard_->min, value);
+        }
+        // Published last so that a read never counts more values than the buckets hold
+        atomic_release::store(&shard_->total, atomic_relaxed::load(&shard_->total) + 1);
+    }
+
+    /**
+     * Records `value` in nanoseconds, an invalid duration is ignored
+     */
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void record(duration value) noexcept {
+        if (value) {
+            record(value.seconds() * 1000000000 + value.nanoseconds());
+        }
+    }
+
+    /**
+     * Records `value` in ticks, an invalid value is ignored
+     */
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline void record(
+        hardware_ticks value) noexcept {
+        if (value) {
+            record(static_cast<uint64_t>(value.value()));
+        }
+    }
+
+private:
+    shard* shard_;
+};
+
+/**
+ * Records the lifetime of the object, measured on `Clock`, when it is destroyed
+ */
+template <typename Clock>
+class __UTL_PUBLIC_TEMPLATE histogram::timer {
+public:
+    __UTL_HIDE_FROM_ABI explicit inline timer(recorder& target, Clock clock = Clock()) noexcept
+        : target_(target)
+        , clock_(clock)
+        , begin_(get_time(clock)) {}
+
+    timer(timer const&) = delete;
+    timer& operator=(timer const&) = delete;
+
+    __UTL_HIDE_FROM_ABI inline ~timer() noexcept { target_.record(get_time(clock_) - begin_); }
+
+private:
+    recorder& target_;
+    Clock clock_;
+    time_point<Clock> begin_;
+};
+
+} // namespace tempus
+
+UTL_NAMESPACE_END
@@ -0,0 +1,148 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/utl_config.h"
+
+#include "utl/preprocessor/utl_unique_var.h"
+#include "utl/tempus/utl_calibrated_clock.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#if !defined(UTL_TRACE_ENABLED)
+#  define UTL_TRACE_ENABLED 1
+#endif
+
+UTL_NAMESPACE_BEGIN
+
+namespace tempus {
+namespace trace {
+
+/**
+ * Interval recorded by a probe, timestamps are hardware ticks
+ */
+struct event {
+    char const* name;
+    int64_t begin;
+    int64_t end;
+    uint32_t thread;
+};
+
+namespace details {
+
+/**
+ * @return the unfenced hardware counter of `calibrated_clock`; without one, the steady clock in
+ * nanoseconds
+ */
+UTL_ATTRIBUTES(NODISCARD, _HIDE_FROM_ABI, ALWAYS_INLINE) inline int64_t now() noexcept {
+    return calibrated_clock::ticks();
+}
+
+UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) bool enabled() noexcept;
+
+/**
+ * Appends an event to the buffer of the calling thread, the event is dropped if the buffer is full
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) void record(char const* name, int64_t begin, int64_t end) noexcept;
+
+} // namespace details
+
+/**
+ * Probe recording the lifetime of the object, see `UTL_TRACE_SCOPE`
+ *
+ * While tracing is stopped a probe costs one call and a load. Otherwise it reads the hardware
+ * counter on construction and destruction and appends the event to a lock-free ring owned by the
+ * calling thread, the counter is read without fences so neighbouring instructions may overlap the
+ * interval by a few cycles.
+ */
+class __UTL_ABI_PUBLIC scope {
+public:
+    /**
+     * @param name a string that outlives the export of the trace, usually a literal
+     */
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) explicit inline scope(char const* name) noexcept
+        : name_(name)
+        , begin_(details::enabled() ? details::now() : -1) {}
+
+    scope(scope const&) = delete;
+    scope& operator=(scope const&) = delete;
+
+    UTL_ATTRIBUTES(_HIDE_FROM_ABI, ALWAYS_INLINE) inline ~scope() noexcept {
+        if (begin_ >= 0) {
+            details::record(name_, begin_, details::now());
+        }
+    }
+
+private:
+    char const* name_;
+    int64_t begin_;
+};
+
+struct __UTL_ABI_PUBLIC options {
+    /**
+     * Period of the background drain, 0 disables the background thread so that events are only
+     * collected by `drain`, `stop` and `write_chrome_trace`
+     */
+    uint64_t drain_interval_ns = 10000000;
+    /**
+     * Maximum number of collected events, once reached the oldest events are overwritten
+     */
+    size_t max_events = size_t(1) << 20;
+};
+
+/**
+ * Enables the probes and starts the background drain
+ *
+ * Each thread buffers up to 4096 events between drains, events recorded while its buffer is full
+ * are dropped and counted.
+ *
+ * @return false if tracing is already started or the drain thread could not be started
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) bool start(options const& config = options()) noexcept;
+
+/**
+ * Disables the probes, stops the background drain and collects the remaining events
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) void stop() noexcept;
+
+/**
+ * Moves the events buffered by every thread to the collected events
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) void drain() noexcept;
+
+/**
+ * Discards the collected events and resets the dropped count
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) void clear() noexcept;
+
+/**
+ * @return the number of events dropped on full thread buffers or overwritten in the collection
+ */
+UTL_ATTRIBUTES(NODISCARD, _ABI_PUBLIC) uint64_t dropped() noexcept;
+
+/**
+ * Drains, then writes the collected events as complete ("X") events in the Chrome trace event
+ * JSON format, which both chrome://tracing and the Perfetto UI open
+ *
+ * Ticks are converted with the current mapping of `calibrated_clock`.
+ *
+ * @return false on a write error
+ */
+UTL_ATTRIBUTES(_ABI_PUBLIC) bool write_chrome_trace(FILE* file) noexcept;
+
+} // namespace trace
+} // namespace tempus
+
+UTL_NAMESPACE_END
+
+#if UTL_TRACE_ENABLED
+/**
+ * Records the enclosing scope under `NAME` while tracing is started
+ */
+#  define UTL_TRACE_SCOPE(NAME) \
+      __UTL tempus::trace::scope const UTL_UNIQUE_VAR(TraceScope) { NAME }
+#else
+#  define UTL_TRACE_SCOPE(NAME) static_cast<void>(0)
+#endif
@@ -0,0 +1,90 @@
+// Copyright 2023-2024 Bryan Wong
+
+#pragma once
+
+#include "utl/type_traits/utl_common.h"
+
+#include "utl/tuple/utl_tuple_fwd.h"
+#include "utl/utility/utl_pair_fwd.h"
+
+#include "utl/type_traits/utl_constants.h"
+#include "utl/type_traits/utl_is_trivially_copyable.h"
+#include "utl/type_traits/utl_logical_traits.h"
+
+#if __UTL_SHOULD_USE_BUILTIN(is_trivially_relocatable)
+#  define UTL_BUILTIN_is_trivially_relocatable(...) __is_trivially_relocatable(__VA_ARGS__)
+#endif // __UTL_SHOULD_USE_BUILTIN(is_trivially_relocatable)
+
+UTL_NAMESPACE_BEGIN
+
+/**
+ * Type trait to determine if moving an object to new storage and destroying the source is
+ * equivalent to copying its bytes.
+ *
+ * Trivially copyable types are always trivially relocatable. Other types opt in by specializing
+ * this trait, which the library does for its own wrappers when all of their elements are
+ * trivially relocatable.
+ *
+ * @tparam T The type to be checked for trivial relocatability.
+ */
+template <typename T>
+struct __UTL_PUBLIC_TEMPLATE is_trivially_relocatable :
+#ifdef UTL_BUILTIN_is_trivially_relocatable
+    bool_constant<UTL_BUILTIN_is_trivially_relocatable(T)> {};
+#else
+    bool_constant<UTL_TRAIT_is_trivially_copyable(T)> {};
+#endif
+
+template <typename T>
+struct __UTL_PUBLIC_TEMPLATE is_trivially_relocatable<T const> : is_trivially_relocatable<T> {};
+
+template <typename T, size_t N>
+struct __UTL_PUBLIC_TEMPLATE is_trivially_relocatable<T[N]> : is_trivially_relocatable<T> {};
+
+/**
+ * An array of const elements matches both specializations above
+ */
+template <typename T, size_t N>
+struct __UTL_PUBLIC_TEMPLATE is_trivially_relocatable<T const[N]> : is_trivially_relocatable<T> {};
+
+namespace details {
+namespace relocation {
+/**
+ * Reference members are stored as pointers, so they never prevent relocation of the wrapper
+ */
+template <typename T>
+struct element : is_trivially_relocatable<T> {};
+template <typename T>
+struct element<T&> : true_type {};
+template <typename T>
+struct element<T&&> : true_type {};
+} // namespace relocation
+} // namespace details
+
+#if !UTL_USE_STDPAIR
+template <typename T0, typename T1>
+struct __UTL_PUBLIC_TEMPLATE is_trivially_relocatable<pair<T0, T1>> :
+    conjunction<details::relocation::element<T0>, details::relocation::element<T1>> {};
+#endif
+
+#if !UTL_USE_STD_tuple
+template <typename... Ts>
+struct __UTL_PUBLIC_TEMPLATE is_trivially_relocatable<tuple<Ts...>> :
+    conjunction<details::relocation::element<Ts>...> {};
+#endif
+
+#if UTL_CXX14
+template <typename T>
+UTL_INLINE_CXX17 constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+#endif // UTL_CXX14
+
+UTL_NAMESPACE_END
+
+#define UTL_TRAIT_SUPPORTED_is_trivially_relocatable 1
+
+#if UTL_CXX14
+#  define UTL_TRAIT_is_trivially_relocatable(...) __UTL is_trivially_relocatable_v<__VA_ARGS__>
+#else
+#  define UTL_TRAIT_is_trivially_relocatable(...) \
+      __UTL is_trivially_relocatable<__VA_ARGS__>::value
+#endif